@@ -0,0 +1,22 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_bench_build
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(bashTests "cmake" "-E" "env" "EXIV2_BINDIR=/root/repo/_bench_build/bin" "/root/.pyenv/shims/python3" "runner.py" "--verbose" "bash_tests")
+set_tests_properties(bashTests PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;110;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(bugfixTests "cmake" "-E" "env" "EXIV2_BINDIR=/root/repo/_bench_build/bin" "/root/.pyenv/shims/python3" "runner.py" "--verbose" "bugfixes")
+set_tests_properties(bugfixTests PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;117;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(lensTests "cmake" "-E" "env" "EXIV2_BINDIR=/root/repo/_bench_build/bin" "/root/.pyenv/shims/python3" "runner.py" "--verbose" "lens_tests")
+set_tests_properties(lensTests PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;120;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(tiffTests "cmake" "-E" "env" "EXIV2_BINDIR=/root/repo/_bench_build/bin" "/root/.pyenv/shims/python3" "runner.py" "--verbose" "tiff_test")
+set_tests_properties(tiffTests PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;123;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(versionTests "cmake" "-E" "env" "EXIV2_BINDIR=/root/repo/_bench_build/bin" "/root/.pyenv/shims/python3" "runner.py" "--verbose" "bash_tests/version_test.py")
+set_tests_properties(versionTests PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;126;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(regressionTests "cmake" "-E" "env" "EXIV2_BINDIR=/root/repo/_bench_build/bin" "/root/.pyenv/shims/python3" "runner.py" "--verbose" "regression_tests")
+set_tests_properties(regressionTests PROPERTIES  WORKING_DIRECTORY "/root/repo/tests" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;129;add_test;/root/repo/CMakeLists.txt;0;")
+subdirs("xmpsdk")
+subdirs("src")
+subdirs("app")
+subdirs("samples")
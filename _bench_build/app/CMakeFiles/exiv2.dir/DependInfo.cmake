@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/app/actions.cpp" "app/CMakeFiles/exiv2.dir/actions.cpp.o" "gcc" "app/CMakeFiles/exiv2.dir/actions.cpp.o.d"
+  "/root/repo/app/app_utils.cpp" "app/CMakeFiles/exiv2.dir/app_utils.cpp.o" "gcc" "app/CMakeFiles/exiv2.dir/app_utils.cpp.o.d"
+  "/root/repo/app/exiv2.cpp" "app/CMakeFiles/exiv2.dir/exiv2.cpp.o" "gcc" "app/CMakeFiles/exiv2.dir/exiv2.cpp.o.d"
+  "/root/repo/app/getopt.cpp" "app/CMakeFiles/exiv2.dir/getopt.cpp.o" "gcc" "app/CMakeFiles/exiv2.dir/getopt.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench_build/src/CMakeFiles/exiv2lib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "../bin/exiv2"
+  "../bin/exiv2.pdb"
+  "CMakeFiles/exiv2.dir/actions.cpp.o"
+  "CMakeFiles/exiv2.dir/actions.cpp.o.d"
+  "CMakeFiles/exiv2.dir/app_utils.cpp.o"
+  "CMakeFiles/exiv2.dir/app_utils.cpp.o.d"
+  "CMakeFiles/exiv2.dir/exiv2.cpp.o"
+  "CMakeFiles/exiv2.dir/exiv2.cpp.o.d"
+  "CMakeFiles/exiv2.dir/getopt.cpp.o"
+  "CMakeFiles/exiv2.dir/getopt.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/exiv2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
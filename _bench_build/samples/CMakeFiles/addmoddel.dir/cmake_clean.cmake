@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/addmoddel"
+  "../bin/addmoddel.pdb"
+  "CMakeFiles/addmoddel.dir/addmoddel.cpp.o"
+  "CMakeFiles/addmoddel.dir/addmoddel.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/addmoddel.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
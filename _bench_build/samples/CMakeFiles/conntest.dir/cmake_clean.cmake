@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/conntest"
+  "../bin/conntest.pdb"
+  "CMakeFiles/conntest.dir/conntest.cpp.o"
+  "CMakeFiles/conntest.dir/conntest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/conntest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/convert-test"
+  "../bin/convert-test.pdb"
+  "CMakeFiles/convert-test.dir/convert-test.cpp.o"
+  "CMakeFiles/convert-test.dir/convert-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/convert-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
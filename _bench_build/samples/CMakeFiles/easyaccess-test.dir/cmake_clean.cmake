@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/easyaccess-test"
+  "../bin/easyaccess-test.pdb"
+  "CMakeFiles/easyaccess-test.dir/easyaccess-test.cpp.o"
+  "CMakeFiles/easyaccess-test.dir/easyaccess-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/easyaccess-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
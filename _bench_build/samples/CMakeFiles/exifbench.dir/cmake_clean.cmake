@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/exifbench"
+  "../bin/exifbench.pdb"
+  "CMakeFiles/exifbench.dir/exifbench.cpp.o"
+  "CMakeFiles/exifbench.dir/exifbench.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/exifbench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
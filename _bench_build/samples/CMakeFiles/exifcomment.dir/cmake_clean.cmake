@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/exifcomment"
+  "../bin/exifcomment.pdb"
+  "CMakeFiles/exifcomment.dir/exifcomment.cpp.o"
+  "CMakeFiles/exifcomment.dir/exifcomment.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/exifcomment.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
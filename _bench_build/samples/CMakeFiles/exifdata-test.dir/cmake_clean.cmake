@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/exifdata-test"
+  "../bin/exifdata-test.pdb"
+  "CMakeFiles/exifdata-test.dir/exifdata-test.cpp.o"
+  "CMakeFiles/exifdata-test.dir/exifdata-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/exifdata-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
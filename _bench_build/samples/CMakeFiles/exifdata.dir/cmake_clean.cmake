@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/exifdata"
+  "../bin/exifdata.pdb"
+  "CMakeFiles/exifdata.dir/exifdata.cpp.o"
+  "CMakeFiles/exifdata.dir/exifdata.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/exifdata.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
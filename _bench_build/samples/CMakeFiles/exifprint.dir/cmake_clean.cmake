@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/exifprint"
+  "../bin/exifprint.pdb"
+  "CMakeFiles/exifprint.dir/exifprint.cpp.o"
+  "CMakeFiles/exifprint.dir/exifprint.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/exifprint.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
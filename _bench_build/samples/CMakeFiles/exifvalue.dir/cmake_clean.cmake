@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/exifvalue"
+  "../bin/exifvalue.pdb"
+  "CMakeFiles/exifvalue.dir/exifvalue.cpp.o"
+  "CMakeFiles/exifvalue.dir/exifvalue.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/exifvalue.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
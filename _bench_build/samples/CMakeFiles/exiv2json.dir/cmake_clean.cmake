@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../bin/exiv2json"
+  "../bin/exiv2json.pdb"
+  "CMakeFiles/exiv2json.dir/Jzon.cpp.o"
+  "CMakeFiles/exiv2json.dir/Jzon.cpp.o.d"
+  "CMakeFiles/exiv2json.dir/exiv2json.cpp.o"
+  "CMakeFiles/exiv2json.dir/exiv2json.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/exiv2json.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/geotag"
+  "../bin/geotag.pdb"
+  "CMakeFiles/geotag.dir/geotag.cpp.o"
+  "CMakeFiles/geotag.dir/geotag.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/geotag.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../bin/getopt-test"
+  "../bin/getopt-test.pdb"
+  "CMakeFiles/getopt-test.dir/__/app/getopt.cpp.o"
+  "CMakeFiles/getopt-test.dir/__/app/getopt.cpp.o.d"
+  "CMakeFiles/getopt-test.dir/getopt-test.cpp.o"
+  "CMakeFiles/getopt-test.dir/getopt-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/getopt-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/ini-test"
+  "../bin/ini-test.pdb"
+  "CMakeFiles/ini-test.dir/ini-test.cpp.o"
+  "CMakeFiles/ini-test.dir/ini-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ini-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
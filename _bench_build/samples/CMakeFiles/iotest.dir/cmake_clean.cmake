@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/iotest"
+  "../bin/iotest.pdb"
+  "CMakeFiles/iotest.dir/iotest.cpp.o"
+  "CMakeFiles/iotest.dir/iotest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/iotest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
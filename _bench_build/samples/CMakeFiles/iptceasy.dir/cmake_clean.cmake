@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/iptceasy"
+  "../bin/iptceasy.pdb"
+  "CMakeFiles/iptceasy.dir/iptceasy.cpp.o"
+  "CMakeFiles/iptceasy.dir/iptceasy.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/iptceasy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/iptcprint"
+  "../bin/iptcprint.pdb"
+  "CMakeFiles/iptcprint.dir/iptcprint.cpp.o"
+  "CMakeFiles/iptcprint.dir/iptcprint.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/iptcprint.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
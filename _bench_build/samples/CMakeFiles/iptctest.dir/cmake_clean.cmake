@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/iptctest"
+  "../bin/iptctest.pdb"
+  "CMakeFiles/iptctest.dir/iptctest.cpp.o"
+  "CMakeFiles/iptctest.dir/iptctest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/iptctest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/key-test"
+  "../bin/key-test.pdb"
+  "CMakeFiles/key-test.dir/key-test.cpp.o"
+  "CMakeFiles/key-test.dir/key-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/key-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/largeiptc-test"
+  "../bin/largeiptc-test.pdb"
+  "CMakeFiles/largeiptc-test.dir/largeiptc-test.cpp.o"
+  "CMakeFiles/largeiptc-test.dir/largeiptc-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/largeiptc-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../bin/metacopy"
+  "../bin/metacopy.pdb"
+  "CMakeFiles/metacopy.dir/__/app/getopt.cpp.o"
+  "CMakeFiles/metacopy.dir/__/app/getopt.cpp.o.d"
+  "CMakeFiles/metacopy.dir/metacopy.cpp.o"
+  "CMakeFiles/metacopy.dir/metacopy.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/metacopy.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/mmap-test"
+  "../bin/mmap-test.pdb"
+  "CMakeFiles/mmap-test.dir/mmap-test.cpp.o"
+  "CMakeFiles/mmap-test.dir/mmap-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mmap-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/mrwthumb"
+  "../bin/mrwthumb.pdb"
+  "CMakeFiles/mrwthumb.dir/mrwthumb.cpp.o"
+  "CMakeFiles/mrwthumb.dir/mrwthumb.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mrwthumb.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
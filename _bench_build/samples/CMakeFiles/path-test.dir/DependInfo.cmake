@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/app/getopt.cpp" "samples/CMakeFiles/path-test.dir/__/app/getopt.cpp.o" "gcc" "samples/CMakeFiles/path-test.dir/__/app/getopt.cpp.o.d"
+  "/root/repo/samples/path-test.cpp" "samples/CMakeFiles/path-test.dir/path-test.cpp.o" "gcc" "samples/CMakeFiles/path-test.dir/path-test.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench_build/src/CMakeFiles/exiv2lib.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../bin/path-test"
+  "../bin/path-test.pdb"
+  "CMakeFiles/path-test.dir/__/app/getopt.cpp.o"
+  "CMakeFiles/path-test.dir/__/app/getopt.cpp.o.d"
+  "CMakeFiles/path-test.dir/path-test.cpp.o"
+  "CMakeFiles/path-test.dir/path-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/path-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/prevtest"
+  "../bin/prevtest.pdb"
+  "CMakeFiles/prevtest.dir/prevtest.cpp.o"
+  "CMakeFiles/prevtest.dir/prevtest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/prevtest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/remotetest"
+  "../bin/remotetest.pdb"
+  "CMakeFiles/remotetest.dir/remotetest.cpp.o"
+  "CMakeFiles/remotetest.dir/remotetest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/remotetest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
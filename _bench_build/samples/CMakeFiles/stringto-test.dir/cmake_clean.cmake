@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/stringto-test"
+  "../bin/stringto-test.pdb"
+  "CMakeFiles/stringto-test.dir/stringto-test.cpp.o"
+  "CMakeFiles/stringto-test.dir/stringto-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/stringto-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
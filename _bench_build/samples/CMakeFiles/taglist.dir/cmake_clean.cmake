@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/taglist"
+  "../bin/taglist.pdb"
+  "CMakeFiles/taglist.dir/taglist.cpp.o"
+  "CMakeFiles/taglist.dir/taglist.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/taglist.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/tiff-test"
+  "../bin/tiff-test.pdb"
+  "CMakeFiles/tiff-test.dir/tiff-test.cpp.o"
+  "CMakeFiles/tiff-test.dir/tiff-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tiff-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
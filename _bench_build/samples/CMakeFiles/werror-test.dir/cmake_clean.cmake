@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/werror-test"
+  "../bin/werror-test.pdb"
+  "CMakeFiles/werror-test.dir/werror-test.cpp.o"
+  "CMakeFiles/werror-test.dir/werror-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/werror-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
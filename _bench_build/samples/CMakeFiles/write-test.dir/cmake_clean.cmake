@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/write-test"
+  "../bin/write-test.pdb"
+  "CMakeFiles/write-test.dir/write-test.cpp.o"
+  "CMakeFiles/write-test.dir/write-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/write-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
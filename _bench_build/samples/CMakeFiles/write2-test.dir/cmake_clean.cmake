@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/write2-test"
+  "../bin/write2-test.pdb"
+  "CMakeFiles/write2-test.dir/write2-test.cpp.o"
+  "CMakeFiles/write2-test.dir/write2-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/write2-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/xmpbench"
+  "../bin/xmpbench.pdb"
+  "CMakeFiles/xmpbench.dir/xmpbench.cpp.o"
+  "CMakeFiles/xmpbench.dir/xmpbench.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/xmpbench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/xmpdump"
+  "../bin/xmpdump.pdb"
+  "CMakeFiles/xmpdump.dir/xmpdump.cpp.o"
+  "CMakeFiles/xmpdump.dir/xmpdump.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/xmpdump.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
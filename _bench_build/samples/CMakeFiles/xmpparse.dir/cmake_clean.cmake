@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/xmpparse"
+  "../bin/xmpparse.pdb"
+  "CMakeFiles/xmpparse.dir/xmpparse.cpp.o"
+  "CMakeFiles/xmpparse.dir/xmpparse.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/xmpparse.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
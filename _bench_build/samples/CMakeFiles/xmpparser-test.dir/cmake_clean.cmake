@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/xmpparser-test"
+  "../bin/xmpparser-test.pdb"
+  "CMakeFiles/xmpparser-test.dir/xmpparser-test.cpp.o"
+  "CMakeFiles/xmpparser-test.dir/xmpparser-test.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/xmpparser-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/xmpprint"
+  "../bin/xmpprint.pdb"
+  "CMakeFiles/xmpprint.dir/xmpprint.cpp.o"
+  "CMakeFiles/xmpprint.dir/xmpprint.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/xmpprint.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../bin/xmpsample"
+  "../bin/xmpsample.pdb"
+  "CMakeFiles/xmpsample.dir/xmpsample.cpp.o"
+  "CMakeFiles/xmpsample.dir/xmpsample.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/xmpsample.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,64 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/basicio.cpp" "src/CMakeFiles/exiv2lib.dir/basicio.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/basicio.cpp.o.d"
+  "/root/repo/src/bmffimage.cpp" "src/CMakeFiles/exiv2lib.dir/bmffimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/bmffimage.cpp.o.d"
+  "/root/repo/src/bmpimage.cpp" "src/CMakeFiles/exiv2lib.dir/bmpimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/bmpimage.cpp.o.d"
+  "/root/repo/src/convert.cpp" "src/CMakeFiles/exiv2lib.dir/convert.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/convert.cpp.o.d"
+  "/root/repo/src/cr2image.cpp" "src/CMakeFiles/exiv2lib.dir/cr2image.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/cr2image.cpp.o.d"
+  "/root/repo/src/crwimage.cpp" "src/CMakeFiles/exiv2lib.dir/crwimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/crwimage.cpp.o.d"
+  "/root/repo/src/datasets.cpp" "src/CMakeFiles/exiv2lib.dir/datasets.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/datasets.cpp.o.d"
+  "/root/repo/src/easyaccess.cpp" "src/CMakeFiles/exiv2lib.dir/easyaccess.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/easyaccess.cpp.o.d"
+  "/root/repo/src/epsimage.cpp" "src/CMakeFiles/exiv2lib.dir/epsimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/epsimage.cpp.o.d"
+  "/root/repo/src/error.cpp" "src/CMakeFiles/exiv2lib.dir/error.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/error.cpp.o.d"
+  "/root/repo/src/exif.cpp" "src/CMakeFiles/exiv2lib.dir/exif.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/exif.cpp.o.d"
+  "/root/repo/src/futils.cpp" "src/CMakeFiles/exiv2lib.dir/futils.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/futils.cpp.o.d"
+  "/root/repo/src/gifimage.cpp" "src/CMakeFiles/exiv2lib.dir/gifimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/gifimage.cpp.o.d"
+  "/root/repo/src/http.cpp" "src/CMakeFiles/exiv2lib.dir/http.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/http.cpp.o.d"
+  "/root/repo/src/image.cpp" "src/CMakeFiles/exiv2lib.dir/image.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/image.cpp.o.d"
+  "/root/repo/src/ini.cpp" "src/CMakeFiles/exiv2lib.dir/ini.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/ini.cpp.o.d"
+  "/root/repo/src/iptc.cpp" "src/CMakeFiles/exiv2lib.dir/iptc.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/iptc.cpp.o.d"
+  "/root/repo/src/jp2image.cpp" "src/CMakeFiles/exiv2lib.dir/jp2image.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/jp2image.cpp.o.d"
+  "/root/repo/src/jpgimage.cpp" "src/CMakeFiles/exiv2lib.dir/jpgimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/jpgimage.cpp.o.d"
+  "/root/repo/src/metadatum.cpp" "src/CMakeFiles/exiv2lib.dir/metadatum.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/metadatum.cpp.o.d"
+  "/root/repo/src/mrwimage.cpp" "src/CMakeFiles/exiv2lib.dir/mrwimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/mrwimage.cpp.o.d"
+  "/root/repo/src/orfimage.cpp" "src/CMakeFiles/exiv2lib.dir/orfimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/orfimage.cpp.o.d"
+  "/root/repo/src/pgfimage.cpp" "src/CMakeFiles/exiv2lib.dir/pgfimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/pgfimage.cpp.o.d"
+  "/root/repo/src/pngimage.cpp" "src/CMakeFiles/exiv2lib.dir/pngimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/pngimage.cpp.o.d"
+  "/root/repo/src/preview.cpp" "src/CMakeFiles/exiv2lib.dir/preview.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/preview.cpp.o.d"
+  "/root/repo/src/properties.cpp" "src/CMakeFiles/exiv2lib.dir/properties.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/properties.cpp.o.d"
+  "/root/repo/src/psdimage.cpp" "src/CMakeFiles/exiv2lib.dir/psdimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/psdimage.cpp.o.d"
+  "/root/repo/src/rafimage.cpp" "src/CMakeFiles/exiv2lib.dir/rafimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/rafimage.cpp.o.d"
+  "/root/repo/src/rw2image.cpp" "src/CMakeFiles/exiv2lib.dir/rw2image.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/rw2image.cpp.o.d"
+  "/root/repo/src/tags.cpp" "src/CMakeFiles/exiv2lib.dir/tags.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/tags.cpp.o.d"
+  "/root/repo/src/tgaimage.cpp" "src/CMakeFiles/exiv2lib.dir/tgaimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/tgaimage.cpp.o.d"
+  "/root/repo/src/tiffimage.cpp" "src/CMakeFiles/exiv2lib.dir/tiffimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/tiffimage.cpp.o.d"
+  "/root/repo/src/types.cpp" "src/CMakeFiles/exiv2lib.dir/types.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/types.cpp.o.d"
+  "/root/repo/src/value.cpp" "src/CMakeFiles/exiv2lib.dir/value.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/value.cpp.o.d"
+  "/root/repo/src/version.cpp" "src/CMakeFiles/exiv2lib.dir/version.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/version.cpp.o.d"
+  "/root/repo/src/webpimage.cpp" "src/CMakeFiles/exiv2lib.dir/webpimage.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/webpimage.cpp.o.d"
+  "/root/repo/src/xmp.cpp" "src/CMakeFiles/exiv2lib.dir/xmp.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/xmp.cpp.o.d"
+  "/root/repo/src/xmpsidecar.cpp" "src/CMakeFiles/exiv2lib.dir/xmpsidecar.cpp.o" "gcc" "src/CMakeFiles/exiv2lib.dir/xmpsidecar.cpp.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_bench_build/lib/libexiv2.so" "/root/repo/_bench_build/lib/libexiv2.so.1.0.0.9"
+  "/root/repo/_bench_build/lib/libexiv2.so.0" "/root/repo/_bench_build/lib/libexiv2.so.1.0.0.9"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_bench_build/xmpsdk/CMakeFiles/exiv2-xmp.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
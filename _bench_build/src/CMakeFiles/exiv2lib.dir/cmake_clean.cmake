@@ -0,0 +1,87 @@
+file(REMOVE_RECURSE
+  "../lib/libexiv2.so"
+  "../lib/libexiv2.so.0"
+  "../lib/libexiv2.so.1.0.0.9"
+  "CMakeFiles/exiv2lib.dir/basicio.cpp.o"
+  "CMakeFiles/exiv2lib.dir/basicio.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/bmffimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/bmffimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/bmpimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/bmpimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/convert.cpp.o"
+  "CMakeFiles/exiv2lib.dir/convert.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/cr2image.cpp.o"
+  "CMakeFiles/exiv2lib.dir/cr2image.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/crwimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/crwimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/datasets.cpp.o"
+  "CMakeFiles/exiv2lib.dir/datasets.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/easyaccess.cpp.o"
+  "CMakeFiles/exiv2lib.dir/easyaccess.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/epsimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/epsimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/error.cpp.o"
+  "CMakeFiles/exiv2lib.dir/error.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/exif.cpp.o"
+  "CMakeFiles/exiv2lib.dir/exif.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/futils.cpp.o"
+  "CMakeFiles/exiv2lib.dir/futils.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/gifimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/gifimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/http.cpp.o"
+  "CMakeFiles/exiv2lib.dir/http.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/image.cpp.o"
+  "CMakeFiles/exiv2lib.dir/image.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/ini.cpp.o"
+  "CMakeFiles/exiv2lib.dir/ini.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/iptc.cpp.o"
+  "CMakeFiles/exiv2lib.dir/iptc.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/jp2image.cpp.o"
+  "CMakeFiles/exiv2lib.dir/jp2image.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/jpgimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/jpgimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/metadatum.cpp.o"
+  "CMakeFiles/exiv2lib.dir/metadatum.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/mrwimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/mrwimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/orfimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/orfimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/pgfimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/pgfimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/pngimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/pngimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/preview.cpp.o"
+  "CMakeFiles/exiv2lib.dir/preview.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/properties.cpp.o"
+  "CMakeFiles/exiv2lib.dir/properties.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/psdimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/psdimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/rafimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/rafimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/rw2image.cpp.o"
+  "CMakeFiles/exiv2lib.dir/rw2image.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/tags.cpp.o"
+  "CMakeFiles/exiv2lib.dir/tags.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/tgaimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/tgaimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/tiffimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/tiffimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/types.cpp.o"
+  "CMakeFiles/exiv2lib.dir/types.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/value.cpp.o"
+  "CMakeFiles/exiv2lib.dir/value.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/version.cpp.o"
+  "CMakeFiles/exiv2lib.dir/version.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/webpimage.cpp.o"
+  "CMakeFiles/exiv2lib.dir/webpimage.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/xmp.cpp.o"
+  "CMakeFiles/exiv2lib.dir/xmp.cpp.o.d"
+  "CMakeFiles/exiv2lib.dir/xmpsidecar.cpp.o"
+  "CMakeFiles/exiv2lib.dir/xmpsidecar.cpp.o.d"
+  "libexiv2.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/exiv2lib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
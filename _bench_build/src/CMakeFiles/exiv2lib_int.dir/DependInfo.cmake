@@ -0,0 +1,42 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/canonmn_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/canonmn_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/canonmn_int.cpp.o.d"
+  "/root/repo/src/casiomn_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/casiomn_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/casiomn_int.cpp.o.d"
+  "/root/repo/src/cr2header_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/cr2header_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/cr2header_int.cpp.o.d"
+  "/root/repo/src/crwimage_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/crwimage_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/crwimage_int.cpp.o.d"
+  "/root/repo/src/fujimn_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/fujimn_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/fujimn_int.cpp.o.d"
+  "/root/repo/src/helper_functions.cpp" "src/CMakeFiles/exiv2lib_int.dir/helper_functions.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/helper_functions.cpp.o.d"
+  "/root/repo/src/image_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/image_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/image_int.cpp.o.d"
+  "/root/repo/src/makernote_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/makernote_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/makernote_int.cpp.o.d"
+  "/root/repo/src/minoltamn_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/minoltamn_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/minoltamn_int.cpp.o.d"
+  "/root/repo/src/nikonmn_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/nikonmn_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/nikonmn_int.cpp.o.d"
+  "/root/repo/src/olympusmn_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/olympusmn_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/olympusmn_int.cpp.o.d"
+  "/root/repo/src/orfimage_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/orfimage_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/orfimage_int.cpp.o.d"
+  "/root/repo/src/panasonicmn_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/panasonicmn_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/panasonicmn_int.cpp.o.d"
+  "/root/repo/src/pentaxmn_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/pentaxmn_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/pentaxmn_int.cpp.o.d"
+  "/root/repo/src/pngchunk_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/pngchunk_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/pngchunk_int.cpp.o.d"
+  "/root/repo/src/rw2image_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/rw2image_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/rw2image_int.cpp.o.d"
+  "/root/repo/src/samsungmn_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/samsungmn_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/samsungmn_int.cpp.o.d"
+  "/root/repo/src/sigmamn_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/sigmamn_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/sigmamn_int.cpp.o.d"
+  "/root/repo/src/sonymn_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/sonymn_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/sonymn_int.cpp.o.d"
+  "/root/repo/src/tags_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/tags_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/tags_int.cpp.o.d"
+  "/root/repo/src/tiffcomposite_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/tiffcomposite_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/tiffcomposite_int.cpp.o.d"
+  "/root/repo/src/tiffimage_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/tiffimage_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/tiffimage_int.cpp.o.d"
+  "/root/repo/src/tiffvisitor_int.cpp" "src/CMakeFiles/exiv2lib_int.dir/tiffvisitor_int.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/tiffvisitor_int.cpp.o.d"
+  "/root/repo/src/utils.cpp" "src/CMakeFiles/exiv2lib_int.dir/utils.cpp.o" "gcc" "src/CMakeFiles/exiv2lib_int.dir/utils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,55 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/exiv2lib_int.dir/canonmn_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/canonmn_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/casiomn_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/casiomn_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/cr2header_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/cr2header_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/crwimage_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/crwimage_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/fujimn_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/fujimn_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/helper_functions.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/helper_functions.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/image_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/image_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/makernote_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/makernote_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/minoltamn_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/minoltamn_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/nikonmn_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/nikonmn_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/olympusmn_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/olympusmn_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/orfimage_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/orfimage_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/panasonicmn_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/panasonicmn_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/pentaxmn_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/pentaxmn_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/pngchunk_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/pngchunk_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/rw2image_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/rw2image_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/samsungmn_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/samsungmn_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/sigmamn_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/sigmamn_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/sonymn_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/sonymn_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/tags_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/tags_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/tiffcomposite_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/tiffcomposite_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/tiffimage_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/tiffimage_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/tiffvisitor_int.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/tiffvisitor_int.cpp.o.d"
+  "CMakeFiles/exiv2lib_int.dir/utils.cpp.o"
+  "CMakeFiles/exiv2lib_int.dir/utils.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/exiv2lib_int.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,173 @@
+# Install script for directory: /root/repo/src
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  foreach(file
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libexiv2.so.1.0.0.9"
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libexiv2.so.0"
+      )
+    if(EXISTS "${file}" AND
+       NOT IS_SYMLINK "${file}")
+      file(RPATH_CHECK
+           FILE "${file}"
+           RPATH "$ORIGIN/../lib")
+    endif()
+  endforeach()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES
+    "/root/repo/_bench_build/lib/libexiv2.so.1.0.0.9"
+    "/root/repo/_bench_build/lib/libexiv2.so.0"
+    )
+  foreach(file
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libexiv2.so.1.0.0.9"
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libexiv2.so.0"
+      )
+    if(EXISTS "${file}" AND
+       NOT IS_SYMLINK "${file}")
+      file(RPATH_CHANGE
+           FILE "${file}"
+           OLD_RPATH "::::::::::::::"
+           NEW_RPATH "$ORIGIN/../lib")
+      if(CMAKE_INSTALL_DO_STRIP)
+        execute_process(COMMAND "/usr/bin/strip" "${file}")
+      endif()
+    endif()
+  endforeach()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libexiv2.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libexiv2.so")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libexiv2.so"
+         RPATH "$ORIGIN/../lib")
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES "/root/repo/_bench_build/lib/libexiv2.so")
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libexiv2.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libexiv2.so")
+    file(RPATH_CHANGE
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libexiv2.so"
+         OLD_RPATH "::::::::::::::"
+         NEW_RPATH "$ORIGIN/../lib")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libexiv2.so")
+    endif()
+  endif()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/exiv2" TYPE FILE FILES
+    "/root/repo/src/../include/exiv2/basicio.hpp"
+    "/root/repo/src/../include/exiv2/bmffimage.hpp"
+    "/root/repo/src/../include/exiv2/bmpimage.hpp"
+    "/root/repo/src/../include/exiv2/config.h"
+    "/root/repo/src/../include/exiv2/convert.hpp"
+    "/root/repo/src/../include/exiv2/cr2image.hpp"
+    "/root/repo/src/../include/exiv2/crwimage.hpp"
+    "/root/repo/src/../include/exiv2/datasets.hpp"
+    "/root/repo/src/../include/exiv2/easyaccess.hpp"
+    "/root/repo/src/../include/exiv2/epsimage.hpp"
+    "/root/repo/src/../include/exiv2/error.hpp"
+    "/root/repo/src/../include/exiv2/exif.hpp"
+    "/root/repo/src/../include/exiv2/exiv2.hpp"
+    "/root/repo/src/../include/exiv2/futils.hpp"
+    "/root/repo/src/../include/exiv2/gifimage.hpp"
+    "/root/repo/src/../include/exiv2/http.hpp"
+    "/root/repo/src/../include/exiv2/image.hpp"
+    "/root/repo/src/../include/exiv2/image_types.hpp"
+    "/root/repo/src/../include/exiv2/ini.hpp"
+    "/root/repo/src/../include/exiv2/iptc.hpp"
+    "/root/repo/src/../include/exiv2/jp2image.hpp"
+    "/root/repo/src/../include/exiv2/jpgimage.hpp"
+    "/root/repo/src/../include/exiv2/metadatum.hpp"
+    "/root/repo/src/../include/exiv2/mrwimage.hpp"
+    "/root/repo/src/../include/exiv2/orfimage.hpp"
+    "/root/repo/src/../include/exiv2/pgfimage.hpp"
+    "/root/repo/src/../include/exiv2/preview.hpp"
+    "/root/repo/src/../include/exiv2/properties.hpp"
+    "/root/repo/src/../include/exiv2/psdimage.hpp"
+    "/root/repo/src/../include/exiv2/rafimage.hpp"
+    "/root/repo/src/../include/exiv2/rw2image.hpp"
+    "/root/repo/src/../include/exiv2/slice.hpp"
+    "/root/repo/src/../include/exiv2/tags.hpp"
+    "/root/repo/src/../include/exiv2/tgaimage.hpp"
+    "/root/repo/src/../include/exiv2/tiffimage.hpp"
+    "/root/repo/src/../include/exiv2/types.hpp"
+    "/root/repo/src/../include/exiv2/value.hpp"
+    "/root/repo/src/../include/exiv2/version.hpp"
+    "/root/repo/src/../include/exiv2/webpimage.hpp"
+    "/root/repo/src/../include/exiv2/xmp_exiv2.hpp"
+    "/root/repo/src/../include/exiv2/xmpsidecar.hpp"
+    "/root/repo/src/../include/exiv2/pngimage.hpp"
+    "/root/repo/_bench_build/exv_conf.h"
+    "/root/repo/_bench_build/exiv2lib_export.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/cmake/exiv2/exiv2Config.cmake")
+    file(DIFFERENT _cmake_export_file_changed FILES
+         "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/cmake/exiv2/exiv2Config.cmake"
+         "/root/repo/_bench_build/src/CMakeFiles/Export/7c214f9ecc114891e0d2d508bbbeac60/exiv2Config.cmake")
+    if(_cmake_export_file_changed)
+      file(GLOB _cmake_old_config_files "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/cmake/exiv2/exiv2Config-*.cmake")
+      if(_cmake_old_config_files)
+        string(REPLACE ";" ", " _cmake_old_config_files_text "${_cmake_old_config_files}")
+        message(STATUS "Old export file \"$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/cmake/exiv2/exiv2Config.cmake\" will be replaced.  Removing files [${_cmake_old_config_files_text}].")
+        unset(_cmake_old_config_files_text)
+        file(REMOVE ${_cmake_old_config_files})
+      endif()
+      unset(_cmake_old_config_files)
+    endif()
+    unset(_cmake_export_file_changed)
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib/cmake/exiv2" TYPE FILE FILES "/root/repo/_bench_build/src/CMakeFiles/Export/7c214f9ecc114891e0d2d508bbbeac60/exiv2Config.cmake")
+  if(CMAKE_INSTALL_CONFIG_NAME MATCHES "^([Rr][Ee][Ll][Ee][Aa][Ss][Ee])$")
+    file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib/cmake/exiv2" TYPE FILE FILES "/root/repo/_bench_build/src/CMakeFiles/Export/7c214f9ecc114891e0d2d508bbbeac60/exiv2Config-release.cmake")
+  endif()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib/cmake/exiv2" TYPE FILE FILES "/root/repo/_bench_build/src/exiv2ConfigVersion.cmake")
+endif()
+
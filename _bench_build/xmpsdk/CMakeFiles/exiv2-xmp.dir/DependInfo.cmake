@@ -0,0 +1,34 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/xmpsdk/src/ExpatAdapter.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/ExpatAdapter.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/ExpatAdapter.cpp.o.d"
+  "/root/repo/xmpsdk/src/MD5.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/MD5.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/MD5.cpp.o.d"
+  "/root/repo/xmpsdk/src/ParseRDF.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/ParseRDF.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/ParseRDF.cpp.o.d"
+  "/root/repo/xmpsdk/src/UnicodeConversions.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/UnicodeConversions.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/UnicodeConversions.cpp.o.d"
+  "/root/repo/xmpsdk/src/WXMPIterator.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/WXMPIterator.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/WXMPIterator.cpp.o.d"
+  "/root/repo/xmpsdk/src/WXMPMeta.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/WXMPMeta.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/WXMPMeta.cpp.o.d"
+  "/root/repo/xmpsdk/src/WXMPUtils.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/WXMPUtils.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/WXMPUtils.cpp.o.d"
+  "/root/repo/xmpsdk/src/XML_Node.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XML_Node.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XML_Node.cpp.o.d"
+  "/root/repo/xmpsdk/src/XMPCore_Impl.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPCore_Impl.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPCore_Impl.cpp.o.d"
+  "/root/repo/xmpsdk/src/XMPIterator.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPIterator.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPIterator.cpp.o.d"
+  "/root/repo/xmpsdk/src/XMPMeta-GetSet.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPMeta-GetSet.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPMeta-GetSet.cpp.o.d"
+  "/root/repo/xmpsdk/src/XMPMeta-Parse.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPMeta-Parse.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPMeta-Parse.cpp.o.d"
+  "/root/repo/xmpsdk/src/XMPMeta-Serialize.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPMeta-Serialize.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPMeta-Serialize.cpp.o.d"
+  "/root/repo/xmpsdk/src/XMPMeta.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPMeta.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPMeta.cpp.o.d"
+  "/root/repo/xmpsdk/src/XMPUtils-FileInfo.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPUtils-FileInfo.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPUtils-FileInfo.cpp.o.d"
+  "/root/repo/xmpsdk/src/XMPUtils.cpp" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPUtils.cpp.o" "gcc" "xmpsdk/CMakeFiles/exiv2-xmp.dir/src/XMPUtils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,41 @@
+file(REMOVE_RECURSE
+  "../lib/libexiv2-xmp.a"
+  "../lib/libexiv2-xmp.pdb"
+  "CMakeFiles/exiv2-xmp.dir/src/ExpatAdapter.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/ExpatAdapter.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/MD5.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/MD5.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/ParseRDF.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/ParseRDF.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/UnicodeConversions.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/UnicodeConversions.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/WXMPIterator.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/WXMPIterator.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/WXMPMeta.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/WXMPMeta.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/WXMPUtils.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/WXMPUtils.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/XML_Node.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/XML_Node.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPCore_Impl.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPCore_Impl.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPIterator.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPIterator.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPMeta-GetSet.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPMeta-GetSet.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPMeta-Parse.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPMeta-Parse.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPMeta-Serialize.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPMeta-Serialize.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPMeta.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPMeta.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPUtils-FileInfo.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPUtils-FileInfo.cpp.o.d"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPUtils.cpp.o"
+  "CMakeFiles/exiv2-xmp.dir/src/XMPUtils.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/exiv2-xmp.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
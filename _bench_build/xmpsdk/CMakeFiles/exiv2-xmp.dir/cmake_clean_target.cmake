@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "../lib/libexiv2-xmp.a"
+)
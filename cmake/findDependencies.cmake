@@ -18,6 +18,9 @@ endif()
 
 find_package(Filesystem REQUIRED)
 
+# RemoteIo sends its read-ahead requests from several threads
+find_package(Threads REQUIRED)
+
 # don't use Frameworks on the Mac (#966)
 if (APPLE)
      set(CMAKE_FIND_FRAMEWORK NEVER)
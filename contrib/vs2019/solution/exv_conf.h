@@ -56,6 +56,18 @@
 // Define if you have the munmap function.
 /* #undef EXV_HAVE_MUNMAP */
 
+// Define if you have the copy_file_range function.
+/* #undef EXV_HAVE_COPY_FILE_RANGE */
+
+// Define if you have the sendfile function in <sys/sendfile.h>.
+/* #undef EXV_HAVE_SENDFILE */
+
+// Define if you have the pread function.
+/* #undef EXV_HAVE_PREAD */
+
+// Define if you have the writev function in <sys/uio.h>.
+/* #undef EXV_HAVE_WRITEV */
+
 // Define if you have <sys/stat.h> header file.
 #define EXV_HAVE_SYS_STAT_H
 
@@ -111,6 +111,21 @@ namespace Exiv2 {
               0 if failure;
          */
         virtual long write(BasicIo& src) = 0;
+        /*!
+          @brief Copy \em rcount bytes of another BasicIo instance, starting
+              at offset \em offset of the source, to the IO source. Current
+              IO position is advanced by the number of bytes copied and the
+              source is positioned after the copied data. The default
+              implementation writes directly from the source if it can lend
+              its data (see readView()) and copies through a buffer
+              otherwise.
+          @param src Reference to another BasicIo instance
+          @param offset Offset of the data to copy in the source
+          @param rcount Number of bytes to copy
+          @throw Error If the data cannot be read from the source or
+              written to the IO source
+         */
+        virtual void copyFrom(BasicIo& src, int64_t offset, size_t rcount);
         /*!
           @brief Write one byte to the IO source. Current IO position is
               advanced by one byte.
@@ -154,6 +169,54 @@ namespace Exiv2 {
           @param err Error code to use if an exception is thrown.
          */
         void readOrThrow(byte* buf, long rcount, ErrorCode err);
+        /*!
+          @brief Read data at offset \em offset of the IO source. The IO
+              position is neither used nor changed.
+
+          FileIo, MmapIo and MemIo implement this without any shared state,
+          so several threads can read from the same open instance at the
+          same time, as long as nothing is written to it and it is not
+          closed. The default implementation seeks to \em offset, reads
+          and restores the IO position; it is not safe for concurrent use.
+
+          @param offset Offset of the data in the IO source.
+          @param buf Pointer to a block of memory into which the read data
+              is stored. The memory block must be at least \em rcount bytes
+              long.
+          @param rcount Maximum number of bytes to read. Fewer bytes may be
+              read if \em rcount bytes are not available.
+          @return Number of bytes read from IO source successfully;<BR>
+              0 if failure;
+         */
+        virtual long readAt(int64_t offset, byte* buf, long rcount);
+        /*!
+          @brief Borrow the next \em rcount bytes of the IO source instead of
+              copying them. The IO position is advanced by \em rcount bytes.
+              The returned pointer refers to the storage of the IO source and
+              remains valid until the IO source is written to or closed.
+
+          IO sources which do not hold their data in one contiguous block of
+          memory cannot lend it out. The default implementation therefore
+          returns nullptr and leaves the IO position unchanged; callers must
+          then fall back to read().
+
+          @param rcount Number of bytes to borrow.
+          @return Pointer to \em rcount bytes of data if successful;<BR>
+              nullptr if the data cannot be borrowed.
+         */
+        virtual const byte* readView(long rcount);
+        /*!
+          @brief Safe version of `readView()`. Borrows the next \em rcount
+              bytes of the IO source if possible, otherwise reads them into
+              \em buf. Throws an exception if fewer than \em rcount bytes
+              are available.
+          @param rcount Number of bytes to read.
+          @param buf Fallback storage, only used if the data cannot be
+              borrowed. It must outlive the use of the returned pointer.
+          @param err Error code to use if an exception is thrown.
+          @return Pointer to \em rcount bytes of data.
+         */
+        const byte* readViewOrThrow(long rcount, DataBuf& buf, ErrorCode err);
         /*!
           @brief Read one byte from the IO source. Current IO position is
               advanced by one byte.
@@ -161,6 +224,18 @@ namespace Exiv2 {
               EOF if failure;
          */
         virtual int getb() = 0;
+        /*!
+          @brief Advance the IO position to the next byte with value
+              \em value, starting at the current IO position. The byte
+              itself is not consumed. The default implementation reads
+              byte by byte with getb(); IO sources which hold their data in
+              memory search it with memchr().
+          @param value The value to search for.
+          @return 0 if the byte was found;<BR>
+              nonzero if it was not found, the IO position is then at the
+              end of the IO source and eof() is true.
+         */
+        virtual int seekToByte(byte value);
         /*!
           @brief Remove all data from this object's IO source and then transfer
               data from the \em src BasicIo object into this object.
@@ -241,6 +316,13 @@ namespace Exiv2 {
               available.
          */
         virtual const std::string& path() const noexcept =0;
+        /*!
+          @brief Return a new, open IO instance to write a modified copy of
+              this IO source to. The copy is committed with transfer().
+              The default implementation returns a MemIo.
+          @throw Error In case of failure
+         */
+        virtual UniquePtr temporary() const;
 
         /*!
           @brief Mark all the bNone blocks to bKnow. This avoids allocating memory
@@ -363,6 +445,15 @@ namespace Exiv2 {
                  0 if failure;
          */
         long write(BasicIo& src) override;
+        /*!
+          @brief Copy data from another BasicIo instance to the file. If the
+              source is a FileIo, the data is copied by the kernel where the
+              system supports it (copy_file_range() or sendfile()), without
+              passing through user space.
+          @throw Error If the data cannot be read from the source or
+              written to the file
+         */
+        void copyFrom(BasicIo& src, int64_t offset, size_t rcount) override;
         /*!
           @brief Write one byte to the file. The file position is
               advanced by one byte.
@@ -402,6 +493,10 @@ namespace Exiv2 {
                  EOF if failure;
          */
         int getb() override;
+        //! Search the read-ahead buffer for a byte, see BasicIo::seekToByte()
+        int seekToByte(byte value) override;
+        //! Read data at an offset of the file with pread(), see BasicIo::readAt()
+        long readAt(int64_t offset, byte* buf, long rcount) override;
         /*!
           @brief Remove the contents of the file and then transfer data from
               the \em src BasicIo object into the empty file.
@@ -473,6 +568,17 @@ namespace Exiv2 {
         bool eof() const override;
         //! Returns the path of the file
         const std::string& path() const noexcept override;
+        /*!
+          @brief Return a MemIo if the file is not larger than
+              writeBufferSize(). Otherwise return a FileIo for a new
+              temporary file in the directory of this file, which transfer()
+              renames over it. The temporary file is written through a buffer
+              of writeBufferSize() bytes and removed if it is not transferred.
+              A MemIo is also returned for files with more than one hard link,
+              which a rename would break, and if the temporary file cannot be
+              created.
+         */
+        BasicIo::UniquePtr temporary() const override;
 
         /*!
           @brief Mark all the bNone blocks to bKnow. This avoids allocating memory
@@ -497,6 +603,138 @@ namespace Exiv2 {
 
     }; // class FileIo
 
+    /*!
+      @brief Provides read-only binary file IO through a memory mapping.
+
+      The file is mapped into the process's address space once when it is
+      opened and all reads are served from the mapping. Format readers use
+      readView() to parse metadata segments in place, without allocating
+      and copying them first.
+
+      The mapping is only used while the file is open for reading with
+      open(). Files opened with an explicit mode through FileIo::open(mode),
+      e.g., by transfer(), and empty files are handled exactly as by FileIo.
+     */
+    class EXIV2API MmapIo : public FileIo {
+    public:
+        //! @name Creators
+        //@{
+        /*!
+          @brief Constructor that accepts the file path on which IO will be
+              performed. The constructor does not open the file, and
+              therefore never fails.
+          @param path The full path of a file
+         */
+        explicit MmapIo(const std::string& path);
+
+        //! Destructor. Unmaps and closes an open file.
+        ~MmapIo() override;
+        //@}
+
+        //! @name Manipulators
+        //@{
+        using FileIo::open;
+        /*!
+          @brief Open the file in read-only mode and map it into memory.
+              This method can also be used to "reopen" a file which will
+              reset the IO position to the start.
+          @return 0 if successful;<BR>
+              Nonzero if failure.
+         */
+        int open() override;
+        /*!
+          @brief Release the mapping and close the file. It is safe to call
+              close on an already closed instance.
+          @return 0 if successful;<BR>
+                 Nonzero if failure;
+         */
+        int close() override;
+        /*!
+          @brief Write data to the file. Not supported while the file is
+              mapped for reading.
+          @return Number of bytes written to the file successfully;<BR>
+                 0 if failure;
+         */
+        long write(const byte* data, long wcount) override;
+        /*!
+          @brief Write data that is read from another BasicIo instance to the
+              file. Not supported while the file is mapped for reading.
+          @return Number of bytes written to the file successfully;<BR>
+                 0 if failure;
+         */
+        long write(BasicIo& src) override;
+        /*!
+          @brief Write one byte to the file. Not supported while the file is
+              mapped for reading.
+          @return The value of the byte written if successful;<BR>
+                 EOF if failure;
+         */
+        int putb(byte data) override;
+        //! Read data from the mapped file, see FileIo::read(long)
+        DataBuf read(long rcount) override;
+        //! Read data from the mapped file, see FileIo::read(byte*, long)
+        long read(byte* buf, long rcount) override;
+        //! Read one byte from the mapped file, see FileIo::getb()
+        int getb() override;
+        //! Search the mapped file for a byte, see BasicIo::seekToByte()
+        int seekToByte(byte value) override;
+        //! Read data at an offset of the mapped file, see BasicIo::readAt()
+        long readAt(int64_t offset, byte* buf, long rcount) override;
+        /*!
+          @brief Borrow data from the mapped file without copying it. The IO
+              position is advanced by \em rcount bytes. The pointer is valid
+              until the file is closed.
+          @return Pointer into the mapping if at least \em rcount bytes are
+              available;<BR>
+              nullptr otherwise.
+         */
+        const byte* readView(long rcount) override;
+        /*!
+          @brief Release the mapping and transfer data from the \em src
+              BasicIo object into the file, see FileIo::transfer(). If the
+              file was mapped before, it is mapped again afterwards.
+         */
+        void transfer(BasicIo& src) override;
+
+        int seek(int64_t offset, Position pos) override;
+
+        /*!
+          @brief Direct access to the mapped file. A read-only request returns
+                 the existing mapping. A writeable request releases it and
+                 falls back to FileIo::mmap().
+         */
+        byte* mmap(bool isWriteable = false) override;
+        /*!
+          @brief The read-only mapping belongs to the MmapIo object and is
+                 only released by close(). A writeable mapping is removed as
+                 by FileIo::munmap().
+          @return 0 if successful;<BR>
+                  Nonzero if failure;
+         */
+        int munmap() override;
+        //@}
+
+        //! @name Accessors
+        //@{
+        long tell() const override;
+        size_t size() const override;
+        int error() const override;
+        bool eof() const override;
+        //@}
+
+        // NOT IMPLEMENTED
+        //! Copy constructor
+        MmapIo(MmapIo& rhs) = delete;
+        //! Assignment operator
+        MmapIo& operator=(const MmapIo& rhs) = delete;
+
+    private:
+        // Pimpl idiom
+        class Impl;
+        std::unique_ptr<Impl> p_;
+
+    }; // class MmapIo
+
     /*!
       @brief Provides binary IO on blocks of memory by implementing the BasicIo
           interface. A copy-on-write implementation ensures that the data passed
@@ -564,6 +802,12 @@ namespace Exiv2 {
                  0 if failure;
          */
         long write(BasicIo& src) override;
+        /*!
+          @brief Copy data from another BasicIo instance to the memory block.
+              The data is read directly into the memory block.
+          @throw Error If the data cannot be read from the source
+         */
+        void copyFrom(BasicIo& src, int64_t offset, size_t rcount) override;
         /*!
           @brief Write one byte to the memory block. The IO position is
               advanced by one byte.
@@ -603,6 +847,18 @@ namespace Exiv2 {
                  EOF if failure;
          */
         int getb() override;
+        //! Search the memory block for a byte, see BasicIo::seekToByte()
+        int seekToByte(byte value) override;
+        //! Read data at an offset of the memory block, see BasicIo::readAt()
+        long readAt(int64_t offset, byte* buf, long rcount) override;
+        /*!
+          @brief Borrow data from the memory block without copying it. The IO
+              position is advanced by \em rcount bytes.
+          @return Pointer into the memory block if at least \em rcount bytes
+              are available;<BR>
+              nullptr otherwise.
+         */
+        const byte* readView(long rcount) override;
         /*!
           @brief Clear the memory block and then transfer data from
               the \em src BasicIo object into a new block of memory.
@@ -674,6 +930,9 @@ namespace Exiv2 {
         MemIo& operator=(const MemIo& rhs) = delete;
 
     private:
+        //! FileIo::write() writes the memory area of a MemIo directly.
+        friend class FileIo;
+
         // Pimpl idiom
         class Impl;
         std::unique_ptr<Impl> p_;
@@ -1008,6 +1267,36 @@ namespace Exiv2 {
       @throw Error In case of failure.
      */
     EXIV2API long writeFile(const DataBuf& buf, const std::string& path);
+    /*!
+      @brief Set the size of the buffer used to write images and return the
+          previous size. When the metadata of a file is written, a new image
+          up to this size is built in memory. Larger images are streamed to a
+          temporary file through a buffer of this size, so that the memory
+          used does not grow with the size of the image. The default is 16 MB.
+     */
+    EXIV2API size_t setWriteBufferSize(size_t size);
+    //! Return the size of the buffer used to write images, see setWriteBufferSize().
+    EXIV2API size_t writeBufferSize();
+    /*!
+      @brief Set the size of the read-ahead buffer of FileIo and return the
+          previous size. FileIo reads the file in blocks of this size, so
+          that getb() and small reads are served from memory. The size
+          applies to files opened afterwards. A size of 0 disables the
+          buffer. The default is 64 kB.
+     */
+    EXIV2API size_t setReadBufferSize(size_t size);
+    //! Return the size of the read-ahead buffer of FileIo, see setReadBufferSize().
+    EXIV2API size_t readBufferSize();
+    /*!
+      @brief Set the maximum number of bytes of a remote file which RemoteIo
+          keeps in memory and return the previous size. When the limit is
+          reached, the least recently used blocks are released and fetched
+          again if they are read later. A size of 0 removes the limit. The
+          default is 64 MB.
+     */
+    EXIV2API size_t setRemoteCacheSize(size_t size);
+    //! Return the maximum size of the blocks cached by RemoteIo, see setRemoteCacheSize().
+    EXIV2API size_t remoteCacheSize();
 #ifdef EXV_USE_CURL
     /*!
       @brief The callback function is called by libcurl to write the data
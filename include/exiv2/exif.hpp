@@ -35,7 +35,13 @@
 #include "tags.hpp"
 
 // + standard includes
+#include <cstdint>
+#include <functional>
 #include <list>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
 
 // *****************************************************************************
 // namespace extensions
@@ -58,6 +64,7 @@ namespace Exiv2 {
      */
     class EXIV2API Exifdatum : public Metadatum {
         template<typename T> friend Exifdatum& setValue(Exifdatum&, const T&);
+        friend class ExifData;
     public:
         //! @name Creators
         //@{
@@ -215,6 +222,13 @@ namespace Exiv2 {
         // DATA
         ExifKey::UniquePtr key_;                  //!< Key
         Value::UniquePtr   value_;                //!< Value
+        // Copies of the numeric parts of the key, to look them up without
+        // going through key_
+        uint16_t           tag_;                  //!< Tag of the key
+        int                ifdId_;                //!< IFD id of the key
+        int                idx_;                  //!< Index of the key
+        //! Key change counter of the ExifData which holds this datum, not copied
+        uint64_t*          keyChanges_{nullptr};
 
     }; // class Exifdatum
 
@@ -402,9 +416,25 @@ namespace Exiv2 {
         typedef ExifMetadata::iterator iterator;
         //! ExifMetadata const iterator type
         typedef ExifMetadata::const_iterator const_iterator;
+        //! Function which decodes a deferred makernote into the empty container passed to it
+        typedef std::function<void(ExifData& exifData)> MakernoteDecoder;
+
+        //! @name Creators
+        //@{
+        //! Default constructor
+        ExifData();
+        //! Copy constructor
+        ExifData(const ExifData& rhs);
+        //! Move constructor
+        ExifData(ExifData&& rhs) noexcept;
+        //@}
 
         //! @name Manipulators
         //@{
+        //! Assignment operator
+        ExifData& operator=(const ExifData& rhs);
+        //! Move assignment operator
+        ExifData& operator=(ExifData&& rhs) noexcept;
         /*!
           @brief Returns a reference to the %Exifdatum that is associated with a
                  particular \em key. If %ExifData does not already contain such
@@ -451,40 +481,170 @@ namespace Exiv2 {
         void sortByKey();
         //! Sort metadata by tag
         void sortByTag();
+        /*!
+          @brief Defer decoding the makernote to \em decoder, see
+                 ExifFilter::deferMakernote().
+
+          The makernote metadata is decoded and inserted after the raw
+          makernote tag the first time the metadata is iterated over,
+          counted or sorted, or metadata of a makernote group is looked up
+          or added. Until then, the container is not safe for concurrent
+          reads, even through const methods. An error while decoding the
+          makernote is reported as a warning and the metadata decoded up to
+          that point is kept.
+         */
+        void setMakernoteDecoder(MakernoteDecoder decoder);
         //! Begin of the metadata
-        iterator begin() { return exifMetadata_.begin(); }
+        iterator begin() { decodeMakernote(); return exifMetadata_.begin(); }
         //! End of the metadata
         iterator end() { return exifMetadata_.end(); }
         /*!
           @brief Find the first Exifdatum with the given \em key, return an
                  iterator to it.
+
+          Lookups use an index on the tag and IFD of the key, which is kept up
+          to date by the methods of this class. Changing the key of an element
+          in place, i.e., assigning another Exifdatum to it through an
+          iterator or reference, invalidates the index and the next lookup
+          rebuilds it.
          */
         iterator findKey(const ExifKey& key);
+        /*!
+          @brief Find the first Exifdatum with the given \em tag in the IFD
+                 \em ifdId, return an iterator to it. This is the same as
+                 findKey(const ExifKey&) without creating a key.
+         */
+        iterator findKey(uint16_t tag, int ifdId);
         //@}
 
         //! @name Accessors
         //@{
         //! Begin of the metadata
-        const_iterator begin() const { return exifMetadata_.begin(); }
+        const_iterator begin() const { decodeMakernote(); return exifMetadata_.begin(); }
         //! End of the metadata
         const_iterator end() const { return exifMetadata_.end(); }
         /*!
           @brief Find the first Exifdatum with the given \em key, return a const
-                 iterator to it.
+                 iterator to it. This method does not modify the index; if it
+                 is not up to date, it falls back to a linear search.
          */
         const_iterator findKey(const ExifKey& key) const;
+        /*!
+          @brief Find the first Exifdatum with the given \em tag in the IFD
+                 \em ifdId, return a const iterator to it.
+         */
+        const_iterator findKey(uint16_t tag, int ifdId) const;
         //! Return true if there is no Exif metadata
         bool empty() const { return count() == 0; }
         //! Get the number of metadata entries
-        long count() const { return static_cast<long>(exifMetadata_.size()); }
+        long count() const { decodeMakernote(); return static_cast<long>(exifMetadata_.size()); }
+        //! Return true if the decoding of the makernote is deferred and still pending
+        bool makernotePending() const { return static_cast<bool>(makernoteDecoder_); }
         //@}
 
     private:
+        //! Index entry: the first Exifdatum with a key and the number of those
+        typedef std::pair<const_iterator, long> IndexEntry;
+        //! Index of the metadata by IfdId and tag
+        typedef std::unordered_map<uint32_t, IndexEntry> Index;
+
+        //! @name Manipulators
+        //@{
+        //! Add the last element of the metadata to the index, if it is valid
+        void indexBack();
+        //! Remove the element at \em pos from the index, if it is valid
+        void unindex(const_iterator pos);
+        //! Rebuild the index if it is not valid
+        void updateIndex();
+        //@}
+
+        //! Make the elements from \em first to \em last report key changes to this container
+        void adopt(iterator first, iterator last) const;
+
+        //! @name Accessors
+        //@{
+        //! Return true if the index reflects the current metadata
+        bool indexValid() const;
+        //! Find the first Exifdatum with the given \em tag and \em ifdId in the index
+        const_iterator find(uint16_t tag, int ifdId) const;
+        //! Decode a deferred makernote, if there is one
+        void decodeMakernote() const { if (makernoteDecoder_) insertMakernote(); }
+        //! Decode the deferred makernote for metadata of the group \em ifdId
+        void decodeMakernote(int ifdId) const;
+        //! Decode the deferred makernote and insert it after the raw makernote tag
+        void insertMakernote() const;
+        //@}
+
         // DATA
-        ExifMetadata exifMetadata_;
+        // Mutable, because decoding a deferred makernote in const methods
+        // changes how, not which, metadata is represented
+        mutable ExifMetadata exifMetadata_;
+        mutable Index index_;                       //!< Index for findKey()
+        mutable bool indexBuilt_;                   //!< False if the index needs to be rebuilt
+        //! Number of keys of the elements changed by Exifdatum::operator=(), null after a move
+        mutable std::unique_ptr<uint64_t> keyChanges_;
+        uint64_t indexedKeyChanges_;                //!< Value of *keyChanges_ when the index was built
+        mutable MakernoteDecoder makernoteDecoder_; //!< Decoder of a deferred makernote
 
     }; // class ExifData
 
+    /*!
+      @brief Selection of the Exif metadata to decode, see
+             Image::setExifFilter(). An empty filter selects all metadata.
+
+      The filter selects whole groups, e.g., "Photo" or "Nikon3", and single
+      tags. Only the selected metadata is added to the ExifData. Sub-IFDs,
+      makernotes and binary arrays which contain none of it are not parsed.
+      For example, a thumbnailer which only needs the orientation, the date
+      and the Exif thumbnail doesn't pay for decoding the makernote.
+     */
+    class EXIV2API ExifFilter {
+    public:
+        //! @name Manipulators
+        //@{
+        /*!
+          @brief Select all tags of the group \em groupName, e.g., "Thumbnail".
+          @throw Error if there is no such group.
+         */
+        ExifFilter& addGroup(const std::string& groupName);
+        /*!
+          @brief Select the tag with the key \em key, e.g.,
+                 "Exif.Image.Orientation".
+          @throw Error if the key is not valid.
+         */
+        ExifFilter& addKey(const std::string& key);
+        /*!
+          @brief Defer decoding makernotes until their metadata is first
+                 accessed, see ExifData::setMakernoteDecoder().
+
+          The raw makernote tag is decoded as usual and the bytes of the
+          makernote are kept with the ExifData. Writing the image decodes
+          the makernote, so it round-trips as before.
+         */
+        ExifFilter& deferMakernote(bool defer =true);
+        //@}
+
+        //! @name Accessors
+        //@{
+        //! Return true if the filter selects all metadata.
+        bool empty() const;
+        //! Return true if the filter selects the tag \em tag of the group \em ifdId.
+        bool selects(uint16_t tag, int ifdId) const;
+        //! Return true if the filter selects any tag of the group \em ifdId.
+        bool selectsGroup(int ifdId) const;
+        //! Return true if decoding makernotes is deferred.
+        bool defersMakernote() const;
+        //@}
+
+    private:
+        // DATA
+        std::set<int> groups_;                          //!< Groups selected as a whole
+        std::set<std::pair<int, uint16_t>> tags_;       //!< Single tags, by group and tag
+        std::set<int> tagGroups_;                       //!< Groups of the single tags
+        bool deferMakernote_ = false;                   //!< Decode makernotes on first access
+
+    }; // class ExifFilter
+
     /*!
       @brief Stateless parser class for Exif data. Images use this class to
              decode and encode binary Exif data.
@@ -504,12 +664,14 @@ namespace Exiv2 {
           @param pData 	  Pointer to the data buffer. Must point to data in
                           binary Exif format; no checks are performed.
           @param size 	  Length of the data buffer
+          @param pFilter  Selection of the metadata to decode, all if 0.
           @return Byte order in which the data is encoded.
         */
         static ByteOrder decode(
-                  ExifData& exifData,
-            const byte*     pData,
-                  uint32_t  size
+                  ExifData&   exifData,
+            const byte*       pData,
+                  uint32_t    size,
+            const ExifFilter* pFilter =nullptr
         );
         /*!
           @brief Encode Exif metadata from the provided metadata to binary Exif
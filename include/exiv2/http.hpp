@@ -25,6 +25,10 @@
 
 #include "datasets.hpp"
 
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace Exiv2 {
     /*!
@@ -33,8 +37,23 @@ namespace Exiv2 {
      @param response - a Dictionary of response headers (dictionary is filled by the response)
      @param errors   - a String with an error
      @return Server response 200 = OK, 404 = Not Found etc...
+     @note With request["version"] = "1.1" the connection is kept open after the
+           response and used again by the next request to the same server.
     */
     EXIV2API int http(Exiv2::Dictionary& request,Exiv2::Dictionary& response,std::string& errors);
+    /*!
+     @brief execute an HTTP request for several byte ranges of a resource in one call
+     @param request -  a Dictionary of headers to send to server, as for http() above
+     @param ranges   - the first and the last byte of each range
+     @param parts    - the data of each range (filled by the response). A range which
+                       is not in the response is left empty.
+     @param errors   - a String with an error
+     @return Server response 206 = Partial Content, 200 = OK, 404 = Not Found etc...
+     @note The server may send the ranges as multipart/byteranges, merge them into
+           one range or send the whole resource. The parts are extracted in any case.
+    */
+    EXIV2API int http(Exiv2::Dictionary& request, const std::vector<std::pair<uint64_t, uint64_t>>& ranges,
+                      std::vector<std::string>& parts, std::string& errors);
 }
 
 #endif
@@ -118,7 +118,8 @@ namespace Exiv2 {
           any exists section for that metadata type will be removed from the
           image.
 
-          @throw Error if the operation fails
+          @throw Error if the operation fails or if the Exif metadata was
+              read with a filter, see setExifFilter()
          */
         virtual void writeMetadata() =0;
         /*!
@@ -306,6 +307,31 @@ namespace Exiv2 {
           little-endian byte order (II) is used by default.
          */
         void setByteOrder(ByteOrder byteOrder);
+        /*!
+          @brief Select the Exif metadata which readMetadata() decodes.
+
+          By default all Exif metadata is decoded. With a filter, IFDs,
+          makernotes and binary arrays without selected metadata are not
+          parsed at all, which makes reading cheaper for applications which
+          need only a few tags. Exif metadata which some formats (e.g., CRW)
+          don't store in TIFF structures is not filtered. Writing the image
+          would lose the metadata which is not selected, so writeMetadata()
+          throws after a filtered read until the Exif data is replaced with
+          setExifData() or clearExifData(), or read again without a filter.
+         */
+        void setExifFilter(const ExifFilter& exifFilter);
+        /*!
+          @brief Let writeMetadata() append a TIFF structure which doesn't
+                 fit in place to the end of the file instead of writing the
+                 whole file anew.
+
+          The new structure refers to the image data where it is and only
+          the TIFF header is changed in the existing data, so the cost of
+          writing depends on the size of the metadata, not of the file. The
+          replaced structure remains in the file as unused bytes. Only TIFF
+          images support this, other formats ignore it.
+         */
+        void setAppendMetadata(bool append);
 
         /*!
           @brief Print out the structure of image file.
@@ -453,6 +479,17 @@ namespace Exiv2 {
         bool supportsMetadata(MetadataId metadataId) const;
         //! Return the flag indicating the source when writing XMP metadata.
         bool writeXmpFromPacket() const;
+        /*!
+          @brief Return how the last call to writeMetadata() updated the image:
+             wmNonIntrusive if the new metadata was patched into the existing
+             file in place, wmAppend if it was appended to the file, see
+             setAppendMetadata(), wmIntrusive if the image was written anew.
+         */
+        WriteMethod writeMethod() const;
+        //! Return true if writeMetadata() may append metadata to the file.
+        bool appendMetadata() const;
+        //! Return the selection of the Exif metadata which readMetadata() decodes.
+        const ExifFilter& exifFilter() const;
         //! Return list of native previews. This is meant to be used only by the PreviewManager.
         const NativePreviewList& nativePreviews() const;
         //@}
@@ -487,6 +524,13 @@ namespace Exiv2 {
         uint32_t          pixelWidth_;        //!< image pixel width
         uint32_t          pixelHeight_;       //!< image pixel height
         NativePreviewList nativePreviews_;    //!< list of native previews
+        WriteMethod       writeMethod_;       //!< How writeMetadata() last updated the image
+        ExifFilter        exifFilter_;        //!< Exif metadata to decode in readMetadata()
+        bool              appendMetadata_;    //!< Whether writeMetadata() may append metadata
+        bool              exifFiltered_;      //!< Whether exifData_ was read with a filter which drops metadata
+
+        //! Throw if exifData_ was read with a filter, writing it would lose the metadata which isn't selected.
+        void enforceExifUnfiltered() const;
 
         //! Return tag name for given tag id.
         const std::string& tagName(uint16_t tag);
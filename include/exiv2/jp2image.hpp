@@ -105,6 +105,17 @@ namespace Exiv2
          */
         void doWriteMetadata(BasicIo& outIo);
 
+        /*!
+          @brief Update the metadata boxes of the image in place, without
+                rewriting the file. This is only done if the image is a file,
+                its JP2 header box needs no change, the same kinds of metadata
+                are present before and after, and the new Exif and XMP data
+                fit into the old boxes. The IPTC data must keep its size.
+          @return true if the image was updated in place;<BR>
+                  false if the file was not modified and must be rewritten.
+         */
+        bool writeMetadataInPlace();
+
         /*!
          @brief reformats the Jp2Header to store iccProfile
          @param oldData DataBufRef to data in the file.
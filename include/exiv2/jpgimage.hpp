@@ -263,6 +263,17 @@ namespace Exiv2 {
           @return 4 if opening or writing to the associated BasicIo fails
          */
         void doWriteMetadata(BasicIo& outIo);
+        /*!
+          @brief Update the metadata segments of the image in place, without
+                rewriting the file. This is only done if the image is a file,
+                the same kinds of metadata are present before and after, and
+                each new Exif, XMP and comment segment fits into the old one.
+                The IPTC data must keep its size and the ICC profile must be
+                unchanged.
+          @return true if the image was updated in place;<BR>
+                  false if the file was not modified and must be rewritten.
+         */
+        bool writeMetadataInPlace();
         //@}
 
         //! @name Accessors
@@ -100,11 +100,12 @@ namespace Exiv2 {
                  See TiffParser::decode().
         */
         static ByteOrder decode(
-                  ExifData& exifData,
-                  IptcData& iptcData,
-                  XmpData&  xmpData,
-            const byte*     pData,
-                  uint32_t  size
+                  ExifData&   exifData,
+                  IptcData&   iptcData,
+                  XmpData&    xmpData,
+            const byte*       pData,
+                  uint32_t    size,
+            const ExifFilter* pFilter =nullptr
         );
         /*!
           @brief Encode metadata from the provided metadata to ORF format.
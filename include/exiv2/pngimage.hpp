@@ -26,6 +26,11 @@
 // included header files
 #include "image.hpp"
 
+// + standard includes
+#include <string>
+#include <utility>
+#include <vector>
+
 // *****************************************************************************
 // namespace extensions
 namespace Exiv2
@@ -95,6 +100,22 @@ namespace Exiv2
 
          */
         void doWriteMetadata(BasicIo& outIo);
+        /*!
+          @brief Update the metadata chunks of the image in place, without
+                rewriting the file. This is only done if the image is a file
+                and every new chunk has the size of the chunk it replaces.
+                The XMP packet is padded to fit, the other chunks are
+                compressed and must keep their size.
+          @return true if the image was updated in place;<BR>
+                  false if the file was not modified and must be rewritten.
+         */
+        bool writeMetadataInPlace();
+        /*!
+          @brief Encode the buffered metadata into the chunks written after
+                the IHDR chunk: comment, Exif, IPTC, ICC profile and XMP, in
+                this order. The chunk for metadata which is not set is empty.
+         */
+        std::vector<std::pair<MetadataId, std::string> > encodeMetadataChunks();
         //@}
 
         std::string profileName_;
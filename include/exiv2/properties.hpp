@@ -25,7 +25,7 @@
 
 // included header files
 #include "datasets.hpp"
-#include <mutex>
+#include <shared_mutex>
 
 // *****************************************************************************
 // namespace extensions
@@ -196,14 +196,10 @@ namespace Exiv2 {
         static void unregisterNs(const std::string& ns);
 
         /*!
-          @brief Lock to be used while modifying properties.
-
-          @todo For a proper read-write lock, this shall be improved by a
-          \em std::shared_timed_mutex (once C++14 is allowed) or
-          \em std::shared_mutex (once C++17 is allowed). The
-          read-access locks shall be updated to \em std::shared_lock then.
+          @brief Read-write lock of the namespace registry. Lookups hold it
+                 shared, registering and unregistering namespaces exclusively.
          */
-        static std::mutex mutex_;
+        static std::shared_mutex mutex_;
 
         /*!
           @brief Unregister all custom namespaces.
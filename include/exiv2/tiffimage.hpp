@@ -127,15 +127,17 @@ namespace Exiv2 {
           @param pData    Pointer to the data buffer. Must point to data in TIFF
                           format; no checks are performed.
           @param size     Length of the data buffer.
+          @param pFilter  Selection of the Exif metadata to decode, all if 0.
 
           @return Byte order in which the data is encoded.
         */
         static ByteOrder decode(
-                  ExifData& exifData,
-                  IptcData& iptcData,
-                  XmpData&  xmpData,
-            const byte*     pData,
-                  uint32_t  size
+                  ExifData&   exifData,
+                  IptcData&   iptcData,
+                  XmpData&    xmpData,
+            const byte*       pData,
+                  uint32_t    size,
+            const ExifFilter* pFilter =nullptr
         );
         /*!
           @brief Encode metadata from the provided metadata to TIFF format.
@@ -149,7 +151,11 @@ namespace Exiv2 {
           the result and nothing is written to \em io. If the return value is
           \c wmIntrusive, a new TIFF structure was created and written to
           \em io. The memory block \em pData, \em size may be partly updated
-          in this case and should not be used anymore.
+          in this case and should not be used anymore. If \em append is set
+          and \em io holds the data \em pData, \em size, the new TIFF
+          structure may instead be appended to \em io, referring to the
+          image data where it is, and only the IFD offset in the header is
+          changed in place. The return value is \c wmAppend then.
 
           @note If there is no metadata to encode, i.e., all metadata
                 containers are empty, then the return value is \c wmIntrusive
@@ -167,6 +173,8 @@ namespace Exiv2 {
           @param exifData  Exif metadata container.
           @param iptcData  IPTC metadata container.
           @param xmpData   XMP metadata container.
+          @param append    Append the TIFF structure to \em io if it
+                           doesn't fit in place.
 
           @return Write method used.
         */
@@ -177,7 +185,8 @@ namespace Exiv2 {
                   ByteOrder byteOrder,
             const ExifData& exifData,
             const IptcData& iptcData,
-            const XmpData&  xmpData
+            const XmpData&  xmpData,
+                  bool      append =false
         );
 
     }; // class TiffParser
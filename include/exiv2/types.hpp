@@ -72,6 +72,7 @@ namespace Exiv2 {
     {
         wmIntrusive,
         wmNonIntrusive,
+        wmAppend,
     };
 
     //! An identifier for each type of metadata
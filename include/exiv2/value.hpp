@@ -30,6 +30,7 @@
 #include <cstring>
 #include <iomanip>
 #include <map>
+#include <memory>
 
 // *****************************************************************************
 // namespace extensions
@@ -81,6 +81,16 @@ namespace Exiv2 {
 
     private:
         void doWriteMetadata(BasicIo& outIo);
+        /*!
+          @brief Update the metadata chunks of the image in place, without
+                rewriting the file. This is only done if the image is a file
+                with a VP8X chunk, the same kinds of metadata are present
+                before and after, and the new Exif and XMP data fit into the
+                old chunks. The ICC profile must be unchanged.
+          @return true if the image was updated in place;<BR>
+                  false if the file was not modified and must be rewritten.
+         */
+        bool writeMetadataInPlace();
         //! @name NOT Implemented
         //@{
         static long getHeaderOffset(const byte* data, long data_size, const byte* header, long header_size);
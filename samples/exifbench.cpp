@@ -0,0 +1,327 @@
+// ***************************************************************** -*- C++ -*-
+/*
+ * Copyright (C) 2004-2021 Exiv2 authors
+ * This program is part of the Exiv2 distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, 5th Floor, Boston, MA 02110-1301 USA.
+ */
+// exifbench.cpp
+// Benchmarks of Exif metadata access and encoding, e.g., on a raw file with a
+// large makernote
+
+#include <exiv2/exiv2.hpp>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using EasyAccessFct = Exiv2::ExifData::const_iterator (*)(const Exiv2::ExifData&);
+
+static const EasyAccessFct easyAccess[] = {
+    Exiv2::orientation,       Exiv2::isoSpeed,          Exiv2::dateTimeOriginal,
+    Exiv2::flashBias,         Exiv2::exposureMode,      Exiv2::sceneMode,
+    Exiv2::macroMode,         Exiv2::imageQuality,      Exiv2::whiteBalance,
+    Exiv2::lensName,          Exiv2::saturation,        Exiv2::sharpness,
+    Exiv2::contrast,          Exiv2::sceneCaptureType,  Exiv2::meteringMode,
+    Exiv2::make,              Exiv2::model,             Exiv2::exposureTime,
+    Exiv2::fNumber,           Exiv2::shutterSpeedValue, Exiv2::apertureValue,
+    Exiv2::brightnessValue,   Exiv2::exposureBiasValue, Exiv2::maxApertureValue,
+    Exiv2::subjectDistance,   Exiv2::lightSource,       Exiv2::flash,
+    Exiv2::serialNumber,      Exiv2::focalLength,       Exiv2::subjectArea,
+    Exiv2::flashEnergy,       Exiv2::exposureIndex,     Exiv2::sensingMethod,
+    Exiv2::afPoint
+};
+
+// Look up all the keys of the easy access functions
+static long easyAccessBench(const Exiv2::ExifData& ed)
+{
+    long found = 0;
+    for (auto&& fct : easyAccess) {
+        if (fct(ed) != ed.end()) ++found;
+    }
+    return found;
+}
+
+// Time the phases of decoding, iterating over and encoding the Exif data of a file
+static void roundTripBench(const char* path, int iterations)
+{
+    using Clock = std::chrono::steady_clock;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    const Exiv2::DataBuf file = Exiv2::readFile(path);
+    Micros decode(0), iterate(0), sort(0), encode(0);
+    long tags = 0;
+    long checksum = 0;
+    size_t blobSize = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto t0 = Clock::now();
+        auto image = Exiv2::ImageFactory::open(file.c_data(), file.size());
+        image->readMetadata();
+        Exiv2::ExifData& ed = image->exifData();
+
+        auto t1 = Clock::now();
+        for (auto&& md : ed) {
+            checksum += md.tag() + md.ifdId() + md.count();
+        }
+        tags = ed.count();
+
+        auto t2 = Clock::now();
+        ed.sortByKey();
+
+        auto t3 = Clock::now();
+        Exiv2::Blob blob;
+        Exiv2::ExifParser::encode(blob, Exiv2::littleEndian, ed);
+        blobSize = blob.size();
+
+        auto t4 = Clock::now();
+        decode += t1 - t0;
+        iterate += t2 - t1;
+        sort += t3 - t2;
+        encode += t4 - t3;
+    }
+    std::cout << tags << " tags, " << blobSize << " bytes encoded, us per iteration:"
+              << " decode " << decode.count() / iterations
+              << ", iterate " << iterate.count() / iterations
+              << ", sortByKey " << sort.count() / iterations
+              << ", encode " << encode.count() / iterations
+              << " (checksum " << checksum << ")\n";
+}
+
+// Time intrusive encoding of the Exif data of a file, which writes a new TIFF
+// structure including the makernote
+static void encodeBench(const char* path, int iterations)
+{
+    auto image = Exiv2::ImageFactory::open(path);
+    image->readMetadata();
+    const Exiv2::ExifData& ed = image->exifData();
+
+    size_t blobSize = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        Exiv2::Blob blob;
+        Exiv2::ExifParser::encode(blob, Exiv2::littleEndian, ed);
+        blobSize = blob.size();
+    }
+    const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << ed.count() << " tags, " << blobSize << " bytes encoded, "
+              << elapsed.count() / iterations << " us per iteration\n";
+}
+
+// Time reading all Exif data of a file and only what a thumbnailer needs
+static void thumbnailBench(const char* path, int iterations)
+{
+    using Clock = std::chrono::steady_clock;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    Exiv2::ExifFilter filter;
+    filter.addGroup("Thumbnail")
+          .addKey("Exif.Image.Orientation")
+          .addKey("Exif.Photo.DateTimeOriginal");
+
+    const Exiv2::DataBuf file = Exiv2::readFile(path);
+    Micros all(0), filtered(0);
+    long allTags = 0;
+    long filteredTags = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto t0 = Clock::now();
+        auto image = Exiv2::ImageFactory::open(file.c_data(), file.size());
+        image->readMetadata();
+        allTags = image->exifData().count();
+
+        auto t1 = Clock::now();
+        image = Exiv2::ImageFactory::open(file.c_data(), file.size());
+        image->setExifFilter(filter);
+        image->readMetadata();
+        filteredTags = image->exifData().count();
+
+        auto t2 = Clock::now();
+        all += t1 - t0;
+        filtered += t2 - t1;
+    }
+    std::cout << "us per iteration: all " << allTags << " tags " << all.count() / iterations
+              << ", thumbnailer " << filteredTags << " tags " << filtered.count() / iterations << "\n";
+}
+
+// Time reading a file with its makernote, deferring it without accessing it
+// and deferring it and then decoding it
+static void makernoteBench(const char* path, int iterations)
+{
+    using Clock = std::chrono::steady_clock;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    Exiv2::ExifFilter filter;
+    filter.deferMakernote();
+
+    const Exiv2::DataBuf file = Exiv2::readFile(path);
+    const Exiv2::ExifKey orientation("Exif.Image.Orientation");
+    Micros eager(0), deferred(0), decoded(0);
+    long tags = 0;
+    for (int i = 0; i < iterations; ++i) {
+        auto t0 = Clock::now();
+        auto image = Exiv2::ImageFactory::open(file.c_data(), file.size());
+        image->readMetadata();
+        image->exifData().findKey(orientation);
+
+        auto t1 = Clock::now();
+        image = Exiv2::ImageFactory::open(file.c_data(), file.size());
+        image->setExifFilter(filter);
+        image->readMetadata();
+        image->exifData().findKey(orientation);
+
+        auto t2 = Clock::now();
+        image = Exiv2::ImageFactory::open(file.c_data(), file.size());
+        image->setExifFilter(filter);
+        image->readMetadata();
+        tags = image->exifData().count();
+
+        auto t3 = Clock::now();
+        eager += t1 - t0;
+        deferred += t2 - t1;
+        decoded += t3 - t2;
+    }
+    std::cout << tags << " tags, us per iteration: makernote " << eager.count() / iterations
+              << ", deferred " << deferred.count() / iterations
+              << ", deferred and decoded " << decoded.count() / iterations << "\n";
+}
+
+// Time growing a tag of a copy of a TIFF file, writing the file anew and
+// appending the metadata to it
+static void appendBench(const char* path, int iterations)
+{
+    using Clock = std::chrono::steady_clock;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    const Exiv2::DataBuf file = Exiv2::readFile(path);
+    const std::string copy = std::string(path) + ".exifbench";
+    Micros times[2] = {Micros(0), Micros(0)};
+    Exiv2::WriteMethod writeMethods[2] = {Exiv2::wmIntrusive, Exiv2::wmIntrusive};
+    for (int i = 0; i < iterations; ++i) {
+        for (int append = 0; append < 2; ++append) {
+            Exiv2::writeFile(file, copy);
+            auto t0 = Clock::now();
+            auto image = Exiv2::ImageFactory::open(copy);
+            image->readMetadata();
+            image->exifData()["Exif.Image.ImageDescription"] = std::string(1000, 'x');
+            image->setAppendMetadata(append == 1);
+            image->writeMetadata();
+            times[append] += Clock::now() - t0;
+            writeMethods[append] = image->writeMethod();
+        }
+    }
+    std::remove(copy.c_str());
+    std::cout << "us per iteration: rewrite " << times[0].count() / iterations << " (write method "
+              << writeMethods[0] << "), append " << times[1].count() / iterations << " (write method "
+              << writeMethods[1] << ")\n";
+}
+
+// Time key creation for every tag of every group, by tag number and, once,
+// by tag name
+static void tagInfoBench(int iterations)
+{
+    using Clock = std::chrono::steady_clock;
+    using Micros = std::chrono::duration<double, std::micro>;
+
+    long tags = 0;
+    Micros byName(0), byNumber(0);
+    for (int i = 0; i < iterations; ++i) {
+        for (const Exiv2::GroupInfo* gi = Exiv2::ExifTags::groupList(); gi->tagList_ != nullptr; ++gi) {
+            const std::string groupName(gi->groupName_);
+            if (!Exiv2::ExifTags::isExifGroup(groupName) && !Exiv2::ExifTags::isMakerGroup(groupName)) continue;
+            const Exiv2::TagInfo* ti = gi->tagList_();
+            if (i == 0) {
+                // Parsed key strings are remembered, only the first pass looks up the names
+                auto t0 = Clock::now();
+                for (const Exiv2::TagInfo* t = ti; t->tag_ != 0xffff; ++t) {
+                    Exiv2::ExifKey key("Exif." + groupName + "." + t->name_);
+                    ++tags;
+                }
+                byName += Clock::now() - t0;
+            }
+            auto t0 = Clock::now();
+            for (const Exiv2::TagInfo* t = ti; t->tag_ != 0xffff; ++t) {
+                Exiv2::ExifKey key(t->tag_, groupName);
+            }
+            byNumber += Clock::now() - t0;
+        }
+    }
+    std::cout << tags << " tags, by name " << byName.count() << " us, by number "
+              << byNumber.count() / iterations << " us per iteration\n";
+}
+
+int main(int argc, char* const argv[])
+try {
+    Exiv2::XmpParser::initialize();
+    ::atexit(Exiv2::XmpParser::terminate);
+#ifdef EXV_ENABLE_BMFF
+    Exiv2::enableBMFF();
+#endif
+
+    if (argc >= 2 && std::strcmp(argv[1], "taginfo") == 0) {
+        tagInfoBench(argc == 3 ? std::atoi(argv[2]) : 100);
+        return 0;
+    }
+    if (   argc < 3 || argc > 4
+        || (   std::strcmp(argv[1], "easyaccess") != 0 && std::strcmp(argv[1], "roundtrip") != 0
+            && std::strcmp(argv[1], "encode") != 0 && std::strcmp(argv[1], "thumbnail") != 0
+            && std::strcmp(argv[1], "makernote") != 0 && std::strcmp(argv[1], "append") != 0)) {
+        std::cout << "Usage: " << argv[0] << " easyaccess|roundtrip|encode|thumbnail|makernote|append file [iterations]\n"
+                  << "       " << argv[0] << " taginfo [iterations]\n";
+        return 1;
+    }
+    const int iterations = argc == 4 ? std::atoi(argv[3]) : 100;
+    if (std::strcmp(argv[1], "roundtrip") == 0) {
+        roundTripBench(argv[2], iterations);
+        return 0;
+    }
+    if (std::strcmp(argv[1], "encode") == 0) {
+        encodeBench(argv[2], iterations);
+        return 0;
+    }
+    if (std::strcmp(argv[1], "thumbnail") == 0) {
+        thumbnailBench(argv[2], iterations);
+        return 0;
+    }
+    if (std::strcmp(argv[1], "makernote") == 0) {
+        makernoteBench(argv[2], iterations);
+        return 0;
+    }
+    if (std::strcmp(argv[1], "append") == 0) {
+        appendBench(argv[2], iterations);
+        return 0;
+    }
+
+    auto image = Exiv2::ImageFactory::open(argv[2]);
+    image->readMetadata();
+    const Exiv2::ExifData& ed = image->exifData();
+
+    long found = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        found = easyAccessBench(ed);
+    }
+    const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << ed.count() << " tags, " << found << " of " << EXV_COUNTOF(easyAccess)
+              << " easy access keys found, " << elapsed.count() / iterations << " us per iteration\n";
+    return 0;
+}
+catch (Exiv2::AnyError& e) {
+    std::cout << "Caught Exiv2 exception '" << e << "'\n";
+    return -1;
+}
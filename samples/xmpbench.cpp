@@ -0,0 +1,127 @@
+// ***************************************************************** -*- C++ -*-
+/*
+ * Copyright (C) 2004-2021 Exiv2 authors
+ * This program is part of the Exiv2 distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, 5th Floor, Boston, MA 02110-1301 USA.
+ */
+// xmpbench.cpp
+// Benchmark of decoding or encoding the XMP packet of a file with several threads at once
+
+#include <exiv2/exiv2.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Decode the packet iterations times and return the number of properties of the last decode
+static long decodeBench(const std::string& xmpPacket, int iterations, std::atomic<bool>& failed)
+{
+    long count = 0;
+    for (int i = 0; i < iterations; ++i) {
+        Exiv2::XmpData xmpData;
+        if (Exiv2::XmpParser::decode(xmpData, xmpPacket) != 0) {
+            failed = true;
+            return 0;
+        }
+        count = xmpData.count();
+    }
+    return count;
+}
+
+// Encode the metadata iterations times and return the size of the last packet
+static long encodeBench(const Exiv2::XmpData& xmpData, int iterations, std::atomic<bool>& failed)
+{
+    long size = 0;
+    for (int i = 0; i < iterations; ++i) {
+        std::string xmpPacket;
+        if (Exiv2::XmpParser::encode(xmpPacket, xmpData) != 0) {
+            failed = true;
+            return 0;
+        }
+        size = static_cast<long>(xmpPacket.size());
+    }
+    return size;
+}
+
+int main(int argc, char* const argv[])
+try {
+    Exiv2::XmpParser::initialize();
+    ::atexit(Exiv2::XmpParser::terminate);
+#ifdef EXV_ENABLE_BMFF
+    Exiv2::enableBMFF();
+#endif
+
+    const bool encode = argc >= 2 && std::strcmp(argv[1], "encode") == 0;
+    if (argc < 3 || argc > 5 || (!encode && std::strcmp(argv[1], "decode") != 0)) {
+        std::cout << "Usage: " << argv[0] << " decode|encode file [threads] [iterations]\n"
+                  << "Decode the XMP packet of file, or encode its XMP metadata, iterations times\n"
+                  << "in each of 1, 2, 4, ... threads\n";
+        return 1;
+    }
+    const int maxThreads = argc >= 4 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+    const int iterations = argc == 5 ? std::atoi(argv[4]) : 200;
+
+    auto image = Exiv2::ImageFactory::open(argv[2]);
+    image->readMetadata();
+    const std::string xmpPacket = image->xmpPacket();
+    if (xmpPacket.empty()) {
+        std::cout << argv[2] << ": No XMP packet found\n";
+        return 2;
+    }
+
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(std::max(maxThreads, 1));
+
+    double singleRate = 0;
+    for (int threads : threadCounts) {
+        std::atomic<bool> failed(false);
+        std::vector<std::thread> workers;
+        std::vector<long> counts(threads);
+        const auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < threads; ++t) {
+            workers.emplace_back([&, t] {
+                counts[t] = encode ? encodeBench(image->xmpData(), iterations, failed)
+                                   : decodeBench(xmpPacket, iterations, failed);
+            });
+        }
+        for (auto&& w : workers) {
+            w.join();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (failed) {
+            std::cout << (encode ? "Encoding" : "Decoding") << " failed with " << threads << " threads\n";
+            return 3;
+        }
+        const double rate = threads * iterations / elapsed.count();
+        if (threads == 1) singleRate = rate;
+        std::cout << threads << " threads: " << counts[0] << (encode ? " bytes, " : " properties, ") << static_cast<long>(rate)
+                  << " packets/s, speedup " << rate / singleRate << "\n";
+    }
+    return 0;
+}
+catch (Exiv2::AnyError& e) {
+    std::cout << "Caught Exiv2 exception '" << e << "'\n";
+    return -1;
+}
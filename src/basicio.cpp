@@ -32,12 +32,15 @@
 #include "http.hpp"
 #include "properties.hpp"
 #include "image_int.hpp"
+#include "remoteio_int.hpp"
 
 // + standard includes
 #include <fcntl.h>      // _O_BINARY in FileIo::FileIo
 #include <sys/stat.h>   // for stat, chmod
 #include <sys/types.h>  // for stat, chmod
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstdio>   // for remove, rename
 #include <cstdlib>  // for alloc, realloc, free
@@ -45,9 +48,16 @@
 #include <ctime>    // timestamp for the name of temporary file
 #include <filesystem>
 #include <fstream>  // write the temporary file
+#include <future>
 #include <iostream>
+#include <limits>
+#include <list>
 #include <memory>
+#include <random>
+#include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace fs = std::filesystem;
 
@@ -58,7 +68,14 @@ namespace fs = std::filesystem;
 # include <process.h>
 #endif
 #ifdef EXV_HAVE_UNISTD_H
-# include <unistd.h>                    // for getpid, stat
+# include <unistd.h>                    // for getpid, stat, copy_file_range
+#endif
+#ifdef EXV_HAVE_SENDFILE
+# include <sys/sendfile.h>              // for sendfile
+#endif
+#ifdef EXV_HAVE_WRITEV
+# include <sys/uio.h>                   // for writev
+# include <climits>                     // for IOV_MAX
 #endif
 
 #ifdef EXV_USE_CURL
@@ -84,6 +101,49 @@ namespace {
             pos += replace.length();
         }
     }
+
+    //! Size of the buffer used by BasicIo::copyFrom() if the data is not copied by the kernel
+    constexpr size_t copyBufferSize = 1024 * 1024;
+
+    //! Size of the read-ahead buffer of FileIo, see Exiv2::setReadBufferSize()
+    std::atomic<size_t> readBufferSize_{64 * 1024};
+
+    //! Size of the buffer used to write images, see Exiv2::setWriteBufferSize()
+    std::atomic<size_t> writeBufferSize_{16 * 1024 * 1024};
+
+    //! Maximum size of the blocks of a RemoteIo kept in memory, see Exiv2::setRemoteCacheSize()
+    std::atomic<size_t> remoteCacheSize_{64 * 1024 * 1024};
+
+    //! Maximum number of bytes RemoteIo reads ahead of a sequential read
+    constexpr size_t remoteReadAheadSize = 256 * 1024;
+
+    //! Maximum number of read-ahead requests RemoteIo sends to the server at the same time
+    constexpr size_t remoteReadAheadRequests = 4;
+
+    //! Return the file a path refers to. A symbolic link is resolved, so that it is not replaced by a rename.
+    std::string targetPath(const std::string& path)
+    {
+        std::error_code ec;
+        if (!fs::is_symlink(path, ec)) return path;
+        const fs::path target = fs::canonical(path, ec);
+        return ec ? path : target.string();
+    }
+
+    //! Temporary file created by FileIo::temporary(), removed unless it has been transferred.
+    class TemporaryFileIo : public Exiv2::FileIo {
+    public:
+        explicit TemporaryFileIo(const std::string& path) : FileIo(path) {}
+        ~TemporaryFileIo() override
+        {
+            close();
+            std::error_code ec;
+            fs::remove(path(), ec);
+        }
+        TemporaryFileIo(const TemporaryFileIo& rhs) = delete;
+        TemporaryFileIo& operator=(const TemporaryFileIo& rhs) = delete;
+
+        std::unique_ptr<char[]> buffer_;  //!< Stream buffer, must outlive the open file
+    };
 }
 
 namespace Exiv2 {
@@ -93,6 +153,61 @@ namespace Exiv2 {
         enforce(!error(), err);
     }
 
+    long BasicIo::readAt(int64_t offset, byte* buf, long rcount)
+    {
+        const long pos = tell();
+        if (pos < 0 || seek(offset, BasicIo::beg) != 0) return 0;
+        const long readCount = read(buf, rcount);
+        seek(pos, BasicIo::beg);
+        return readCount;
+    }
+
+    const byte* BasicIo::readView(long /*rcount*/) {
+        return nullptr;
+    }
+
+    const byte* BasicIo::readViewOrThrow(long rcount, DataBuf& buf, ErrorCode err) {
+        const byte* view = readView(rcount);
+        if (view) return view;
+        buf.alloc(rcount);
+        readOrThrow(buf.data(), rcount, err);
+        return buf.c_data();
+    }
+
+    BasicIo::UniquePtr BasicIo::temporary() const
+    {
+        return std::make_unique<MemIo>();
+    }
+
+    void BasicIo::copyFrom(BasicIo& src, int64_t offset, size_t rcount)
+    {
+        src.seekOrThrow(offset, BasicIo::beg, kerFailedToReadImageData);
+        if (rcount == 0) return;
+        enforce(rcount <= static_cast<size_t>(std::numeric_limits<long>::max()), kerFailedToReadImageData);
+
+        const byte* view = src.readView(static_cast<long>(rcount));
+        if (view) {
+            enforce(write(view, static_cast<long>(rcount)) == static_cast<long>(rcount), kerImageWriteFailed);
+            return;
+        }
+        DataBuf buf(static_cast<long>(std::min(rcount, copyBufferSize)));
+        while (rcount > 0) {
+            const long n = static_cast<long>(std::min(rcount, static_cast<size_t>(buf.size())));
+            src.readOrThrow(buf.data(), n, kerFailedToReadImageData);
+            enforce(write(buf.c_data(), n) == n, kerImageWriteFailed);
+            rcount -= n;
+        }
+    }
+
+    int BasicIo::seekToByte(byte value)
+    {
+        int c = EOF;
+        while ((c = getb()) != EOF) {
+            if (c == value) return seek(-1, BasicIo::cur);
+        }
+        return 1;
+    }
+
     void BasicIo::seekOrThrow(int64_t offset, Position pos, ErrorCode err) {
         const int r = seek(offset, pos);
         enforce(r == 0, err);
@@ -120,12 +235,18 @@ namespace Exiv2 {
         size_t mappedLength_;           //!< Size of the memory-mapped area
         bool   isMalloced_;             //!< Is the mapped area allocated?
         bool   isWriteable_;            //!< Can the mapped area be written to?
+        std::vector<byte> rbuf_;        //!< Read-ahead buffer
+        size_t rbufSize_;               //!< Size of the read-ahead buffer, 0 if reads are not buffered
+        size_t rpos_;                   //!< Position of the next byte to read in the read-ahead buffer
+        size_t rend_;                   //!< End of the data in the read-ahead buffer
+        bool   eof_;                    //!< EOF indicator, set when a read cannot be satisfied
         // TYPES
         //! Simple struct stat wrapper for internal use
         struct StructStat {
             StructStat() = default;
             mode_t st_mode{0};    //!< Permissions
             off_t st_size{0};     //!< Size
+            size_t st_nlink{1};   //!< Number of hard links
         };
 // #endif
         // METHODS
@@ -136,13 +257,83 @@ namespace Exiv2 {
           @return 0 if successful
          */
         int switchMode(OpMode opMode);
+        //! Refill the read-ahead buffer from the file, return the number of bytes read
+        size_t fillReadBuffer();
+        /*!
+          @brief Discard the read-ahead buffer and move the file stream back
+              to the position of the next unread byte.
+         */
+        void dropReadBuffer();
         //! stat wrapper for internal use
         int stat(StructStat& buf) const;
+        /*!
+          @brief Copy \em rcount bytes of file \em src, starting at \em offset,
+              to the current position in the kernel, if the system supports it.
+              The position of the file is advanced by the number of bytes copied,
+              the position of \em src is unspecified.
+          @return Number of bytes copied, which may be less than \em rcount
+         */
+        size_t copyFileRange(Impl& src, int64_t offset, size_t rcount);
+        /*!
+          @brief Write \em segments to the current position, with a single
+              system call if the system supports it.
+          @return Number of bytes written
+         */
+        size_t writeSegments(const std::vector<std::pair<const byte*, size_t>>& segments);
         // NOT IMPLEMENTED
         Impl(const Impl& rhs) = delete;             //!< Copy constructor
         Impl& operator=(const Impl& rhs) = delete;  //!< Assignment
     }; // class FileIo::Impl
 
+    //! Internal Pimpl structure of class MemIo.
+    class MemIo::Impl final{
+    public:
+        Impl() = default;                  //!< Default constructor
+        Impl(const byte* data, long size); //!< Constructor 2
+
+        //! A contiguous part of the memory area
+        using Segment = std::pair<const byte*, size_t>;
+
+        //! Size of the chunks appended to a memory area which has grown beyond it
+        static constexpr long chunkSize = 4 * 1024 * 1024;
+
+        // DATA
+        byte* data_{nullptr};     //!< Pointer to the start of the memory area
+        long idx_{0};             //!< Index into the memory area
+        long size_{0};            //!< Size of the memory area
+        long sizeAlloced_{0};     //!< Size of the allocated buffer
+        bool isMalloced_{false};  //!< Was the buffer allocated?
+        bool eof_{false};         //!< EOF indicator
+        //! Chunks of chunkSize bytes which follow the allocated buffer, see reserve()
+        std::vector<std::unique_ptr<byte[]>> chunks_;
+        bool lent_{false};        //!< Were views of the memory area lent out by readView()?
+        byte* retired_{nullptr};  //!< Buffer replaced by flatten() while views of it were lent out
+        //! Chunks moved by flatten() while views of them were lent out
+        std::vector<std::unique_ptr<byte[]>> retiredChunks_;
+
+        // METHODS
+        void reserve(long wcount);         //!< Reserve memory
+        /*!
+          @brief Return a pointer to position \em pos of the memory area and set
+              \em avail to the number of bytes which follow it contiguously.
+         */
+        byte* at(long pos, long& avail) const;
+        //! Copy \em rcount bytes from position \em pos to \em buf.
+        void get(long pos, byte* buf, long rcount) const;
+        //! Copy \em wcount bytes from \em data to position \em pos.
+        void put(long pos, const byte* data, long wcount);
+        //! Move the chunks into a single buffer, needed by mmap().
+        void flatten();
+        //! Free the storage kept by flatten() for the views lent out, called before a write.
+        void release();
+        //! Append the contiguous parts of the memory area from \em pos to the end to \em segments.
+        void segments(long pos, std::vector<Segment>& segments) const;
+
+        // NOT IMPLEMENTED
+        Impl(const Impl& rhs) = delete;             //!< Copy constructor
+        Impl& operator=(const Impl& rhs) = delete;  //!< Assignment
+    }; // class MemIo::Impl
+
     FileIo::Impl::Impl(std::string path)
         : path_(std::move(path)),
           fp_(nullptr),
@@ -154,7 +345,11 @@ namespace Exiv2 {
           pMappedArea_(nullptr),
           mappedLength_(0),
           isMalloced_(false),
-          isWriteable_(false)
+          isWriteable_(false),
+          rbufSize_(0),
+          rpos_(0),
+          rend_(0),
+          eof_(false)
     {
     }
 
@@ -162,6 +357,7 @@ namespace Exiv2 {
     {
         assert(fp_ != 0);
         if (opMode_ == opMode) return 0;
+        if (opMode_ == opRead) dropReadBuffer();
         OpMode oldOpMode = opMode_;
         opMode_ = opMode;
 
@@ -206,6 +402,24 @@ namespace Exiv2 {
         return std::fseek(fp_, offset, SEEK_SET);
     } // FileIo::Impl::switchMode
 
+    size_t FileIo::Impl::fillReadBuffer()
+    {
+        if (rbuf_.size() != rbufSize_) rbuf_.resize(rbufSize_);
+        rpos_ = 0;
+        rend_ = rbufSize_ > 0 ? std::fread(rbuf_.data(), 1, rbufSize_, fp_) : 0;
+        return rend_;
+    }
+
+    void FileIo::Impl::dropReadBuffer()
+    {
+        if (rpos_ < rend_) {
+            std::fseek(fp_, -static_cast<long>(rend_ - rpos_), SEEK_CUR);
+        }
+        rpos_ = 0;
+        rend_ = 0;
+        eof_ = false;
+    }
+
     int FileIo::Impl::stat(StructStat& buf) const
     {
         int ret = 0;
@@ -214,10 +428,89 @@ namespace Exiv2 {
         if (0 == ret) {
             buf.st_size = st.st_size;
             buf.st_mode = st.st_mode;
+            buf.st_nlink = st.st_nlink;
         }
         return ret;
     } // FileIo::Impl::stat
 
+    size_t FileIo::Impl::copyFileRange(Impl& src, int64_t offset, size_t rcount)
+    {
+        size_t copied = 0;
+#if defined(EXV_HAVE_COPY_FILE_RANGE) || defined(EXV_HAVE_SENDFILE)
+        if (&src == this || fp_ == nullptr || src.fp_ == nullptr || rcount == 0) return 0;
+        // Flush both streams so that the file descriptors are up to date
+        if (switchMode(opSeek) != 0 || src.switchMode(opSeek) != 0) return 0;
+        const int fdIn = ::fileno(src.fp_);
+        const int fdOut = ::fileno(fp_);
+        off_t offIn = static_cast<off_t>(offset);
+        off_t offOut = std::ftell(fp_);
+        if (offIn < 0 || offOut < 0) return 0;
+#ifdef EXV_HAVE_COPY_FILE_RANGE
+        while (copied < rcount) {
+            const ssize_t n = ::copy_file_range(fdIn, &offIn, fdOut, &offOut, rcount - copied, 0);
+            if (n <= 0) break;
+            copied += n;
+        }
+#endif
+#ifdef EXV_HAVE_SENDFILE
+        // Fallback for kernels without copy_file_range or for copies across file systems
+        if (copied < rcount && ::lseek(fdOut, offOut, SEEK_SET) == offOut) {
+            while (copied < rcount) {
+                const ssize_t n = ::sendfile(fdOut, fdIn, &offIn, rcount - copied);
+                if (n <= 0) break;
+                copied += n;
+                offOut += n;
+            }
+        }
+#endif
+        std::fseek(fp_, offOut, SEEK_SET);
+#else
+        (void)src;
+        (void)offset;
+        (void)rcount;
+#endif
+        return copied;
+    } // FileIo::Impl::copyFileRange
+
+    size_t FileIo::Impl::writeSegments(const std::vector<std::pair<const byte*, size_t>>& segments)
+    {
+        size_t written = 0;
+#ifdef EXV_HAVE_WRITEV
+        // Flush the stream so that the file descriptor is up to date
+        if (switchMode(opSeek) != 0) return 0;
+        const int fd = ::fileno(fp_);
+        const off_t offset = std::ftell(fp_);
+        if (offset < 0 || ::lseek(fd, offset, SEEK_SET) != offset) return 0;
+        std::vector<iovec> iov;
+        for (auto&& segment : segments) {
+            iov.push_back({const_cast<byte*>(segment.first), segment.second});
+        }
+        size_t next = 0;
+        while (next < iov.size()) {
+            const int count = static_cast<int>(std::min<size_t>(iov.size() - next, IOV_MAX));
+            ssize_t n = ::writev(fd, &iov[next], count);
+            if (n <= 0) break;
+            written += n;
+            // skip the segments written, a partial write continues within a segment
+            while (next < iov.size() && static_cast<size_t>(n) >= iov[next].iov_len) {
+                n -= iov[next++].iov_len;
+            }
+            if (n > 0) {
+                iov[next].iov_base = static_cast<byte*>(iov[next].iov_base) + n;
+                iov[next].iov_len -= n;
+            }
+        }
+        std::fseek(fp_, offset + static_cast<off_t>(written), SEEK_SET);
+#else
+        for (auto&& segment : segments) {
+            const size_t n = std::fwrite(segment.first, 1, segment.second, fp_);
+            written += n;
+            if (n != segment.second) break;
+        }
+#endif
+        return written;
+    } // FileIo::Impl::writeSegments
+
     FileIo::FileIo(const std::string& path)
         : p_(new Impl(path))
     {
@@ -350,9 +643,31 @@ namespace Exiv2 {
         if (!src.isopen()) return 0;
         if (p_->switchMode(Impl::opWrite) != 0) return 0;
 
+        long writeTotal = 0;
+        auto memIo = dynamic_cast<MemIo*>(&src);
+        if (memIo) {
+            // Write the memory area as it is, without copying it to a buffer first
+            const long pos = src.tell();
+            std::vector<MemIo::Impl::Segment> segments;
+            memIo->p_->segments(pos, segments);
+            writeTotal = static_cast<long>(p_->writeSegments(segments));
+            src.seek(pos + writeTotal, BasicIo::beg);
+            return writeTotal;
+        }
+        auto fileIo = dynamic_cast<FileIo*>(&src);
+        if (fileIo) {
+            const long pos = src.tell();
+            const size_t size = src.size();
+            if (pos >= 0 && size != static_cast<size_t>(-1) && size > static_cast<size_t>(pos)) {
+                const size_t copied = p_->copyFileRange(*fileIo->p_, pos, size - pos);
+                src.seek(pos + static_cast<int64_t>(copied), BasicIo::beg);
+                writeTotal += static_cast<long>(copied);
+                if (p_->switchMode(Impl::opWrite) != 0) return writeTotal;
+            }
+        }
+
         byte buf[4096];
         long readCount = 0;
-        long writeTotal = 0;
         while ((readCount = src.read(buf, sizeof(buf)))) {
             long writeCount = static_cast<long>(std::fwrite(buf, 1, readCount, p_->fp_));
             writeTotal += writeCount;
@@ -366,6 +681,17 @@ namespace Exiv2 {
         return writeTotal;
     }
 
+    void FileIo::copyFrom(BasicIo& src, int64_t offset, size_t rcount)
+    {
+        size_t copied = 0;
+        auto fileIo = dynamic_cast<FileIo*>(&src);
+        if (fileIo) {
+            copied = p_->copyFileRange(*fileIo->p_, offset, rcount);
+        }
+        // Copy whatever the kernel did not and position the source
+        BasicIo::copyFrom(src, offset + static_cast<int64_t>(copied), rcount - copied);
+    }
+
     void FileIo::transfer(BasicIo& src)
     {
         const bool wasOpen = (p_->fp_ != nullptr);
@@ -385,7 +711,8 @@ namespace Exiv2 {
 
             bool statOk = true;
             mode_t origStMode = 0;
-            auto pf = path().c_str();
+            const std::string target = targetPath(path());
+            auto pf = target.c_str();
 
             Impl::StructStat buf1;
             if (p_->stat(buf1) == -1) {
@@ -425,7 +752,7 @@ namespace Exiv2 {
                     }
                 }
 #else
-                if (fileExists(pf) && fs::remove(pf) != 0) {
+                if (fileExists(pf) && !fs::remove(pf)) {
                     throw Error(kerCallFailed, pf, strError(), "fs::remove");
                 }
                 fs::rename(fileIo->path().c_str(), pf);
@@ -502,7 +829,10 @@ namespace Exiv2 {
     long FileIo::tell() const
     {
         assert(p_->fp_ != 0);
-        return std::ftell(p_->fp_);
+        const long pos = std::ftell(p_->fp_);
+        if (pos == -1) return -1;
+        // The stream is ahead by the unread part of the read-ahead buffer
+        return pos - static_cast<long>(p_->rend_ - p_->rpos_);
     }
 
     size_t FileIo::size() const
@@ -534,6 +864,7 @@ namespace Exiv2 {
         close();
         p_->openMode_ = mode;
         p_->opMode_ = Impl::opSeek;
+        p_->rbufSize_ = readBufferSize();
         p_->fp_ = ::fopen(path().c_str(), mode.c_str());
         if (!p_->fp_)
             return 1;
@@ -553,6 +884,9 @@ namespace Exiv2 {
             if (std::fclose(p_->fp_) != 0) rc |= 1;
             p_->fp_ = nullptr;
         }
+        p_->rpos_ = 0;
+        p_->rend_ = 0;
+        p_->eof_ = false;
         return rc;
     }
 
@@ -576,14 +910,87 @@ namespace Exiv2 {
         if (p_->switchMode(Impl::opRead) != 0) {
             return 0;
         }
-        return static_cast<long>(std::fread(buf, 1, rcount, p_->fp_));
+        if (rcount <= 0) return 0;
+        const auto count = static_cast<size_t>(rcount);
+
+        size_t n = std::min(count, p_->rend_ - p_->rpos_);
+        if (n > 0) {
+            std::memcpy(buf, p_->rbuf_.data() + p_->rpos_, n);
+            p_->rpos_ += n;
+        }
+        if (n < count) {
+            if (count - n >= p_->rbufSize_) {
+                // Large reads bypass the read-ahead buffer
+                n += std::fread(buf + n, 1, count - n, p_->fp_);
+            }
+            else if (p_->fillReadBuffer() > 0) {
+                const size_t m = std::min(count - n, p_->rend_);
+                std::memcpy(buf + n, p_->rbuf_.data(), m);
+                p_->rpos_ = m;
+                n += m;
+            }
+            if (n < count && std::feof(p_->fp_)) p_->eof_ = true;
+        }
+        return static_cast<long>(n);
     }
 
     int FileIo::getb()
     {
         assert(p_->fp_ != 0);
+        if (p_->opMode_ == Impl::opRead && p_->rpos_ < p_->rend_) {
+            return p_->rbuf_[p_->rpos_++];
+        }
         if (p_->switchMode(Impl::opRead) != 0) return EOF;
-        return getc(p_->fp_);
+
+        int c = EOF;
+        if (p_->rbufSize_ == 0) {
+            c = getc(p_->fp_);
+        }
+        else if (p_->fillReadBuffer() > 0) {
+            c = p_->rbuf_[p_->rpos_++];
+        }
+        if (c == EOF && std::feof(p_->fp_)) p_->eof_ = true;
+        return c;
+    }
+
+    int FileIo::seekToByte(byte value)
+    {
+        assert(p_->fp_ != 0);
+        if (p_->rbufSize_ == 0) return BasicIo::seekToByte(value);
+        if (p_->switchMode(Impl::opRead) != 0) return 1;
+
+        while (p_->rpos_ < p_->rend_ || p_->fillReadBuffer() > 0) {
+            const byte* begin = p_->rbuf_.data() + p_->rpos_;
+            auto found = static_cast<const byte*>(std::memchr(begin, value, p_->rend_ - p_->rpos_));
+            if (found) {
+                p_->rpos_ += found - begin;
+                return 0;
+            }
+            p_->rpos_ = p_->rend_;
+        }
+        if (std::feof(p_->fp_)) p_->eof_ = true;
+        return 1;
+    }
+
+    long FileIo::readAt(int64_t offset, byte* buf, long rcount)
+    {
+        assert(p_->fp_ != 0);
+#ifdef EXV_HAVE_PREAD
+        // Data which is still in the stream buffer has not reached the file yet
+        if (p_->opMode_ != Impl::opWrite) {
+            if (offset < 0 || rcount <= 0) return 0;
+            const int fd = ::fileno(p_->fp_);
+            long readCount = 0;
+            while (readCount < rcount) {
+                const ssize_t n = ::pread(fd, buf + readCount, rcount - readCount,
+                                          static_cast<off_t>(offset + readCount));
+                if (n <= 0) break;
+                readCount += static_cast<long>(n);
+            }
+            return readCount;
+        }
+#endif
+        return BasicIo::readAt(offset, buf, rcount);
     }
 
     int FileIo::error() const
@@ -593,7 +1000,7 @@ namespace Exiv2 {
 
     bool FileIo::eof() const
     {
-        return std::feof(p_->fp_) != 0;
+        return p_->eof_;
     }
 
     const std::string& FileIo::path() const noexcept
@@ -601,110 +1008,260 @@ namespace Exiv2 {
         return p_->path_;
     }
 
+    BasicIo::UniquePtr FileIo::temporary() const
+    {
+        const size_t bufSize = writeBufferSize();
+        Impl::StructStat buf;
+        // Small files are written in memory. A rename would break hard links,
+        // so these files are always overwritten in place by transfer().
+        if (p_->stat(buf) != 0 || static_cast<size_t>(buf.st_size) <= bufSize || buf.st_nlink > 1) {
+            return std::make_unique<MemIo>();
+        }
+
+        // The temporary file is renamed to the file a symbolic link points to
+        std::random_device rd;
+        std::ostringstream os;
+        os << targetPath(path()) << "." << std::hex << rd() << rd() << ".exiv2_temp";
+        auto tmp = std::make_unique<TemporaryFileIo>(os.str());
+        if (tmp->open("w+b") != 0) {
+            return std::make_unique<MemIo>();
+        }
+        if (bufSize > 0) {
+            tmp->buffer_ = std::make_unique<char[]>(bufSize);
+            std::setvbuf(static_cast<FileIo&>(*tmp).p_->fp_, tmp->buffer_.get(), _IOFBF, bufSize);
+        }
+        return tmp;
+    }
+
     void FileIo::populateFakeData() {
 
     }
 
-    //! Internal Pimpl structure of class MemIo.
-    class MemIo::Impl final{
+    //! Internal Pimpl structure of class MmapIo.
+    class MmapIo::Impl final {
     public:
         Impl() = default;                  //!< Default constructor
-        Impl(const byte* data, long size); //!< Constructor 2
 
         // DATA
-        byte* data_{nullptr};     //!< Pointer to the start of the memory area
-        long idx_{0};             //!< Index into the memory area
-        long size_{0};            //!< Size of the memory area
-        long sizeAlloced_{0};     //!< Size of the allocated buffer
-        bool isMalloced_{false};  //!< Was the buffer allocated?
-        bool eof_{false};         //!< EOF indicator
-
-        // METHODS
-        void reserve(long wcount);         //!< Reserve memory
+        const byte* data_{nullptr};  //!< Read-only mapping of the file, nullptr if not mapped
+        size_t size_{0};             //!< Size of the mapping
+        size_t idx_{0};              //!< Index into the mapping
+        bool eof_{false};            //!< EOF indicator
 
         // NOT IMPLEMENTED
         Impl(const Impl& rhs) = delete;             //!< Copy constructor
         Impl& operator=(const Impl& rhs) = delete;  //!< Assignment
-    }; // class MemIo::Impl
+    }; // class MmapIo::Impl
 
-    MemIo::Impl::Impl(const byte* data, long size) : data_(const_cast<byte*>(data)), size_(size)
+    MmapIo::MmapIo(const std::string& path)
+        : FileIo(path), p_(new Impl())
     {
     }
 
-    /*!
-      @brief Utility class provides the block mapping to the part of data. This avoids allocating
-            a single contiguous block of memory to the big data.
-     */
-    class EXIV2API BlockMap {
-    public:
-        //! the status of the block.
-        enum    blockType_e {bNone, bKnown, bMemory};
-        //! @name Creators
-        //@{
-        //! Default constructor. the init status of the block is bNone.
-        BlockMap() = default;
-
-        //! Destructor. Releases all managed memory.
-        ~BlockMap()
-        {
-            delete [] data_;
+    MmapIo::~MmapIo()
+    {
+        close();
+    }
+
+    int MmapIo::open()
+    {
+        close();
+        if (FileIo::open("rb") != 0) return 1;
+        const size_t size = FileIo::size();
+        if (size == 0 || size == static_cast<size_t>(-1)) return 0;
+        try {
+            p_->data_ = FileIo::mmap(false);
+        }
+        catch (const Error&) {
+            // Keep reading through the FILE stream
+            return 0;
         }
+        p_->size_ = size;
+        return 0;
+    }
 
-        //! @brief Populate the block.
-        //! @param source The data populate to the block
-        //! @param num The size of data
-        void    populate (byte* source, size_t num)
-        {
-            assert(source != nullptr);
-            size_ = num;
-            data_ = new byte [size_];
-            type_ = bMemory;
-            std::memcpy(data_, source, size_);
+    int MmapIo::close()
+    {
+        p_->data_ = nullptr;
+        p_->size_ = 0;
+        p_->idx_ = 0;
+        p_->eof_ = false;
+        return FileIo::close();
+    }
+
+    long MmapIo::write(const byte* data, long wcount)
+    {
+        if (p_->data_) return 0;
+        return FileIo::write(data, wcount);
+    }
+
+    long MmapIo::write(BasicIo& src)
+    {
+        if (p_->data_) return 0;
+        return FileIo::write(src);
+    }
+
+    int MmapIo::putb(byte data)
+    {
+        if (p_->data_) return EOF;
+        return FileIo::putb(data);
+    }
+
+    DataBuf MmapIo::read(long rcount)
+    {
+        if (!p_->data_) return FileIo::read(rcount);
+        if (static_cast<size_t>(rcount) > p_->size_)
+            throw Error(kerInvalidMalloc);
+        DataBuf buf(rcount);
+        long readCount = read(buf.data(), buf.size());
+        buf.resize(readCount);
+        return buf;
+    }
+
+    long MmapIo::read(byte* buf, long rcount)
+    {
+        if (!p_->data_) return FileIo::read(buf, rcount);
+        const size_t avail = p_->idx_ < p_->size_ ? p_->size_ - p_->idx_ : 0;
+        const size_t allow = std::min(static_cast<size_t>(std::max(rcount, 0L)), avail);
+        if (allow > 0) {
+            std::memcpy(buf, p_->data_ + p_->idx_, allow);
+        }
+        p_->idx_ += allow;
+        if (allow < static_cast<size_t>(std::max(rcount, 0L))) {
+            p_->eof_ = true;
         }
+        return static_cast<long>(allow);
+    }
 
-        /*!
-          @brief Change the status to bKnow. bKnow blocks do not contain the data,
-                but they keep the size of data. This avoids allocating memory for parts
-                of the file that contain image-date (non-metadata/pixel data) which never change in exiv2.
-          @param num The size of the data
-         */
-        void    markKnown(size_t num)
-        {
-            type_ = bKnown;
-            size_ = num;
+    int MmapIo::getb()
+    {
+        if (!p_->data_) return FileIo::getb();
+        if (p_->idx_ >= p_->size_) {
+            p_->eof_ = true;
+            return EOF;
         }
+        return p_->data_[p_->idx_++];
+    }
 
-        bool    isNone() const
-        {
-            return type_ == bNone;
+    long MmapIo::readAt(int64_t offset, byte* buf, long rcount)
+    {
+        if (!p_->data_) return FileIo::readAt(offset, buf, rcount);
+        if (offset < 0 || rcount <= 0 || static_cast<uint64_t>(offset) >= p_->size_) return 0;
+        const size_t readCount = std::min(static_cast<size_t>(rcount), p_->size_ - static_cast<size_t>(offset));
+        std::memcpy(buf, p_->data_ + offset, readCount);
+        return static_cast<long>(readCount);
+    }
+
+    int MmapIo::seekToByte(byte value)
+    {
+        if (!p_->data_) return FileIo::seekToByte(value);
+        if (p_->idx_ < p_->size_) {
+            auto found = static_cast<const byte*>(std::memchr(p_->data_ + p_->idx_, value, p_->size_ - p_->idx_));
+            if (found) {
+                p_->idx_ = found - p_->data_;
+                return 0;
+            }
+            p_->idx_ = p_->size_;
         }
+        p_->eof_ = true;
+        return 1;
+    }
 
-        bool    isKnown () const
-        {
-            return type_ == bKnown;
+    const byte* MmapIo::readView(long rcount)
+    {
+        if (!p_->data_ || rcount < 0 || p_->idx_ > p_->size_
+            || static_cast<size_t>(rcount) > p_->size_ - p_->idx_) {
+            return nullptr;
         }
+        const byte* view = p_->data_ + p_->idx_;
+        p_->idx_ += rcount;
+        return view;
+    }
 
-        byte*   getData () const
-        {
-            return data_;
+    void MmapIo::transfer(BasicIo& src)
+    {
+        const bool wasMapped = p_->data_ != nullptr;
+        if (wasMapped) close();
+        FileIo::transfer(src);
+        if (wasMapped && open() != 0) {
+            throw Error(kerFileOpenFailed, path(), "rb", strError());
         }
+    }
 
-        size_t  getSize () const
-        {
-            return size_;
+    int MmapIo::seek(int64_t offset, Position pos)
+    {
+        if (!p_->data_) return FileIo::seek(offset, pos);
+
+        int64_t newIdx = 0;
+        switch (pos) {
+        case BasicIo::cur: newIdx = static_cast<int64_t>(p_->idx_) + offset; break;
+        case BasicIo::beg: newIdx = offset; break;
+        case BasicIo::end: newIdx = static_cast<int64_t>(p_->size_) + offset; break;
         }
+        // Like fseek, seeking beyond the end is allowed, seeking before the start is not
+        if (newIdx < 0) return 1;
+        p_->idx_ = static_cast<size_t>(newIdx);
+        p_->eof_ = false;
+        return 0;
+    }
 
-    private:
-        blockType_e type_{bNone};
-        byte* data_{nullptr};
-        size_t size_{0};
-    }; // class BlockMap
+    byte* MmapIo::mmap(bool isWriteable)
+    {
+        if (p_->data_ && !isWriteable) {
+            return const_cast<byte*>(p_->data_);
+        }
+        if (p_->data_) {
+            // Continue through the FILE stream at the current position
+            const size_t idx = p_->idx_;
+            p_->data_ = nullptr;
+            p_->size_ = 0;
+            p_->idx_ = 0;
+            p_->eof_ = false;
+            FileIo::seek(static_cast<int64_t>(idx), BasicIo::beg);
+        }
+        return FileIo::mmap(isWriteable);
+    }
+
+    int MmapIo::munmap()
+    {
+        if (p_->data_) return 0;
+        return FileIo::munmap();
+    }
+
+    long MmapIo::tell() const
+    {
+        if (!p_->data_) return FileIo::tell();
+        return static_cast<long>(p_->idx_);
+    }
+
+    size_t MmapIo::size() const
+    {
+        if (!p_->data_) return FileIo::size();
+        return p_->size_;
+    }
+
+    int MmapIo::error() const
+    {
+        if (!p_->data_) return FileIo::error();
+        return 0;
+    }
+
+    bool MmapIo::eof() const
+    {
+        if (!p_->data_) return FileIo::eof();
+        return p_->eof_;
+    }
+
+    MemIo::Impl::Impl(const byte* data, long size) : data_(const_cast<byte*>(data)), size_(size)
+    {
+    }
 
     void MemIo::Impl::reserve(long wcount)
     {
+        release();
         const long need = wcount + idx_;
         long    blockSize =     32*1024;   // 32768           `
-        const long maxBlockSize = 4*1024*1024;
+        const long maxBlockSize = chunkSize;
 
         if (!isMalloced_) {
             // Minimum size for 1st block
@@ -722,7 +1279,8 @@ namespace Exiv2 {
         }
 
         if (need > size_) {
-            if (need > sizeAlloced_) {
+            const long capacity = sizeAlloced_ + static_cast<long>(chunks_.size()) * chunkSize;
+            if (need > capacity && sizeAlloced_ < maxBlockSize && chunks_.empty()) {
                 blockSize = 2*sizeAlloced_ ;
                 if ( blockSize > maxBlockSize ) blockSize = maxBlockSize ;
                 // Allocate in blocks
@@ -732,11 +1290,102 @@ namespace Exiv2 {
                     throw Error(kerMallocFailed);
                 }
                 sizeAlloced_ = want;
+            } else if (need > capacity) {
+                // Append chunks rather than moving the whole memory area again
+                for (long n = (need - capacity + chunkSize - 1) / chunkSize; n > 0; n--) {
+                    chunks_.emplace_back(new byte[chunkSize]);
+                }
             }
             size_ = need;
         }
     }
 
+    byte* MemIo::Impl::at(long pos, long& avail) const
+    {
+        if (chunks_.empty() || pos < sizeAlloced_) {
+            avail = (isMalloced_ ? sizeAlloced_ : size_) - pos;
+            return data_ + pos;
+        }
+        const auto chunk = static_cast<size_t>((pos - sizeAlloced_) / chunkSize);
+        if (chunk >= chunks_.size()) { // the end of the last chunk
+            avail = 0;
+            return chunks_.back().get() + chunkSize;
+        }
+        const long offset = (pos - sizeAlloced_) % chunkSize;
+        avail = chunkSize - offset;
+        return chunks_[chunk].get() + offset;
+    }
+
+    void MemIo::Impl::get(long pos, byte* buf, long rcount) const
+    {
+        long avail = 0;
+        while (rcount > 0) {
+            const byte* data = at(pos, avail);
+            const long n = std::min(rcount, avail);
+            std::memcpy(buf, data, n);
+            buf += n;
+            pos += n;
+            rcount -= n;
+        }
+    }
+
+    void MemIo::Impl::put(long pos, const byte* data, long wcount)
+    {
+        long avail = 0;
+        while (wcount > 0) {
+            byte* dest = at(pos, avail);
+            const long n = std::min(wcount, avail);
+            std::memcpy(dest, data, n);
+            data += n;
+            pos += n;
+            wcount -= n;
+        }
+    }
+
+    void MemIo::Impl::flatten()
+    {
+        if (chunks_.empty()) return;
+        const long size = std::max(size_, sizeAlloced_);
+        // The views lent out by readView() remain valid until the next write,
+        // so their storage is kept rather than moved
+        auto data = static_cast<byte*>(lent_ ? std::malloc(size) : std::realloc(data_, size));
+        if (data == nullptr) {
+            throw Error(kerMallocFailed);
+        }
+        if (lent_) {
+            std::memcpy(data, data_, sizeAlloced_);
+            retired_ = data_;
+        }
+        for (long pos = sizeAlloced_, chunk = 0; pos < size_; pos += chunkSize, chunk++) {
+            std::memcpy(data + pos, chunks_[chunk].get(), std::min(chunkSize, size_ - pos));
+        }
+        data_ = data;
+        sizeAlloced_ = size;
+        if (lent_) {
+            retiredChunks_ = std::move(chunks_);
+        }
+        chunks_.clear();
+    }
+
+    void MemIo::Impl::release()
+    {
+        std::free(retired_);
+        retired_ = nullptr;
+        retiredChunks_.clear();
+        lent_ = false;
+    }
+
+    void MemIo::Impl::segments(long pos, std::vector<Segment>& segments) const
+    {
+        long avail = 0;
+        while (pos < size_) {
+            const byte* data = at(pos, avail);
+            const long n = std::min(avail, size_ - pos);
+            segments.emplace_back(data, static_cast<size_t>(n));
+            pos += n;
+        }
+    }
+
     MemIo::MemIo()
         : p_(new Impl())
     {
@@ -749,6 +1398,7 @@ namespace Exiv2 {
 
     MemIo::~MemIo()
     {
+        p_->release();
         if (p_->isMalloced_) {
             std::free(p_->data_);
         }
@@ -759,28 +1409,56 @@ namespace Exiv2 {
         p_->reserve(wcount);
         assert(p_->isMalloced_);
         if (data != nullptr) {
-            std::memcpy(&p_->data_[p_->idx_], data, wcount);
+            p_->put(p_->idx_, data, wcount);
         }
         p_->idx_ += wcount;
         return wcount;
     }
 
+    void MemIo::copyFrom(BasicIo& src, int64_t offset, size_t rcount)
+    {
+        if (static_cast<BasicIo*>(this) == &src) {
+            BasicIo::copyFrom(src, offset, rcount);
+            return;
+        }
+        src.seekOrThrow(offset, BasicIo::beg, kerFailedToReadImageData);
+        enforce(rcount <= static_cast<size_t>(std::numeric_limits<long>::max()), kerFailedToReadImageData);
+        const long count = static_cast<long>(rcount);
+        const long size = p_->size_;
+        p_->reserve(count);
+        long avail = 0;
+        for (long pos = p_->idx_; pos < p_->idx_ + count; pos += avail) {
+            byte* data = p_->at(pos, avail);
+            avail = std::min(avail, p_->idx_ + count - pos);
+            if (src.read(data, avail) != avail || src.error()) {
+                p_->size_ = size;
+                throw Error(kerFailedToReadImageData);
+            }
+        }
+        p_->idx_ += count;
+    }
+
     void MemIo::transfer(BasicIo& src)
     {
         auto memIo = dynamic_cast<MemIo*>(&src);
         if (memIo) {
             // Optimization if src is another instance of MemIo
+            p_->release();
             if (p_->isMalloced_) {
                 std::free(p_->data_);
             }
             p_->idx_ = 0;
             p_->data_ = memIo->p_->data_;
             p_->size_ = memIo->p_->size_;
+            p_->sizeAlloced_ = memIo->p_->sizeAlloced_;
             p_->isMalloced_ = memIo->p_->isMalloced_;
+            p_->chunks_ = std::move(memIo->p_->chunks_);
             memIo->p_->idx_ = 0;
             memIo->p_->data_ = nullptr;
             memIo->p_->size_ = 0;
+            memIo->p_->sizeAlloced_ = 0;
             memIo->p_->isMalloced_ = false;
+            memIo->p_->chunks_.clear();
         }
         else {
             // Generic reopen to reset position to start
@@ -814,7 +1492,8 @@ namespace Exiv2 {
     {
         p_->reserve(1);
         assert(p_->isMalloced_);
-        p_->data_[p_->idx_++] = data;
+        long avail = 0;
+        *p_->at(p_->idx_++, avail) = data;
         return data;
     }
 
@@ -843,6 +1522,7 @@ namespace Exiv2 {
 
     byte* MemIo::mmap(bool /*isWriteable*/)
     {
+        p_->flatten();
         return p_->data_;
     }
 
@@ -891,7 +1571,7 @@ namespace Exiv2 {
         const long avail = std::max(p_->size_ - p_->idx_, 0L);
         const long allow = std::min(rcount, avail);
         if (allow > 0) {
-            std::memcpy(buf, &p_->data_[p_->idx_], allow);
+            p_->get(p_->idx_, buf, allow);
         }
         p_->idx_ += allow;
         if (rcount > avail) {
@@ -906,7 +1586,49 @@ namespace Exiv2 {
             p_->eof_ = true;
             return EOF;
         }
-        return p_->data_[p_->idx_++];
+        long avail = 0;
+        return *p_->at(p_->idx_++, avail);
+    }
+
+    long MemIo::readAt(int64_t offset, byte* buf, long rcount)
+    {
+        if (offset < 0 || rcount <= 0 || offset >= p_->size_) return 0;
+        const long readCount = std::min(rcount, static_cast<long>(p_->size_ - offset));
+        p_->get(static_cast<long>(offset), buf, readCount);
+        return readCount;
+    }
+
+    int MemIo::seekToByte(byte value)
+    {
+        long avail = 0;
+        while (p_->idx_ < p_->size_) {
+            const byte* data = p_->at(p_->idx_, avail);
+            avail = std::min(avail, p_->size_ - p_->idx_);
+            auto found = static_cast<const byte*>(std::memchr(data, value, avail));
+            if (found) {
+                p_->idx_ += static_cast<long>(found - data);
+                return 0;
+            }
+            p_->idx_ += avail;
+        }
+        p_->eof_ = true;
+        return 1;
+    }
+
+    const byte* MemIo::readView(long rcount)
+    {
+        if (p_->data_ == nullptr || rcount < 0 || rcount > p_->size_ - p_->idx_) {
+            return nullptr;
+        }
+        // A view which spans chunks is not contiguous, the caller reads it instead
+        long avail = 0;
+        const byte* view = p_->at(p_->idx_, avail);
+        if (rcount > avail) {
+            return nullptr;
+        }
+        p_->lent_ = true;
+        p_->idx_ += rcount;
+        return view;
     }
 
     int MemIo::error() const
@@ -1060,64 +1782,6 @@ namespace Exiv2 {
 
 #endif
 
-    //! Internal Pimpl abstract structure of class RemoteIo.
-    class RemoteIo::Impl {
-    public:
-        //! Constructor
-        Impl(const std::string& url, size_t blockSize);
-        //! Destructor. Releases all managed memory.
-        virtual ~Impl();
-
-        // DATA
-        std::string     path_;          //!< (Standard) path
-        size_t          blockSize_;     //!< Size of the block memory.
-        BlockMap*       blocksMap_;     //!< An array contains all blocksMap
-        size_t          size_;          //!< The file size
-        long            idx_;           //!< Index into the memory area
-        bool            isMalloced_;    //!< Was the blocksMap_ allocated?
-        bool            eof_;           //!< EOF indicator
-        Protocol        protocol_;      //!< the protocol of url
-        uint32_t        totalRead_;     //!< bytes requested from host
-
-        // METHODS
-        /*!
-          @brief Get the length (in bytes) of the remote file.
-          @return Return -1 if the size is unknown. Otherwise it returns the length of remote file (in bytes).
-          @throw Error if the server returns the error code.
-         */
-        virtual long getFileLength() = 0;
-        /*!
-          @brief Get the data by range.
-          @param lowBlock The start block index.
-          @param highBlock The end block index.
-          @param response The data from the server.
-          @throw Error if the server returns the error code.
-          @note Set lowBlock = -1 and highBlock = -1 to get the whole file content.
-         */
-        virtual void getDataByRange(long lowBlock, long highBlock, std::string& response) = 0;
-        /*!
-          @brief Submit the data to the remote machine. The data replace a part of the remote file.
-                The replaced part of remote file is indicated by from and to parameters.
-          @param data The data are submitted to the remote machine.
-          @param size The size of data.
-          @param from The start position in the remote file where the data replace.
-          @param to The end position in the remote file where the data replace.
-          @note The write access is available on some protocols. HTTP and HTTPS require the script file
-                on the remote machine to handle the data. SSH requires the permission to edit the file.
-          @throw Error if it fails.
-         */
-        virtual void writeRemote(const byte* data, size_t size, long from, long to) = 0;
-        /*!
-          @brief Get the data from the remote machine and write them to the memory blocks.
-          @param lowBlock The start block index.
-          @param highBlock The end block index.
-          @return Number of bytes written to the memory block successfully
-          @throw Error if it fails.
-         */
-        virtual size_t populateBlocks(size_t lowBlock, size_t highBlock);
-
-    }; // class RemoteIo::Impl
-
     RemoteIo::Impl::Impl(const std::string& url, size_t blockSize)
         : path_(url),
           blockSize_(blockSize),
@@ -1127,14 +1791,88 @@ namespace Exiv2 {
           isMalloced_(false),
           eof_(false),
           protocol_(fileProtocol(url)),
-          totalRead_(0)
+          totalRead_(0),
+          cached_(0),
+          nextBlock_(0),
+          readAhead_(0)
     {
     }
 
+    void RemoteIo::Impl::getDataByRanges(const std::vector<std::pair<size_t, size_t>>& ranges,
+                                         std::vector<std::string>& responses)
+    {
+        responses.resize(ranges.size());
+        for (size_t i = 0; i < ranges.size(); i++) {
+            getDataByRange(static_cast<long>(ranges[i].first), static_cast<long>(ranges[i].second), responses[i]);
+        }
+    }
+
+    void RemoteIo::Impl::allocBlocks()
+    {
+        size_t nBlocks = (size_ + blockSize_ - 1) / blockSize_;
+        blocksMap_  = new BlockMap[nBlocks];
+        isMalloced_ = true;
+        lruPos_.assign(nBlocks, lru_.end());
+        evicted_.assign(nBlocks, false);
+    }
+
+    void RemoteIo::Impl::fillBlocks(size_t lowBlock, const std::string& data)
+    {
+        auto source = reinterpret_cast<const byte*>(data.data());
+        size_t remain = data.length(), totalRead = 0;
+        // A server which ignores the range returns the whole file
+        size_t iBlock = remain == size_ ? 0 : lowBlock;
+        size_t nBlocks = lruPos_.size();
+
+        while (remain && iBlock < nBlocks) {
+            size_t allow = std::min(remain, blockSize_);
+            if (blocksMap_[iBlock].isNone()) {
+                blocksMap_[iBlock].populate(&source[totalRead], allow);
+                evicted_[iBlock] = false;
+                lruPos_[iBlock] = lru_.insert(lru_.begin(), iBlock);
+                cached_ += allow;
+            }
+            remain -= allow;
+            totalRead += allow;
+            iBlock++;
+        }
+    }
+
+    void RemoteIo::Impl::touchBlock(size_t block)
+    {
+        auto pos = lruPos_[block];
+        if (pos != lru_.end() && pos != lru_.begin()) {
+            lru_.splice(lru_.begin(), lru_, pos);
+        }
+    }
+
+    void RemoteIo::Impl::evictBlocks(size_t lowBlock, size_t highBlock)
+    {
+        size_t limit = remoteCacheSize();
+        auto pos = lru_.end();
+        while (limit && cached_ > limit && pos != lru_.begin()) {
+            --pos;
+            size_t block = *pos;
+            if (block >= lowBlock && block <= highBlock)
+                continue;
+            pos = lru_.erase(pos);
+            lruPos_[block] = lru_.end();
+            cached_ -= blocksMap_[block].getSize();
+            blocksMap_[block].release();
+            evicted_[block] = true;
+        }
+    }
+
     size_t RemoteIo::Impl::populateBlocks(size_t lowBlock, size_t highBlock)
     {
         assert(isMalloced_);
 
+        const size_t firstBlock = lowBlock;
+        const size_t lastBlock  = highBlock;
+        for (size_t iBlock = lowBlock; iBlock <= highBlock; iBlock++) {
+            touchBlock(iBlock);
+        }
+
         // optimize: ignore all true blocks on left & right sides.
         while(!blocksMap_[lowBlock].isNone()  && lowBlock  < highBlock) lowBlock++;
         while(!blocksMap_[highBlock].isNone() && highBlock > lowBlock)  highBlock--;
@@ -1142,23 +1880,82 @@ namespace Exiv2 {
         size_t rcount = 0;
         if (blocksMap_[highBlock].isNone())
         {
-            std::string data;
-            getDataByRange(static_cast<long>(lowBlock), static_cast<long>(highBlock), data);
-            rcount = data.length();
-            if (rcount == 0) {
-                throw Error(kerErrorMessage, "Data By Range is empty. Please check the permission.");
+            // Read ahead while the file is read sequentially. The window doubles with each
+            // sequential miss and is dropped when the reader jumps elsewhere in the file.
+            size_t nBlocks  = lruPos_.size();
+            size_t maxAhead = std::max<size_t>(1, remoteReadAheadSize / blockSize_);
+            if (remoteCacheSize()) {
+                maxAhead = std::min(maxAhead, remoteCacheSize() / blockSize_ / 2);
             }
-            auto source = reinterpret_cast<byte*>(const_cast<char*>(data.c_str()));
-            size_t remain = rcount, totalRead = 0;
-            size_t iBlock = (rcount == size_) ? 0 : lowBlock;
+            readAhead_ = lowBlock == nextBlock_ ? std::min(std::max<size_t>(2 * readAhead_, 4), maxAhead) : 0;
 
-            while (remain) {
-                size_t allow = std::min(remain, blockSize_);
-                blocksMap_[iBlock].populate(&source[totalRead], allow);
-                remain -= allow;
-                totalRead += allow;
-                iBlock++;
+            size_t aheadHigh = highBlock;
+            while (aheadHigh + 1 < nBlocks && aheadHigh - highBlock < readAhead_ &&
+                   blocksMap_[aheadHigh + 1].isNone()) {
+                aheadHigh++;
+            }
+
+            // Split the read-ahead into several requests which are sent concurrently,
+            // or extend the requested range if the protocol cannot do that.
+            std::vector<std::pair<size_t, size_t>> ranges;
+            if (canFetchConcurrently()) {
+                size_t perRequest = (aheadHigh - highBlock + remoteReadAheadRequests - 1) / remoteReadAheadRequests;
+                for (size_t iBlock = highBlock + 1; iBlock <= aheadHigh; iBlock += perRequest) {
+                    ranges.emplace_back(iBlock, std::min(iBlock + perRequest - 1, aheadHigh));
+                }
+            } else {
+                highBlock = aheadHigh;
+            }
+            nextBlock_ = aheadHigh + 1;
+
+            std::vector<std::future<std::string>> readAhead;
+            for (auto&& range : ranges) {
+                readAhead.push_back(std::async(std::launch::async, [this, range] {
+                    std::string data;
+                    getDataByRange(static_cast<long>(range.first), static_cast<long>(range.second), data);
+                    return data;
+                }));
+            }
+
+            // blocks between lowBlock and highBlock which are in memory are not requested again
+            std::vector<std::pair<size_t, size_t>> missing;
+            for (size_t iBlock = lowBlock; iBlock <= highBlock; iBlock++) {
+                if (!blocksMap_[iBlock].isNone())
+                    continue;
+                if (missing.empty() || missing.back().second + 1 != iBlock)
+                    missing.emplace_back(iBlock, iBlock);
+                else
+                    missing.back().second = iBlock;
+            }
+
+            std::vector<std::string> data(1);
+            if (missing.size() == 1) {
+                getDataByRange(static_cast<long>(lowBlock), static_cast<long>(highBlock), data[0]);
+            } else {
+                getDataByRanges(missing, data);
+            }
+            for (auto&& d : data) {
+                if (d.empty()) {
+                    throw Error(kerErrorMessage, "Data By Range is empty. Please check the permission.");
+                }
+                rcount += d.length();
+            }
+
+            for (size_t i = 0; i < readAhead.size(); i++) {
+                try {
+                    fillBlocks(ranges[i].first, readAhead[i].get());
+                } catch (const Error&) {
+                    // the read-ahead is only a guess, the blocks are requested again when they are read
+                }
+            }
+            for (size_t i = 0; i < data.size(); i++) {
+                fillBlocks(missing[i].first, data[i]);
+            }
+            // The blocks which are read are evicted last
+            for (size_t iBlock = lastBlock + 1; iBlock-- > firstBlock;) {
+                touchBlock(iBlock);
             }
+            evictBlocks(firstBlock, lastBlock);
         }
 
         return rcount;
@@ -1186,25 +1983,14 @@ namespace Exiv2 {
                 std::string data;
                 p_->getDataByRange(-1, -1, data);
                 p_->size_ = data.length();
-                size_t nBlocks = (p_->size_ + p_->blockSize_ - 1) / p_->blockSize_;
-                p_->blocksMap_  = new BlockMap[nBlocks];
-                p_->isMalloced_ = true;
-                auto source = reinterpret_cast<byte*>(const_cast<char*>(data.c_str()));
-                size_t remain = p_->size_, iBlock = 0, totalRead = 0;
-                while (remain) {
-                    size_t allow = std::min(remain, p_->blockSize_);
-                    p_->blocksMap_[iBlock].populate(&source[totalRead], allow);
-                    remain -= allow;
-                    totalRead += allow;
-                    iBlock++;
-                }
+                p_->allocBlocks();
+                p_->fillBlocks(0, data);
+                p_->evictBlocks(0, 0);
             } else if (length == 0) { // file is empty
                 throw Error(kerErrorMessage, "the file length is 0");
             } else {
                 p_->size_ = static_cast<size_t>(length);
-                size_t nBlocks = (p_->size_ + p_->blockSize_ - 1) / p_->blockSize_;
-                p_->blocksMap_  = new BlockMap[nBlocks];
-                p_->isMalloced_ = true;
+                p_->allocBlocks();
             }
         }
         return 0; // means OK
@@ -1253,6 +2039,8 @@ namespace Exiv2 {
         src.seek(0, BasicIo::beg);
         bool findDiff = false;
         while (blockIndex < nBlocks && !src.eof() && !findDiff) {
+            if (p_->blocksMap_[blockIndex].isNone())
+                p_->populateBlocks(blockIndex, blockIndex);
             size_t blockSize = p_->blocksMap_[blockIndex].getSize();
             bool isFakeData = p_->blocksMap_[blockIndex].isKnown(); // fake data
             size_t readCount = static_cast<size_t>(src.read(buf.data(), static_cast<long>(blockSize)));
@@ -1272,6 +2060,8 @@ namespace Exiv2 {
         blockIndex  = nBlocks;
         while (blockIndex > 0 && right < src.size() && !findDiff) {
             blockIndex--;
+            if (p_->blocksMap_[blockIndex].isNone())
+                p_->populateBlocks(blockIndex, blockIndex);
             size_t blockSize = p_->blocksMap_[blockIndex].getSize();
             if(src.seek(-1 * (blockSize + right), BasicIo::end)) {
                 findDiff = true;
@@ -1410,9 +2200,12 @@ namespace Exiv2 {
             size_t blocks = (p_->size_ + blockSize -1)/blockSize ;
             bigBlock_   = new byte[blocks*blockSize] ;
             for ( size_t block = 0 ; block < blocks ; block ++ ) {
+                // blocks which have been evicted from the cache are read again
+                if ( p_->evicted_[block] )
+                    p_->populateBlocks(block, block);
                 void* p = p_->blocksMap_[block].getData();
                 if  ( p ) {
-                    size_t nRead = block==(blocks-1)?p_->size_-nRealData:blockSize;
+                    size_t nRead = p_->blocksMap_[block].getSize();
                     memcpy(bigBlock_+(block*blockSize),p,nRead);
                     nRealData   += nRead ;
                 }
@@ -1465,7 +2258,8 @@ namespace Exiv2 {
         assert(p_->isMalloced_);
         size_t nBlocks = (p_->size_ + p_->blockSize_ - 1) / p_->blockSize_;
         for (size_t i = 0; i < nBlocks; i++) {
-            if (p_->blocksMap_[i].isNone())
+            // evicted blocks hold data of the file, they are read again by write()
+            if (p_->blocksMap_[i].isNone() && !p_->evicted_[i])
                 p_->blocksMap_[i].markKnown(p_->blockSize_);
         }
     }
@@ -1508,27 +2302,51 @@ namespace Exiv2 {
           @throw Error if it fails.
          */
         void writeRemote(const byte* data, size_t size, long from, long to) override;
+        /*!
+          @brief Get the data of several ranges of blocks with a single multi-range request.
+          @param ranges The start and end block index of each range.
+          @param responses The data from the server for each range.
+          @throw Error if the server returns the error code.
+         */
+        void getDataByRanges(const std::vector<std::pair<size_t, size_t>>& ranges,
+                             std::vector<std::string>& responses) override;
+        //! http() takes a connection of its own for each concurrent request.
+        bool canFetchConcurrently() const override;
+        //! Fill in the server, page and port of a request for the file.
+        void initRequest(Exiv2::Dictionary& request) const;
 
         // NOT IMPLEMENTED
         HttpImpl(const HttpImpl& rhs) = delete;             //!< Copy constructor
         HttpImpl& operator=(const HttpImpl& rhs) = delete;  //!< Assignment
     }; // class HttpIo::HttpImpl
 
+    bool HttpIo::HttpImpl::canFetchConcurrently() const
+    {
+        return true;
+    }
+
     HttpIo::HttpImpl::HttpImpl(const std::string& url, size_t blockSize):Impl(url, blockSize)
     {
         hostInfo_ = Exiv2::Uri::Parse(url);
         Exiv2::Uri::Decode(hostInfo_);
     }
 
+    void HttpIo::HttpImpl::initRequest(Exiv2::Dictionary& request) const
+    {
+        request["server" ] = hostInfo_.Host;
+        request["page"   ] = hostInfo_.Path;
+        if (!hostInfo_.Port.empty())
+            request["port"] = hostInfo_.Port;
+        // keep the connection open for the requests of the following blocks
+        request["version"] = "1.1";
+    }
+
     long HttpIo::HttpImpl::getFileLength()
     {
         Exiv2::Dictionary response;
         Exiv2::Dictionary request;
         std::string errors;
-        request["server"] = hostInfo_.Host;
-        request["page"  ] = hostInfo_.Path;
-        if (!hostInfo_.Port.empty())
-            request["port"] = hostInfo_.Port;
+        initRequest(request);
         request["verb"]   = "HEAD";
         int serverCode = http(request, response, errors);
         if (serverCode < 0 || serverCode >= 400 || !errors.empty()) {
@@ -1543,10 +2361,7 @@ namespace Exiv2 {
     {
         Exiv2::Dictionary responseDic;
         Exiv2::Dictionary request;
-        request["server"] = hostInfo_.Host;
-        request["page"  ] = hostInfo_.Path;
-        if (!hostInfo_.Port.empty())
-            request["port"] = hostInfo_.Port;
+        initRequest(request);
         request["verb"]   = "GET";
         std::string errors;
         if (lowBlock > -1 && highBlock > -1) {
@@ -1562,6 +2377,31 @@ namespace Exiv2 {
         response = responseDic["body"];
     }
 
+    void HttpIo::HttpImpl::getDataByRanges(const std::vector<std::pair<size_t, size_t>>& ranges,
+                                           std::vector<std::string>& responses)
+    {
+        Exiv2::Dictionary request;
+        initRequest(request);
+        request["verb"]   = "GET";
+        std::vector<std::pair<uint64_t, uint64_t>> byteRanges;
+        for (auto&& range : ranges) {
+            byteRanges.emplace_back(range.first * blockSize_, (range.second + 1) * blockSize_ - 1);
+        }
+
+        std::string errors;
+        int serverCode = http(request, byteRanges, responses, errors);
+        if (serverCode < 0 || serverCode >= 400 || !errors.empty()) {
+            throw Error(kerFileOpenFailed, "http",Exiv2::Internal::stringFormat("%d",serverCode), hostInfo_.Path);
+        }
+
+        // some servers answer a multi-range request with the first range only
+        for (size_t i = 0; i < ranges.size(); i++) {
+            if (responses[i].empty()) {
+                getDataByRange(static_cast<long>(ranges[i].first), static_cast<long>(ranges[i].second), responses[i]);
+            }
+        }
+    }
+
     void HttpIo::HttpImpl::writeRemote(const byte* data, size_t size, long from, long to)
     {
         std::string scriptPath(getEnv(envHTTPPOST));
@@ -1859,6 +2699,36 @@ namespace Exiv2 {
         return file.write(buf.c_data(), buf.size());
     }
 
+    size_t setWriteBufferSize(size_t size)
+    {
+        return writeBufferSize_.exchange(size);
+    }
+
+    size_t writeBufferSize()
+    {
+        return writeBufferSize_.load();
+    }
+
+    size_t setReadBufferSize(size_t size)
+    {
+        return readBufferSize_.exchange(size);
+    }
+
+    size_t readBufferSize()
+    {
+        return readBufferSize_.load();
+    }
+
+    size_t setRemoteCacheSize(size_t size)
+    {
+        return remoteCacheSize_.exchange(size);
+    }
+
+    size_t remoteCacheSize()
+    {
+        return remoteCacheSize_.load();
+    }
+
 
 #ifdef EXV_USE_CURL
     size_t curlWriter(char* data, size_t size, size_t nmemb,
@@ -537,7 +537,7 @@ namespace Exiv2
             if ( punt != eof ) {
                 Internal::TiffParserWorker::decode(exifData(), iptcData(), xmpData(),
                   exif.c_data(punt), exif.size()-punt, root_tag,
-                  Internal::TiffMapping::findDecoder);
+                  Internal::TiffMapping::findDecoder, nullptr, &exifFilter_);
             }
         }
         io_->seek(restore,BasicIo::beg);
@@ -558,7 +558,7 @@ namespace Exiv2
 
             Internal::TiffParserWorker::decode(exifData(), iptcData(), xmpData(),
                                                data.c_data(), data.size(), root_tag,
-                                               Internal::TiffMapping::findDecoder);
+                                               Internal::TiffMapping::findDecoder, nullptr, &exifFilter_);
         }
     }
 
@@ -652,6 +652,7 @@ namespace Exiv2
         IoCloser closer(*io_);
 
         clearMetadata();
+        exifFiltered_ = !exifFilter_.empty();
         ilocs_.clear();
         visits_max_ = io_->size() / 16;
         unknownID_ = 0xffff;
@@ -2764,7 +2764,7 @@ namespace Exiv2 {
 
         // regex to extract short and tele focal length, max aperture at short and tele position
         // and the teleconverter factor from the lens label
-        std::regex const lens_regex(
+        static std::regex const lens_regex(
             // anything at the start
             ".*?"
             // maybe min focal length and hyphen, surely max focal length e.g.: 24-70mm
@@ -2782,10 +2782,9 @@ namespace Exiv2 {
         bool unmatched = true;
         // we loop over all our lenses to print out all matching lenses
         // if we have multiple possibilities, they are concatenated by "*OR*"
-        for (auto const& lens : canonCsLensType) {
-            if (lens.val_ != lensType) {
-                continue;
-            }
+        auto const lenses = findTagDetailsRange<EXV_COUNTOF(canonCsLensType), canonCsLensType>(lensType);
+        for (auto l = lenses.first; l != lenses.second; ++l) {
+            auto const& lens = **l;
 
             std::cmatch base_match;
             if (!std::regex_search(lens.label_, base_match, lens_regex)) {
@@ -102,8 +102,10 @@ namespace Exiv2 {
             throw Error(kerNotAnImage, "CR2");
         }
         clearMetadata();
+        exifFiltered_ = !exifFilter_.empty();
         ByteOrder bo =
-            Cr2Parser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), static_cast<uint32_t>(io_->size()));
+            Cr2Parser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), static_cast<uint32_t>(io_->size()),
+                              &exifFilter_);
         setByteOrder(bo);
     } // Cr2Image::readMetadata
 
@@ -112,6 +114,7 @@ namespace Exiv2 {
 #ifdef EXIV2_DEBUG_MESSAGES
         std::cerr << "Writing CR2 file " << io_->path() << "\n";
 #endif
+        enforceExifUnfiltered();
         ByteOrder bo = byteOrder();
         byte* pData = nullptr;
         long size = 0;
@@ -131,15 +134,16 @@ namespace Exiv2 {
             bo = littleEndian;
         }
         setByteOrder(bo);
-        Cr2Parser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_); // may throw
+        writeMethod_ = Cr2Parser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_); // may throw
     } // Cr2Image::writeMetadata
 
     ByteOrder Cr2Parser::decode(
-              ExifData& exifData,
-              IptcData& iptcData,
-              XmpData&  xmpData,
-        const byte*     pData,
-              uint32_t  size
+              ExifData&   exifData,
+              IptcData&   iptcData,
+              XmpData&    xmpData,
+        const byte*       pData,
+              uint32_t    size,
+        const ExifFilter* pFilter
     )
     {
         Cr2Header cr2Header;
@@ -150,7 +154,8 @@ namespace Exiv2 {
                                         size,
                                         Tag::root,
                                         TiffMapping::findDecoder,
-                                        &cr2Header);
+                                        &cr2Header,
+                                        pFilter);
     }
 
     WriteMethod Cr2Parser::encode(
@@ -24,6 +24,11 @@
 // included header files
 #include "easyaccess.hpp"
 
+// + standard includes
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
 // *****************************************************************************
 namespace {
 
@@ -49,6 +54,41 @@ namespace {
         return ed.end();
     } // findMetadatum
 
+    //! Exif keys resolved once to their tag and IFD id, in the order given
+    class ExifKeyList {
+    public:
+        //! Constructor, resolves the \em keys
+        ExifKeyList(std::initializer_list<const char*> keys)
+        {
+            keys_.reserve(keys.size());
+            for (auto&& k : keys) {
+                ExifKey key(k);
+                keys_.emplace_back(key.tag(), key.ifdId());
+            }
+        }
+        //! Begin of the resolved keys
+        std::vector<std::pair<uint16_t, int> >::const_iterator begin() const { return keys_.begin(); }
+        //! End of the resolved keys
+        std::vector<std::pair<uint16_t, int> >::const_iterator end() const { return keys_.end(); }
+
+    private:
+        std::vector<std::pair<uint16_t, int> > keys_;
+
+    }; // class ExifKeyList
+
+    /*!
+      @brief Search \em ed for a Metadatum specified by the \em keys, like
+             findMetadatum() above but without parsing the keys again.
+     */
+    ExifData::const_iterator findMetadatum(const ExifData& ed, const ExifKeyList& keys)
+    {
+        for (auto&& key : keys) {
+            auto pos = ed.findKey(key.first, key.second);
+            if (pos != ed.end()) return pos;
+        }
+        return ed.end();
+    } // findMetadatum
+
 } // anonymous namespace
 
 // *****************************************************************************
@@ -57,7 +97,7 @@ namespace Exiv2 {
 
     ExifData::const_iterator orientation(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Image.Orientation",
             "Exif.Panasonic.Rotation",
             "Exif.MinoltaCs5D.Rotation",
@@ -70,7 +110,7 @@ namespace Exiv2 {
             "Exif.Sony2Cs2.Rotation",
             "Exif.Sony1MltCsA100.Rotation"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator isoSpeed(const ExifData& ed)
@@ -185,16 +225,16 @@ namespace Exiv2 {
 
     ExifData::const_iterator dateTimeOriginal(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.DateTimeOriginal",
             "Exif.Image.DateTimeOriginal"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator flashBias(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.CanonSi.FlashBias",
             "Exif.Panasonic.FlashBias",
             "Exif.Olympus.FlashBias",
@@ -204,12 +244,12 @@ namespace Exiv2 {
             "Exif.Sony1.FlashExposureComp",
             "Exif.Sony2.FlashExposureComp"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator exposureMode(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.ExposureProgram",
             "Exif.Image.ExposureProgram",
             "Exif.CanonCs.ExposureProgram",
@@ -222,12 +262,12 @@ namespace Exiv2 {
             "Exif.Sony2Cs.ExposureProgram",
             "Exif.Sigma.ExposureMode"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator sceneMode(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.CanonCs.EasyMode",
             "Exif.Fujifilm.PictureMode",
             "Exif.MinoltaCsNew.SubjectProgram",
@@ -243,12 +283,12 @@ namespace Exiv2 {
             "Exif.PentaxDng.PictureMode",
             "Exif.Photo.SceneCaptureType"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator macroMode(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.CanonCs.Macro",
             "Exif.Fujifilm.Macro",
             "Exif.Olympus.Macro",
@@ -259,12 +299,12 @@ namespace Exiv2 {
             "Exif.Sony1.Macro",
             "Exif.Sony2.Macro"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator imageQuality(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.CanonCs.Quality",
             "Exif.Fujifilm.Quality",
             "Exif.Sigma.Quality",
@@ -290,12 +330,12 @@ namespace Exiv2 {
             "Exif.Casio2.QualityMode",
             "Exif.Casio2.Quality"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator whiteBalance(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.CanonSi.WhiteBalance",
             "Exif.Fujifilm.WhiteBalance",
             "Exif.Sigma.WhiteBalance",
@@ -321,12 +361,12 @@ namespace Exiv2 {
             "Exif.Casio2.WhiteBalance2",
             "Exif.Photo.WhiteBalance"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator lensName(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             // Exif.Canon.LensModel only reports focal length.
             // Try Exif.CanonCs.LensType first.
             "Exif.CanonCs.LensType",
@@ -344,12 +384,12 @@ namespace Exiv2 {
             "Exif.Panasonic.LensType",
             "Exif.Samsung2.LensType"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator saturation(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.Saturation",
             "Exif.CanonCs.Saturation",
             "Exif.MinoltaCsNew.Saturation",
@@ -366,12 +406,12 @@ namespace Exiv2 {
             "Exif.Casio2.Saturation",
             "Exif.Casio2.Saturation2"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator sharpness(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.Sharpness",
             "Exif.CanonCs.Sharpness",
             "Exif.Fujifilm.Sharpness",
@@ -388,12 +428,12 @@ namespace Exiv2 {
             "Exif.Casio2.Sharpness",
             "Exif.Casio2.Sharpness2"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator contrast(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.Contrast",
             "Exif.CanonCs.Contrast",
             "Exif.Fujifilm.Tone",
@@ -411,113 +451,113 @@ namespace Exiv2 {
             "Exif.Casio2.Contrast2"
 
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator sceneCaptureType(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.SceneCaptureType",
             "Exif.Olympus.SpecialMode"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator meteringMode(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.MeteringMode",
             "Exif.Image.MeteringMode",
             "Exif.CanonCs.MeteringMode",
             "Exif.Sony1MltCsA100.MeteringMode"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator make(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Image.Make"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator model(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Image.Model"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator exposureTime(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.ExposureTime",
             "Exif.Image.ExposureTime",
             "Exif.Samsung2.ExposureTime"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator fNumber(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.FNumber",
             "Exif.Image.FNumber",
             "Exif.Samsung2.FNumber"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator shutterSpeedValue(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.ShutterSpeedValue",
             "Exif.Image.ShutterSpeedValue"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator apertureValue(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.ApertureValue",
             "Exif.Image.ApertureValue"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator brightnessValue(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.BrightnessValue",
             "Exif.Image.BrightnessValue"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator exposureBiasValue(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.ExposureBiasValue",
             "Exif.Image.ExposureBiasValue"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator maxApertureValue(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.MaxApertureValue",
             "Exif.Image.MaxApertureValue"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator subjectDistance(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.SubjectDistance",
             "Exif.Image.SubjectDistance",
             "Exif.CanonSi.SubjectDistance",
@@ -533,30 +573,30 @@ namespace Exiv2 {
             "Exif.Casio.ObjectDistance",
             "Exif.Casio2.ObjectDistance"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator lightSource(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.LightSource",
             "Exif.Image.LightSource"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator flash(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.Flash",
             "Exif.Image.Flash"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator serialNumber(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Image.CameraSerialNumber",
             "Exif.Canon.SerialNumber",
             "Exif.Nikon3.SerialNumber",
@@ -565,12 +605,12 @@ namespace Exiv2 {
             "Exif.Olympus.SerialNumber2",
             "Exif.Sigma.SerialNumber"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator focalLength(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.FocalLength",
             "Exif.Image.FocalLength",
             "Exif.Canon.FocalLength",
@@ -581,48 +621,48 @@ namespace Exiv2 {
             "Exif.PentaxDng.FocalLength",
             "Exif.Casio2.FocalLength"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator subjectArea(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.SubjectArea",
             "Exif.Image.SubjectLocation"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator flashEnergy(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.FlashEnergy",
             "Exif.Image.FlashEnergy"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator exposureIndex(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.ExposureIndex",
             "Exif.Image.ExposureIndex"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator sensingMethod(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.Photo.SensingMethod",
             "Exif.Image.SensingMethod"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
     ExifData::const_iterator afPoint(const ExifData& ed)
     {
-        static const char* keys[] = {
+        static const ExifKeyList keys = {
             "Exif.CanonPi.AFPointsUsed",
             "Exif.CanonPi.AFPointsUsed20D",
             "Exif.CanonSi.AFPointUsed",
@@ -646,7 +686,7 @@ namespace Exiv2 {
             "Exif.Casio.AFPoint",
             "Exif.Casio2.AFPointPosition"
         };
-        return findMetadatum(ed, keys, EXV_COUNTOF(keys));
+        return findMetadatum(ed, keys);
     }
 
 }                                       // namespace Exiv2
@@ -801,7 +801,8 @@ namespace {
             }
 
             // create temporary output file
-            MemIo tempIo;
+            auto tempIoPtr = io.temporary();
+            BasicIo& tempIo = *tempIoPtr;
             if (!tempIo.isopen()) {
                 #ifndef SUPPRESS_WARNINGS
                 EXV_WARNING << "Unable to create temporary file for writing.\n";
@@ -809,7 +810,7 @@ namespace {
                 throw Error(kerImageWriteFailed);
             }
             #ifdef DEBUG
-            EXV_DEBUG << "readWriteEpsMetadata: Created temporary file " << tempIo->path() << "\n";
+            EXV_DEBUG << "readWriteEpsMetadata: Created temporary file " << tempIo.path() << "\n";
             #endif
 
             // sort all positions
@@ -41,8 +41,10 @@
 
 // + standard includes
 #include <iostream>
+#include <iterator>
 #include <sstream>
 #include <utility>
+#include <vector>
 #include <algorithm>
 #include <cstring>
 #include <cassert>
@@ -51,26 +53,54 @@
 // *****************************************************************************
 namespace {
 
-    //! Unary predicate that matches a Exifdatum with a given key
-    class FindExifdatumByKey {
+    //! Unary predicate that matches a Exifdatum with a given tag and IFD
+    class FindExifdatumByTag {
     public:
-        //! Constructor, initializes the object with the key to look for
-        explicit FindExifdatumByKey(const std::string& key) : key_(key)
+        //! Constructor, initializes the object with the tag and IFD to look for
+        FindExifdatumByTag(uint16_t tag, int ifdId) : tag_(tag), ifdId_(ifdId)
         {
         }
         /*!
-          @brief Returns true if the key of \em exifdatum is equal
-                 to that of the object.
+          @brief Returns true if the tag and IFD of \em exifdatum are equal
+                 to those of the object.
         */
         bool operator()(const Exiv2::Exifdatum& exifdatum) const
         {
-            return key_ == exifdatum.key();
+            return tag_ == exifdatum.tag() && ifdId_ == exifdatum.ifdId();
         }
 
     private:
-        const std::string& key_;
+        uint16_t tag_;
+        int ifdId_;
 
-    }; // class FindExifdatumByKey
+    }; // class FindExifdatumByTag
+
+    /*!
+      @brief Sort \em metadata stably by the value that \em sortKey returns
+             for each element. The values are computed once and sorted in a
+             contiguous array, then the list nodes are relinked in that order.
+     */
+    template <typename SortKey>
+    void sortMetadata(Exiv2::ExifMetadata& metadata, SortKey sortKey)
+    {
+        using Entry = std::pair<decltype(sortKey(metadata.front())), Exiv2::ExifMetadata::iterator>;
+        std::vector<Entry> entries;
+        entries.reserve(metadata.size());
+        for (auto i = metadata.begin(); i != metadata.end(); ++i) {
+            entries.emplace_back(sortKey(*i), i);
+        }
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const Entry& lhs, const Entry& rhs) { return lhs.first < rhs.first; });
+        for (auto&& entry : entries) {
+            metadata.splice(metadata.end(), metadata, entry.second);
+        }
+    }
+
+    //! Return the key of the ExifData index for a tag in an IFD
+    uint32_t indexKey(uint16_t tag, int ifdId)
+    {
+        return static_cast<uint32_t>(ifdId) << 16 | tag;
+    }
 
     /*!
       @brief Exif %Thumbnail image. This abstract base class provides the
@@ -188,13 +218,13 @@ namespace Exiv2 {
     }
 
     Exifdatum::Exifdatum(const ExifKey& key, const Value* pValue)
-        : key_(key.clone())
+        : key_(key.clone()), tag_(key.tag()), ifdId_(key.ifdId()), idx_(key.idx())
     {
         if (pValue) value_ = pValue->clone();
     }
 
     Exifdatum::Exifdatum(const Exifdatum& rhs)
-        : Metadatum(rhs)
+        : Metadatum(rhs), tag_(rhs.tag_), ifdId_(rhs.ifdId_), idx_(rhs.idx_)
     {
         if (rhs.key_.get() != nullptr)
             key_ = rhs.key_->clone();  // deep copy
@@ -247,9 +277,16 @@ namespace Exiv2 {
         if (this == &rhs) return *this;
         Metadatum::operator=(rhs);
 
+        // Tell the ExifData which holds this datum that its index is stale
+        if (keyChanges_ != nullptr && (tag_ != rhs.tag_ || ifdId_ != rhs.ifdId_)) {
+            ++*keyChanges_;
+        }
         key_.reset();
         if (rhs.key_.get() != nullptr)
             key_ = rhs.key_->clone();  // deep copy
+        tag_ = rhs.tag_;
+        ifdId_ = rhs.ifdId_;
+        idx_ = rhs.idx_;
 
         value_.reset();
         if (rhs.value_.get() != nullptr)
@@ -347,22 +384,22 @@ namespace Exiv2 {
 
     uint16_t Exifdatum::tag() const
     {
-        return key_.get() == nullptr ? 0xffff : key_->tag();
+        return tag_;
     }
 
     int Exifdatum::ifdId() const
     {
-        return key_.get() == nullptr ? ifdIdNotSet : key_->ifdId();
+        return ifdId_;
     }
 
     const char* Exifdatum::ifdName() const
     {
-        return key_.get() == nullptr ? "" : Internal::ifdName(static_cast<Internal::IfdId>(key_->ifdId()));
+        return key_.get() == nullptr ? "" : Internal::ifdName(static_cast<Internal::IfdId>(ifdId_));
     }
 
     int Exifdatum::idx() const
     {
-        return key_.get() == nullptr ? 0 : key_->idx();
+        return idx_;
     }
 
     long Exifdatum::copy(byte* buf, ByteOrder byteOrder) const
@@ -528,12 +565,66 @@ namespace Exiv2 {
         eraseIfd(exifData_, ifd1Id);
     }
 
+    ExifData::ExifData()
+        : indexBuilt_(true), keyChanges_(std::make_unique<uint64_t>(0)), indexedKeyChanges_(0)
+    {
+    }
+
+    ExifData::ExifData(const ExifData& rhs)
+        : exifMetadata_(rhs.exifMetadata_), indexBuilt_(false), keyChanges_(std::make_unique<uint64_t>(0)),
+          indexedKeyChanges_(0), makernoteDecoder_(rhs.makernoteDecoder_)
+    {
+        adopt(exifMetadata_.begin(), exifMetadata_.end());
+    }
+
+    ExifData::ExifData(ExifData&& rhs) noexcept
+        : exifMetadata_(std::move(rhs.exifMetadata_)),
+          index_(std::move(rhs.index_)),
+          indexBuilt_(rhs.indexBuilt_),
+          keyChanges_(std::move(rhs.keyChanges_)),
+          indexedKeyChanges_(rhs.indexedKeyChanges_),
+          makernoteDecoder_(std::move(rhs.makernoteDecoder_))
+    {
+        rhs.index_.clear();
+        rhs.indexBuilt_ = false;
+        rhs.makernoteDecoder_ = nullptr;
+    }
+
+    ExifData& ExifData::operator=(const ExifData& rhs)
+    {
+        if (this == &rhs) return *this;
+        exifMetadata_ = rhs.exifMetadata_;
+        adopt(exifMetadata_.begin(), exifMetadata_.end());
+        index_.clear();
+        indexBuilt_ = false;
+        makernoteDecoder_ = rhs.makernoteDecoder_;
+        return *this;
+    }
+
+    ExifData& ExifData::operator=(ExifData&& rhs) noexcept
+    {
+        if (this == &rhs) return *this;
+        // Iterators to the elements of a moved list remain valid
+        exifMetadata_ = std::move(rhs.exifMetadata_);
+        index_ = std::move(rhs.index_);
+        indexBuilt_ = rhs.indexBuilt_;
+        keyChanges_ = std::move(rhs.keyChanges_);
+        indexedKeyChanges_ = rhs.indexedKeyChanges_;
+        makernoteDecoder_ = std::move(rhs.makernoteDecoder_);
+        rhs.index_.clear();
+        rhs.indexBuilt_ = false;
+        rhs.makernoteDecoder_ = nullptr;
+        return *this;
+    }
+
     Exifdatum& ExifData::operator[](const std::string& key)
     {
         ExifKey exifKey(key);
         auto pos = findKey(exifKey);
         if (pos == end()) {
             exifMetadata_.emplace_back(exifKey);
+            adopt(std::prev(exifMetadata_.end()), exifMetadata_.end());
+            indexBack();
             return exifMetadata_.back();
         }
         return *pos;
@@ -546,51 +637,251 @@ namespace Exiv2 {
 
     void ExifData::add(const Exifdatum& exifdatum)
     {
+        decodeMakernote(exifdatum.ifdId());
         // allow duplicates
         exifMetadata_.push_back(exifdatum);
+        adopt(std::prev(exifMetadata_.end()), exifMetadata_.end());
+        indexBack();
     }
 
     ExifData::const_iterator ExifData::findKey(const ExifKey& key) const
     {
-        return std::find_if(exifMetadata_.begin(), exifMetadata_.end(),
-                            FindExifdatumByKey(key.key()));
+        return findKey(key.tag(), key.ifdId());
     }
 
     ExifData::iterator ExifData::findKey(const ExifKey& key)
     {
+        return findKey(key.tag(), key.ifdId());
+    }
+
+    ExifData::const_iterator ExifData::findKey(uint16_t tag, int ifdId) const
+    {
+        decodeMakernote(ifdId);
+        if (indexValid()) {
+            return find(tag, ifdId);
+        }
         return std::find_if(exifMetadata_.begin(), exifMetadata_.end(),
-                            FindExifdatumByKey(key.key()));
+                            FindExifdatumByTag(tag, ifdId));
+    }
+
+    ExifData::iterator ExifData::findKey(uint16_t tag, int ifdId)
+    {
+        decodeMakernote(ifdId);
+        updateIndex();
+        const_iterator pos = find(tag, ifdId);
+        // Convert to a non-const iterator in constant time
+        return exifMetadata_.erase(pos, pos);
     }
 
     void ExifData::clear()
     {
         exifMetadata_.clear();
+        index_.clear();
+        indexBuilt_ = true;
+        indexedKeyChanges_ = keyChanges_ ? *keyChanges_ : 0;
+        makernoteDecoder_ = nullptr;
+    }
+
+    void ExifData::setMakernoteDecoder(MakernoteDecoder decoder)
+    {
+        decodeMakernote();
+        makernoteDecoder_ = std::move(decoder);
     }
 
     void ExifData::sortByKey()
     {
-        exifMetadata_.sort(cmpMetadataByKey);
+        decodeMakernote();
+        sortMetadata(exifMetadata_, [](const Exifdatum& md) { return md.key(); });
+        indexBuilt_ = false;
     }
 
     void ExifData::sortByTag()
     {
-        exifMetadata_.sort(cmpMetadataByTag);
+        decodeMakernote();
+        sortMetadata(exifMetadata_, [](const Exifdatum& md) { return md.tag(); });
+        indexBuilt_ = false;
     }
 
     ExifData::iterator ExifData::erase(ExifData::iterator beg, ExifData::iterator end)
     {
+        if (indexValid()) {
+            for (auto i = beg; i != end; ++i) {
+                unindex(i);
+            }
+        }
         return exifMetadata_.erase(beg, end);
     }
 
     ExifData::iterator ExifData::erase(ExifData::iterator pos)
     {
+        if (indexValid()) {
+            unindex(pos);
+        }
         return exifMetadata_.erase(pos);
     }
 
+    void ExifData::indexBack()
+    {
+        if (!indexValid()) return;
+        const Exifdatum& md = exifMetadata_.back();
+        auto entry = index_.emplace(indexKey(md.tag(), md.ifdId()), IndexEntry(std::prev(exifMetadata_.cend()), 0));
+        ++entry.first->second.second;
+    }
+
+    void ExifData::unindex(const_iterator pos)
+    {
+        auto entry = index_.find(indexKey(pos->tag(), pos->ifdId()));
+        if (entry == index_.end()) {
+            indexBuilt_ = false;
+            return;
+        }
+        if (--entry->second.second == 0) {
+            index_.erase(entry);
+        }
+        else if (entry->second.first == pos) {
+            // Make the next element with the same key the first one
+            entry->second.first = std::find_if(std::next(pos), exifMetadata_.cend(),
+                                               FindExifdatumByTag(pos->tag(), pos->ifdId()));
+        }
+    }
+
+    void ExifData::updateIndex()
+    {
+        if (indexValid()) return;
+        indexedKeyChanges_ = keyChanges_ ? *keyChanges_ : 0;
+        index_.clear();
+        index_.reserve(exifMetadata_.size());
+        for (auto i = exifMetadata_.cbegin(); i != exifMetadata_.cend(); ++i) {
+            auto entry = index_.emplace(indexKey(i->tag(), i->ifdId()), IndexEntry(i, 0));
+            ++entry.first->second.second;
+        }
+        indexBuilt_ = true;
+    }
+
+    void ExifData::adopt(iterator first, iterator last) const
+    {
+        if (!keyChanges_) {
+            keyChanges_ = std::make_unique<uint64_t>(0);
+            indexBuilt_ = false;
+        }
+        for (auto i = first; i != last; ++i) {
+            i->keyChanges_ = keyChanges_.get();
+        }
+    }
+
+    bool ExifData::indexValid() const
+    {
+        return indexBuilt_ && (!keyChanges_ || *keyChanges_ == indexedKeyChanges_);
+    }
+
+    ExifData::const_iterator ExifData::find(uint16_t tag, int ifdId) const
+    {
+        auto entry = index_.find(indexKey(tag, ifdId));
+        return entry == index_.end() ? exifMetadata_.end() : entry->second.first;
+    }
+
+    void ExifData::decodeMakernote(int ifdId) const
+    {
+        if (makernoteDecoder_ && (ifdId == mnId || isMakerIfd(static_cast<IfdId>(ifdId)))) {
+            insertMakernote();
+        }
+    }
+
+    void ExifData::insertMakernote() const
+    {
+        // Reset the decoder first, so that it runs only once, even if it throws
+        const MakernoteDecoder decoder = std::move(makernoteDecoder_);
+        makernoteDecoder_ = nullptr;
+        ExifData makernote;
+        try {
+            decoder(makernote);
+        }
+        catch (const Error& e) {
+            // Keep what was decoded, a corrupt makernote doesn't make the other metadata unusable
+#ifndef SUPPRESS_WARNINGS
+            EXV_WARNING << "Failed to decode the makernote: " << e.what() << "\n";
+#endif
+        }
+        if (makernote.exifMetadata_.empty()) return;
+        // Insert the makernote where decoding it right away would have put it
+        auto raw = std::find_if(exifMetadata_.rbegin(), exifMetadata_.rend(), [](const Exifdatum& md) {
+            return md.tag() == 0x927c && md.ifdId() == exifId;
+        });
+        if (raw == exifMetadata_.rend()) {
+            // A DNG can hold the makernote in its DNGPrivateData tag instead
+            raw = std::find_if(exifMetadata_.rbegin(), exifMetadata_.rend(), [](const Exifdatum& md) {
+                return md.tag() == 0xc634 && md.ifdId() == ifd0Id;
+            });
+        }
+        const auto pos = raw == exifMetadata_.rend() ? exifMetadata_.end() : raw.base();
+        const auto first = makernote.exifMetadata_.cbegin();
+        exifMetadata_.splice(pos, makernote.exifMetadata_);
+        adopt(exifMetadata_.erase(first, first), pos);
+        if (!indexValid()) return;
+        for (auto i = first; i != pos; ++i) {
+            if (index_.find(indexKey(i->tag(), i->ifdId())) != index_.end()) {
+                // The key is already there, find out which is first when the index is rebuilt
+                indexBuilt_ = false;
+                return;
+            }
+        }
+        for (auto i = first; i != pos; ++i) {
+            auto entry = index_.emplace(indexKey(i->tag(), i->ifdId()), IndexEntry(i, 0));
+            ++entry.first->second.second;
+        }
+    }
+
+    ExifFilter& ExifFilter::addGroup(const std::string& groupName)
+    {
+        const IfdId ifdId = groupId(groupName);
+        if (ifdId == ifdIdNotSet) throw Error(kerInvalidIfdId, groupName);
+        groups_.insert(ifdId);
+        return *this;
+    }
+
+    ExifFilter& ExifFilter::addKey(const std::string& key)
+    {
+        const ExifKey exifKey(key);
+        tags_.emplace(exifKey.ifdId(), exifKey.tag());
+        tagGroups_.insert(exifKey.ifdId());
+        return *this;
+    }
+
+    bool ExifFilter::empty() const
+    {
+        return groups_.empty() && tags_.empty();
+    }
+
+    bool ExifFilter::selects(uint16_t tag, int ifdId) const
+    {
+        return    empty()
+               || groups_.find(ifdId) != groups_.end()
+               || tags_.find(std::make_pair(ifdId, tag)) != tags_.end();
+    }
+
+    ExifFilter& ExifFilter::deferMakernote(bool defer)
+    {
+        deferMakernote_ = defer;
+        return *this;
+    }
+
+    bool ExifFilter::defersMakernote() const
+    {
+        return deferMakernote_;
+    }
+
+    bool ExifFilter::selectsGroup(int ifdId) const
+    {
+        return    empty()
+               || groups_.find(ifdId) != groups_.end()
+               || tagGroups_.find(ifdId) != tagGroups_.end();
+    }
+
     ByteOrder ExifParser::decode(
-              ExifData& exifData,
-        const byte*     pData,
-              uint32_t  size
+              ExifData&   exifData,
+        const byte*       pData,
+              uint32_t    size,
+        const ExifFilter* pFilter
     )
     {
         IptcData iptcData;
@@ -599,7 +890,8 @@ namespace Exiv2 {
                                           iptcData,
                                           xmpData,
                                           pData,
-                                          size);
+                                          size,
+                                          pFilter);
 #ifndef SUPPRESS_WARNINGS
         if (!iptcData.empty()) {
             EXV_WARNING << "Ignoring IPTC information encoded in the Exif data.\n";
@@ -900,10 +1192,12 @@ namespace {
 
     void eraseIfd(Exiv2::ExifData& ed, Exiv2::IfdId ifdId)
     {
-        ed.erase(std::remove_if(ed.begin(),
-                                ed.end(),
-                                Exiv2::FindExifdatum(ifdId)),
-                 ed.end());
+        // Erase in place rather than with std::remove_if, which would copy
+        // the remaining elements and invalidate the index of the ExifData
+        Exiv2::FindExifdatum inIfd(ifdId);
+        for (auto md = ed.begin(); md != ed.end();) {
+            md = inIfd(*md) ? ed.erase(md) : std::next(md);
+        }
     }
     //! @endcond
 }  // namespace
@@ -21,24 +21,28 @@
 #if defined(_MSC_VER) || defined(__CYGWIN__) || defined(__MINGW__) || defined(__MINGW64__) || defined(__MINGW32__) 
 #define __USE_W32_SOCKETS
 #include <winsock2.h>
+#include <ws2tcpip.h>
 #endif
 
 #include "config.h"
 #include "datasets.hpp"
 #include "http.hpp"
 #include "futils.hpp"
+#include "http_int.hpp"
 
 #include <sys/types.h>
 #include <stdio.h>
+#include <algorithm>
 #include <array>
+#include <cctype>
 #include <cstdlib>
+#include <map>
+#include <mutex>
+#include <sstream>
 #include <time.h>
 #include <sys/stat.h>
 #include <string.h>
 
-#define SLEEP       1000
-#define SNOOZE         0
-
 #ifdef  __MINGW__
 #define  fopen_S(f,n,a)  f=fopen(n,a)
 #endif
@@ -73,6 +77,7 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <netdb.h>
+#include <sys/select.h>
 
 #define fopen_S(f,n,o) f=fopen(n,o)
 #define WINAPI
@@ -87,28 +92,11 @@ static int WSAGetLastError()
     return errno ;
 }
 
-static void Sleep(int millisecs)
-{
-    const struct timespec rqtp = { 0 , millisecs*1000000 } ;
-    struct timespec   rmtp ;
-    nanosleep(&rqtp,&rmtp);
-}
-
 #endif
 
 ////////////////////////////////////////
 // code
-static constexpr auto httpTemplate =
-    "%s %s HTTP/%s\r\n"  // $verb $page $version
-    "User-Agent: exiv2http/1.0.0\r\n"
-    "Accept: */*\r\n"
-    "Host: %s\r\n"  // $servername
-    "%s"            // $header
-    "\r\n";
 
-#define white(c) ((c == ' ') || (c == '\t'))
-
-#define FINISH          -999
 #define OK(s)    (200 <= s  && s < 300)
 
 static constexpr std::array<const char*, 2> blankLines{
@@ -116,20 +104,23 @@ static constexpr std::array<const char*, 2> blankLines{
     "\n\n",      // this is commonly sent by CGI scripts
 };
 
-static constexpr int snooze = SNOOZE;
-static int sleep_ = SLEEP;
+static constexpr int    timeout    = 30;        // seconds to wait for the server
+static constexpr size_t poolSize   = 8;         // idle connections kept open for HTTP/1.1 requests
+static constexpr size_t headerSize = 32 * 1024; // give up searching for headers after this
 
-static int forgive(int n,int& err)
-{
-    err  = WSAGetLastError() ;
-    if ( !n && !err ) return FINISH ;
-#ifndef WIN32
-    if ( n == 0 ) return FINISH ; // server hungup
+#ifdef MSG_NOSIGNAL
+static constexpr int sendFlags = MSG_NOSIGNAL; // a connection closed by the server must not raise SIGPIPE
+#else
+static constexpr int sendFlags = 0;
 #endif
-    bool bForgive = err == WSAEWOULDBLOCK || err == WSAENOTCONN ;
-    bool bError   = n == SOCKET_ERROR ;
-    if ( bError && bForgive ) return 0 ;
-    return n ;
+
+// idle HTTP/1.1 connections by "server:port"
+static std::mutex                      poolMutex;
+static std::multimap<std::string, int> pool;
+
+static bool wouldBlock(int err)
+{
+    return err == WSAEWOULDBLOCK || err == WSAENOTCONN || err == EAGAIN;
 }
 
 static int error(std::string& errors, const char* msg, const char* x = nullptr, const char* y = nullptr, int z = 0)
@@ -143,16 +134,10 @@ static int error(std::string& errors, const char* msg, const char* x = nullptr,
     } else {
         fprintf(stderr, "%s\n", buffer);
     }
-    errors += std::string(msg) + '\n';
+    errors += std::string(buffer) + '\n';
     return -1;
 }
 
-static void flushBuffer(const char* buffer,size_t start,int& end,std::string& file)
-{
-    file += std::string(buffer+start,end-start) ;
-    end = 0 ;
-}
-
 static Exiv2::Dictionary stringToDict(const std::string& s)
 {
     Exiv2::Dictionary result;
@@ -185,6 +170,125 @@ static int makeNonBlocking(int sockfd)
 #endif
 }
 
+// wait until the socket can be read (or written), false on timeout or error
+static bool waitFor(int sockfd, bool write)
+{
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(sockfd, &fds);
+    struct timeval tv = { timeout, 0 };
+    return select(sockfd + 1, write ? nullptr : &fds, write ? &fds : nullptr, nullptr, &tv) > 0;
+}
+
+// header names are case-insensitive
+// value of the response header name (given in lower case) without leading blanks
+static std::string responseHeader(const Exiv2::Dictionary& response, const char* name)
+{
+    for (auto&& h : response) {
+        if (Exiv2::Internal::lower(h.first) == name) {
+            size_t start = h.second.find_first_not_of(" \t");
+            return start == std::string::npos ? "" : h.second.substr(start);
+        }
+    }
+    return "";
+}
+
+// take an idle connection to key from the pool, -1 if there is none
+static int takeConnection(const std::string& key)
+{
+    std::lock_guard<std::mutex> lock(poolMutex);
+    auto it = pool.find(key);
+    while (it != pool.end() && it->first == key) {
+        int sockfd = it->second;
+        it = pool.erase(it);
+        // an idle connection has nothing to read, otherwise the server has closed it
+        char c;
+        if (recv(sockfd, &c, 1, MSG_PEEK) == SOCKET_ERROR && wouldBlock(WSAGetLastError()))
+            return sockfd;
+        closesocket(sockfd);
+    }
+    return -1;
+}
+
+static void returnConnection(const std::string& key, int sockfd)
+{
+    std::lock_guard<std::mutex> lock(poolMutex);
+    if (pool.size() < poolSize) {
+        pool.emplace(key, sockfd);
+    } else {
+        closesocket(sockfd);
+    }
+}
+
+static int connectTo(const char* servername, const char* port, std::string& errors)
+{
+    int sockfd = static_cast<int>(socket(AF_INET , SOCK_STREAM,IPPROTO_TCP));
+    if (sockfd < 0)
+        return error(errors, "unable to create socket\n", nullptr, nullptr, 0);
+
+    // fill in the address
+    struct  sockaddr_in serv_addr   ;
+    int                 serv_len = sizeof(serv_addr);
+    memset(reinterpret_cast<char*>(&serv_addr), 0, serv_len);
+
+    serv_addr.sin_addr.s_addr   = inet_addr(servername);
+    serv_addr.sin_family        = AF_INET    ;
+    serv_addr.sin_port          = htons(atoi(port));
+
+    // convert unknown servername into IP address
+    // getaddrinfo() is used rather than gethostbyname() as it is thread-safe
+    if (serv_addr.sin_addr.s_addr == static_cast<unsigned long>(INADDR_NONE)) {
+        struct addrinfo  hints;
+        struct addrinfo* host = nullptr;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family   = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        if (getaddrinfo(servername, nullptr, &hints, &host) != 0 || !host) {
+            closesocket(sockfd);
+            return error(errors, "no such host", servername);
+        }
+        serv_addr.sin_addr = reinterpret_cast<struct sockaddr_in*>(host->ai_addr)->sin_addr;
+        freeaddrinfo(host);
+    }
+
+    makeNonBlocking(sockfd) ;
+
+    ////////////////////////////////////
+    // and connect
+    int server = connect(sockfd, reinterpret_cast<const struct sockaddr*>(&serv_addr), serv_len);
+    if ( server == SOCKET_ERROR && WSAGetLastError() != WSAEWOULDBLOCK ) {
+        closesocket(sockfd);
+        return error(errors, "error - unable to connect to server = %s port = %s wsa_error = %d", servername, port,
+                     WSAGetLastError());
+    }
+
+    // we have to wait for the connection by the non-blocking socket
+    int       err     = 0;
+    socklen_t err_len = sizeof(err);
+    if ( !waitFor(sockfd, true) ||
+         getsockopt(sockfd, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&err), &err_len) != 0 || err ) {
+        closesocket(sockfd);
+        return error(errors, "error - timeout connecting to server = %s port = %s wsa_error = %d", servername, port,
+                     err ? err : WSAGetLastError());
+    }
+    return sockfd;
+}
+
+static bool sendAll(int sockfd, const std::string& data)
+{
+    size_t sent = 0;
+    while ( sent < data.size() ) {
+        int n = send(sockfd, data.data() + sent, static_cast<int>(data.size() - sent), sendFlags);
+        if ( n == SOCKET_ERROR ) {
+            if ( !wouldBlock(WSAGetLastError()) || !waitFor(sockfd, true) )
+                return false;
+        } else {
+            sent += n;
+        }
+    }
+    return true;
+}
+
 int Exiv2::http(Exiv2::Dictionary& request,Exiv2::Dictionary& response,std::string& errors)
 {
     if ( !request.count("verb")   ) request["verb"   ] = "GET";
@@ -192,9 +296,7 @@ int Exiv2::http(Exiv2::Dictionary& request,Exiv2::Dictionary& response,std::stri
     if ( !request.count("version")) request["version"] = "1.0";
     if ( !request.count("port")   ) request["port"   ] = ""   ;
 
-    std::string file;
     errors     = "";
-    int result = 0;
 
     ////////////////////////////////////
     // Windows specific code
@@ -243,169 +345,197 @@ int Exiv2::http(Exiv2::Dictionary& request,Exiv2::Dictionary& response,std::stri
     if ( !port  [0] ) port   = "80";
     if ( !port_p[0] ) port_p = "80";
 
-    ////////////////////////////////////
-    // open the socket
-    int sockfd = static_cast<int>(socket(AF_INET , SOCK_STREAM,IPPROTO_TCP));
-    if (sockfd < 0)
-        return error(errors, "unable to create socket\n", nullptr, nullptr, 0);
-
-    // connect the socket to the server
-    int     server  = -1 ;
-
-    // fill in the address
-    struct  sockaddr_in serv_addr   ;
-    int                 serv_len = sizeof(serv_addr);
-    memset(reinterpret_cast<char*>(&serv_addr), 0, serv_len);
-
-    serv_addr.sin_addr.s_addr   = inet_addr(servername_p);
-    serv_addr.sin_family        = AF_INET    ;
-    serv_addr.sin_port          = htons(atoi(port_p));
-
-    // convert unknown servername into IP address
-    // http://publib.boulder.ibm.com/infocenter/iseries/v5r3/index.jsp?topic=/rzab6/rzab6uafinet.htm
-    if (serv_addr.sin_addr.s_addr == static_cast<unsigned long>(INADDR_NONE)) {
-        struct hostent* host = gethostbyname(servername_p);
-        if (!host)
-            return error(errors, "no such host", servername_p);
-        memcpy(&serv_addr.sin_addr, host->h_addr, sizeof(serv_addr.sin_addr));
-    }
-
-    makeNonBlocking(sockfd) ;
-
-    ////////////////////////////////////
-    // and connect
-    server = connect(sockfd, reinterpret_cast<const struct sockaddr*>(&serv_addr), serv_len);
-    if ( server == SOCKET_ERROR && WSAGetLastError() != WSAEWOULDBLOCK )
-        return error(errors, "error - unable to connect to server = %s port = %s wsa_error = %d", servername_p, port_p,
-                     WSAGetLastError());
-
-    char   buffer[32*1024+1];
-    size_t buff_l= sizeof buffer - 1 ;
-
     ////////////////////////////////////
     // format the request
-    int    n  = snprintf(buffer,buff_l,httpTemplate,verb,page,version,servername,header) ;
-    buffer[n] = 0 ;
-    response["requestheaders"]=std::string(buffer,n);
-
-
-    ////////////////////////////////////
-    // send the header (we'll have to wait for the connection by the non-blocking socket)
-    while ( sleep_ >= 0 && send(sockfd,buffer,n,0) == SOCKET_ERROR /* && WSAGetLastError() == WSAENOTCONN */ ) {
-        Sleep(snooze) ;
-        sleep_ -= snooze ;
-    }
-
-    if ( sleep_ < 0 )
-        return error(errors, "error - timeout connecting to server = %s port = %s wsa_error = %d", servername, port,
-                     WSAGetLastError());
-
-    int    end   = 0         ; // write position in buffer
-    bool   bSearching = true ; // looking for headers in the response
-    int    status= 200       ; // assume happiness
+    // the header may be of any size: the data of a POST is sent in it
+    std::string requestHeaders = std::string(verb) + " " + page + " HTTP/" + version + "\r\n"
+                               + "User-Agent: exiv2http/1.0.0\r\n"
+                               + "Accept: */*\r\n"
+                               + "Host: " + servername + "\r\n"
+                               + header
+                               + "\r\n";
+    response["requestheaders"]=requestHeaders;
+
+    // HTTP/1.1 connections are kept open for the next request to the same server
+    const bool        keepAlive = request["version"] == "1.1";
+    const bool        bHead     = request["verb"] == "HEAD";
+    const std::string key       = std::string(servername_p) + ":" + port_p;
+
+    int         sockfd   = -1;
+    int         status   = 200;   // assume happiness
+    bool        complete = false; // the length of the response is known and all of it has been read
+    bool        hungup   = false; // the server has closed the connection
+    bool        bClose   = !keepAlive;
+    bool        chunked  = false;
+    long long   length   = -1;    // Content-Length
+    size_t      body     = std::string::npos; // start of the body in data
+    std::string data;             // the response as received
+    std::string file;
 
     ////////////////////////////////////
-    // read and process the response
-    int err = 0;
-    n = forgive(recv(sockfd, buffer, static_cast<int>(buff_l), 0), err);
-    while ( n >= 0 && OK(status) ) {
-        if ( n ) {
-            end += n ;
-            buffer[end] = 0 ;
+    // send the request and read the response. An idle connection may have been closed
+    // by the server in the meantime, the request is then sent again on a new connection.
+    for ( int attempt = 0; attempt < 2 && data.empty(); attempt++ ) {
+        bool reused = false;
+        if ( keepAlive && attempt == 0 ) {
+            sockfd = takeConnection(key);
+            reused = sockfd >= 0;
+        }
+        if ( !reused ) {
+            sockfd = connectTo(servername_p, port_p, errors);
+            if ( sockfd < 0 )
+                return -1;
+        }
+        if ( !sendAll(sockfd, requestHeaders) ) {
+            closesocket(sockfd);
+            if ( reused )
+                continue;
+            return error(errors, "error - unable to send to server = %s port = %s wsa_error = %d", servername, port,
+                         WSAGetLastError());
+        }
 
-            size_t body = 0         ; // start of body
-            if ( bSearching ) {
+        char buffer[32*1024];
+        hungup = false;
+        while ( !complete && !hungup ) {
+            if ( !waitFor(sockfd, false) )
+                break;
+            int n = recv(sockfd, buffer, static_cast<int>(sizeof buffer), 0);
+            if ( n == SOCKET_ERROR && wouldBlock(WSAGetLastError()) )
+                continue;
+            if ( n <= 0 ) {
+                hungup = true;
+                break;
+            }
+            data.append(buffer, n);
 
+            if ( body == std::string::npos ) {
                 // search for the body
                 for (auto&& line : blankLines) {
-                    if (!bSearching)
+                    size_t blankLinePos = data.find(line);
+                    if ( blankLinePos != std::string::npos ) {
+                        body = blankLinePos + strlen(line);
                         break;
-                    const char* blankLinePos = strstr(buffer, line);
-                    if ( blankLinePos ) {
-                        bSearching = false ;
-                        body = blankLinePos - buffer + strlen(line);
-                        const char* firstSpace = strchr(buffer,' ');
-                        if (firstSpace) {
-                            status = atoi(firstSpace);
-                        }
                     }
                 }
+                if ( body == std::string::npos ) {
+                    // this handles the possibility that there are no headers
+                    if ( data.size() >= headerSize ) {
+                        body   = 0;
+                        bClose = true;
+                    }
+                    continue;
+                }
 
                 // parse response headers
-                char* h = buffer;
-                char  C = ':' ;
-                char  N = '\n';
-                int   i = 0   ; // initial byte in buffer
-                while(buffer[i] == N ) i++;
-                h = strchr(h+i,N);
-                if (!h) {
+                size_t i          = data.find_first_not_of('\n');
+                size_t h          = data.find('\n', i);
+                size_t firstSpace = data.find(' ', i);
+                if ( h == std::string::npos || firstSpace == std::string::npos || firstSpace > h ) {
                     status = 0;
                     break;
                 }
+                response[""] = data.substr(i, h - i - (data[h - 1] == '\r' ? 1 : 0));
+                status = atoi(data.c_str() + firstSpace);
                 h++;
-                response[""]=std::string(buffer+i).substr(0,h-buffer-2);
-                const char* firstSpace = strchr(buffer,' ');
-                if ( !firstSpace ) {
-                    status = 0;
-                    break;
+                while ( h < body ) {
+                    size_t first_newline = data.find('\n', h);
+                    size_t c             = data.find(':', h);
+                    if ( c == std::string::npos || first_newline == std::string::npos || c > first_newline )
+                        break;
+                    size_t valueEnd = data[first_newline - 1] == '\r' ? first_newline - 1 : first_newline;
+                    response[data.substr(h, c - h)] = data.substr(c + 1, valueEnd - c - 1);
+                    h = first_newline + 1;
                 }
-                result = atoi(firstSpace);
-                char* c = strchr(h,C);
-                char* first_newline = strchr(h,N);
-                while ( c && first_newline && c < first_newline && h < buffer+body ) {
-                    std::string key(h);
-                    std::string value(c+1);
-                    key   = key.substr(0,c-h);
-                    value = value.substr(0,first_newline-c-1);
-                    response[key]=value;
-                    h = first_newline+1;
-                    c = strchr(h,C);
-                    first_newline = strchr(h,N);
+
+                std::string connection    = Exiv2::Internal::lower(responseHeader(response, "connection"));
+                std::string contentLength = responseHeader(response, "content-length");
+                std::string encoding      = Exiv2::Internal::lower(responseHeader(response, "transfer-encoding"));
+                chunked = encoding.find("chunked") != std::string::npos;
+                length  = contentLength.empty() ? -1 : atoll(contentLength.c_str());
+                if ( connection.find("close") != std::string::npos ||
+                     (data.compare(i, 8, "HTTP/1.0") == 0 && connection.find("keep-alive") == std::string::npos) )
+                    bClose = true;
+                if ( bHead || status == 204 || status == 304 || (100 <= status && status < 200) ) {
+                    length  = 0;
+                    chunked = false;
                 }
             }
 
-            // if the buffer's full and we're still searching - give up!
-            // this handles the possibility that there are no headers
-            if ( bSearching && buff_l-end < 10 ) {
-                bSearching = false ;
-                body  = 0 ;
-            }
-            if ( !bSearching && OK(status) ) {
-                flushBuffer(buffer,body,end,file);
+            if ( chunked ) {
+                complete = data.size() - body >= 5 && data.compare(data.size() - 4, 4, "\r\n\r\n") == 0 &&
+                           Exiv2::Internal::dechunk(data, body, file);
+            } else if ( length >= 0 ) {
+                complete = data.size() - body >= static_cast<size_t>(length);
             }
         }
-        n = forgive(recv(sockfd, buffer + end, static_cast<int>(buff_l - end), 0), err);
-        if ( !n ) {
-            Sleep(snooze) ;
-            sleep_ -= snooze ;
-            if ( sleep_ < 0 ) n = FINISH ;
+
+        if ( data.empty() ) {
+            closesocket(sockfd);
+            if ( reused )
+                continue;
+            return error(errors, "error - no response from server = %s port = %s wsa_error = %d", servername, port,
+                         WSAGetLastError());
         }
     }
+    if ( data.empty() ) // the second attempt on a new connection could not send the request
+        return error(errors, "error - unable to send to server = %s port = %s wsa_error = %d", servername, port,
+                     WSAGetLastError());
 
-    if ( n != FINISH || !OK(status) ) {
-        snprintf(buffer,sizeof buffer,"wsa_error = %d,n = %d,sleep_ = %d status = %d"
-                ,   WSAGetLastError()
-                ,   n
-                ,   sleep_
-                ,   status
-                ) ;
-        error(errors, buffer, nullptr, nullptr, 0);
-    } else if ( bSearching && OK(status) ) {
-        if ( end ) {
-        //  we finished OK without finding headers, flush the buffer
-            flushBuffer(buffer,0,end,file) ;
+    if ( body == std::string::npos ) {
+        // we finished without finding headers, the response is the body
+        body   = 0;
+        bClose = true;
+    }
+    if ( !chunked ) {
+        if ( length >= 0 ) {
+            file = data.substr(body, static_cast<size_t>(length));
         } else {
-            return error(errors, "error - no response from server = %s port = %s wsa_error = %d", servername, port,
-                         WSAGetLastError());
+            // the body ends when the server closes the connection
+            file     = data.substr(body);
+            complete = hungup;
         }
     }
 
+    if ( !complete ) {
+        error(errors, "error - incomplete response from server = %s port = %s wsa_error = %d", servername, port,
+              WSAGetLastError());
+    } else if ( !OK(status) ) {
+        error(errors, "error - server = %s port = %s returned status = %d", servername, port, status);
+    }
+
     ////////////////////////////////////
-    // close sockets
-    closesocket(server) ;
-    closesocket(sockfd) ;
-    response["body"]=file;
-    return result;
+    // keep or close the connection
+    if ( complete && !bClose && !hungup ) {
+        returnConnection(key, sockfd);
+    } else {
+        closesocket(sockfd);
+    }
+    response["body"] = OK(status) ? file : "";
+    return status;
+}
+
+int Exiv2::http(Exiv2::Dictionary& request, const std::vector<std::pair<uint64_t, uint64_t>>& ranges,
+                std::vector<std::string>& parts, std::string& errors)
+{
+    parts.assign(ranges.size(), "");
+    if ( ranges.empty() )
+        return 200;
+
+    std::ostringstream ss;
+    ss << "Range: bytes=";
+    for ( size_t i = 0; i < ranges.size(); i++ )
+        ss << (i ? "," : "") << ranges[i].first << "-" << ranges[i].second;
+    ss << "\r\n";
+    request["header"] += ss.str();
+
+    Exiv2::Dictionary response;
+    int status = http(request, response, errors);
+    if ( !errors.empty() || !OK(status) )
+        return status;
+
+    Exiv2::Internal::extractRanges(status, responseHeader(response, "content-type"),
+                                   responseHeader(response, "content-range"), response["body"], ranges, parts);
+    return status;
 }
 
 // That's all Folks
@@ -0,0 +1,130 @@
+// ***************************************************************** -*- C++ -*-
+/*
+ * Copyright (C) 2004-2021 Exiv2 authors
+ * This program is part of the Exiv2 distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, 5th Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "http_int.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace Exiv2
+{
+    namespace Internal
+    {
+        namespace
+        {
+            // copy the data of piece, which starts at byte first of the resource, to the ranges it covers
+            void copyPiece(uint64_t first, const std::string& piece,
+                           const std::vector<std::pair<uint64_t, uint64_t>>& ranges, std::vector<std::string>& parts)
+            {
+                for (size_t i = 0; i < ranges.size(); i++) {
+                    if (ranges[i].first < first || ranges[i].first - first >= piece.size())
+                        continue;
+                    uint64_t last = std::min<uint64_t>(ranges[i].second, first + piece.size() - 1);
+                    parts[i] = piece.substr(static_cast<size_t>(ranges[i].first - first),
+                                            static_cast<size_t>(last - ranges[i].first + 1));
+                }
+            }
+        }  // namespace
+
+        std::string lower(std::string s)
+        {
+            for (auto&& c : s)
+                c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+            return s;
+        }
+
+        bool dechunk(const std::string& data, size_t start, std::string& body)
+        {
+            body.clear();
+            size_t pos = start;
+            for (;;) {
+                size_t eol = data.find("\r\n", pos);
+                if (eol == std::string::npos)
+                    return false;
+                if (!isxdigit(static_cast<unsigned char>(data[pos])))
+                    return false;
+                size_t size = strtoul(data.c_str() + pos, nullptr, 16);
+                pos = eol + 2;
+                if (size == 0)  // last chunk, followed by the trailer
+                    return data.find("\r\n\r\n", eol) != std::string::npos;
+                // the chunk and its CRLF must be in data, checked without overflowing
+                if (data.size() - pos < 2 || size > data.size() - pos - 2)
+                    return false;
+                body.append(data, pos, size);
+                pos += size + 2;
+            }
+        }
+
+        bool parseContentRange(const std::string& range, uint64_t& first, uint64_t& last)
+        {
+            size_t pos = range.find_first_of("0123456789");
+            if (pos == std::string::npos)
+                return false;
+            char* end = nullptr;
+            first = strtoull(range.c_str() + pos, &end, 10);
+            if (*end != '-')
+                return false;
+            last = strtoull(end + 1, nullptr, 10);
+            return last >= first;
+        }
+
+        void extractRanges(int status, const std::string& contentType, const std::string& contentRange,
+                           const std::string& body, const std::vector<std::pair<uint64_t, uint64_t>>& ranges,
+                           std::vector<std::string>& parts)
+        {
+            parts.assign(ranges.size(), "");
+            size_t boundaryPos = contentType.find("boundary=");
+            uint64_t first = 0;
+            uint64_t last = 0;
+            if (status == 200) {
+                // the server ignored the ranges and sent the whole resource
+                copyPiece(0, body, ranges, parts);
+            } else if (lower(contentType).find("multipart/byteranges") != std::string::npos &&
+                       boundaryPos != std::string::npos) {
+                std::string boundary = contentType.substr(boundaryPos + 9);
+                boundary = "--" + boundary.substr(0, boundary.find(';'));
+                boundary.erase(std::remove(boundary.begin(), boundary.end(), '"'), boundary.end());
+
+                // each part: --boundary, headers with a Content-Range, a blank line and the data
+                size_t pos = body.find(boundary);
+                while (pos != std::string::npos && body.compare(pos + boundary.size(), 2, "--") != 0) {
+                    size_t headersEnd = body.find("\r\n\r\n", pos);
+                    if (headersEnd == std::string::npos)
+                        break;
+                    std::string partHeaders = lower(body.substr(pos, headersEnd - pos));
+                    size_t rangePos = partHeaders.find("content-range:");
+                    if (rangePos == std::string::npos ||
+                        !parseContentRange(partHeaders.substr(rangePos, partHeaders.find('\n', rangePos) - rangePos),
+                                           first, last))
+                        break;
+                    size_t start = headersEnd + 4;
+                    size_t size = static_cast<size_t>(std::min<uint64_t>(last - first + 1, body.size() - start));
+                    copyPiece(first, body.substr(start, size), ranges, parts);
+                    pos = body.find(boundary, start + size);
+                }
+            } else if (parseContentRange(contentRange, first, last)) {
+                // a single range, the server may have merged the requested ranges
+                copyPiece(first, body, ranges, parts);
+            }
+        }
+
+    }  // namespace Internal
+}  // namespace Exiv2
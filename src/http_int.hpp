@@ -0,0 +1,82 @@
+// ***************************************************************** -*- C++ -*-
+/*
+ * Copyright (C) 2004-2021 Exiv2 authors
+ * This program is part of the Exiv2 distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, 5th Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef HTTP_INT_HPP_
+#define HTTP_INT_HPP_
+
+// *****************************************************************************
+// + standard includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// *****************************************************************************
+// namespace extensions
+namespace Exiv2 {
+    namespace Internal {
+
+// *****************************************************************************
+// free functions
+
+    //! Return \em s in lower case
+    std::string lower(std::string s);
+
+    /*!
+      @brief Decode the chunked body which starts at \em data[start].
+
+      @param data  The response as received so far
+      @param start Position of the first chunk in \em data
+      @param body  The decoded body
+      @return true if the body and its trailer are complete, false if
+              more data is needed or a chunk is malformed
+     */
+    bool dechunk(const std::string& data, size_t start, std::string& body);
+
+    /*!
+      @brief Parse a Content-Range "bytes first-last/size".
+
+      @return true if \em first and \em last were read and \em last is not
+              smaller than \em first
+     */
+    bool parseContentRange(const std::string& range, uint64_t& first, uint64_t& last);
+
+    /*!
+      @brief Copy the requested \em ranges out of the body of a response.
+
+      The server may answer with the whole resource (status 200), with a
+      multipart/byteranges body or with a single Content-Range, which may
+      cover several requested ranges merged into one.
+
+      @param status       Status of the response
+      @param contentType  Value of its Content-Type header
+      @param contentRange Value of its Content-Range header
+      @param body         Its body
+      @param ranges       The requested ranges, first and last byte
+      @param parts        The data of each range, left empty for the
+                          ranges which are not in the response
+     */
+    void extractRanges(int status, const std::string& contentType, const std::string& contentRange,
+                       const std::string& body, const std::vector<std::pair<uint64_t, uint64_t>>& ranges,
+                       std::vector<std::string>& parts);
+
+}}                                      // namespace Internal, Exiv2
+
+#endif                                  // #ifndef HTTP_INT_HPP_
@@ -141,6 +141,40 @@ namespace {
         return (found == std::string::npos) ? path : path.substr(found);
     }
 
+    //! Number of bytes read from the start of an image to determine its type
+    constexpr long headerSize = 1024;
+
+    /*!
+      @brief Determine the type of the image provided by \em io, which must
+          be open and positioned at the start of the data.
+
+      The header is read once and all signature checks run against a copy
+      of it in memory, so that each check does not go back to the (possibly
+      remote) source. The position of \em io is restored before returning.
+
+      @return The registry entry of the image type or nullptr if the type
+          is not recognized.
+     */
+    const Registry* findType(BasicIo& io)
+    {
+        DataBuf header(headerSize);
+        const long size = io.read(header.data(), headerSize);
+        io.seek(0, BasicIo::beg);
+        if (io.error() || size <= 0) {
+            return nullptr;
+        }
+        MemIo memIo(header.c_data(), size);
+        for (const Registry* r = registry; r->imageType_ != ImageType::none; ++r) {
+            // TARGA files are recognized by the file name, not by the header
+            BasicIo& checkIo = (r->imageType_ == ImageType::tga) ? io : static_cast<BasicIo&>(memIo);
+            memIo.seek(0, BasicIo::beg);
+            if (r->isThisType_(checkIo, false)) {
+                return r;
+            }
+        }
+        return nullptr;
+    }
+
 }  // namespace
 
 // *****************************************************************************
@@ -150,6 +184,9 @@ namespace Exiv2 {
         : io_(std::move(io)),
           pixelWidth_(0),
           pixelHeight_(0),
+          writeMethod_(wmIntrusive),
+          appendMetadata_(false),
+          exifFiltered_(false),
           imageType_(type),
           supportedMetadata_(supportedMetadata),
 #ifdef EXV_HAVE_XMP_TOOLKIT
@@ -605,11 +642,13 @@ namespace Exiv2 {
     void Image::clearExifData()
     {
         exifData_.clear();
+        exifFiltered_ = false;
     }
 
     void Image::setExifData(const ExifData& exifData)
     {
         exifData_ = exifData;
+        exifFiltered_ = false;
     }
 
     void Image::clearIptcData()
@@ -691,6 +730,21 @@ namespace Exiv2 {
         byteOrder_ = byteOrder;
     }
 
+    void Image::setExifFilter(const ExifFilter& exifFilter)
+    {
+        exifFilter_ = exifFilter;
+    }
+
+    void Image::setAppendMetadata(bool append)
+    {
+        appendMetadata_ = append;
+    }
+
+    void Image::enforceExifUnfiltered() const
+    {
+        enforce(!exifFiltered_, kerImageWriteFailed);
+    }
+
     ByteOrder Image::byteOrder() const
     {
         return byteOrder_;
@@ -741,6 +795,21 @@ namespace Exiv2 {
         return writeXmpFromPacket_;
     }
 
+    const ExifFilter& Image::exifFilter() const
+    {
+        return exifFilter_;
+    }
+
+    WriteMethod Image::writeMethod() const
+    {
+        return writeMethod_;
+    }
+
+    bool Image::appendMetadata() const
+    {
+        return appendMetadata_;
+    }
+
     const NativePreviewList& Image::nativePreviews() const
     {
         return nativePreviews_;
@@ -838,12 +907,8 @@ namespace Exiv2 {
         if (io.open() != 0)
             return ImageType::none;
         IoCloser closer(io);
-        for (unsigned int i = 0; registry[i].imageType_ != ImageType::none; ++i) {
-            if (registry[i].isThisType_(io, false)) {
-                return registry[i].imageType_;
-            }
-        }
-        return ImageType::none;
+        const Registry* r = findType(io);
+        return r ? r->imageType_ : ImageType::none;
     }
 
     BasicIo::UniquePtr ImageFactory::createIo(const std::string& path, bool useCurl)
@@ -890,12 +955,11 @@ namespace Exiv2 {
         if (io->open() != 0) {
             throw Error(kerDataSourceOpenFailed, io->path(), strError());
         }
-        for (unsigned int i = 0; registry[i].imageType_ != ImageType::none; ++i) {
-            if (registry[i].isThisType_(*io, false)) {
-                return registry[i].newInstance_(std::move(io), false);
-            }
+        const Registry* r = findType(*io);
+        if (r == nullptr) {
+            return nullptr;
         }
-        return nullptr;
+        return r->newInstance_(std::move(io), false);
     }
 
     Image::UniquePtr ImageFactory::create(ImageType type, const std::string& path)
@@ -18,7 +18,12 @@
  */
 
 #include "image_int.hpp"
+#include "basicio.hpp"
+#include "error.hpp"
+#include "futils.hpp"
 
+#include <algorithm>
+#include <cassert>
 #include <cstdarg>
 #include <cstddef>
 #include <cstring>
@@ -66,6 +71,48 @@ namespace Exiv2
             return result;
         }
 
+        bool padXmpPacket(std::string& xmpPacket, size_t size)
+        {
+            if (xmpPacket.size() > size)
+                return false;
+            std::string::size_type pos = xmpPacket.rfind("<?xpacket end=");
+            if (pos == std::string::npos)
+                pos = xmpPacket.size();
+            xmpPacket.insert(pos, size - xmpPacket.size(), ' ');
+            return true;
+        }
+
+        void InPlaceUpdate::add(long offset, const byte* current, const byte* data, size_t size)
+        {
+            if (size == 0 || std::equal(data, data + size, current))
+                return;
+            ranges_.emplace_back(offset, Blob(data, data + size));
+        }
+
+        bool InPlaceUpdate::apply(BasicIo& io) const
+        {
+            auto fileIo = dynamic_cast<FileIo*>(&io);
+            if (fileIo == nullptr)
+                return false;
+            if (ranges_.empty())
+                return true;
+
+            io.close();
+            if (fileIo->open("r+b") != 0) {
+                if (io.open() != 0)
+                    throw Error(kerDataSourceOpenFailed, io.path(), strError());
+                return false;
+            }
+            for (auto&& range : ranges_) {
+                const auto size = static_cast<long>(range.second.size());
+                if (io.seek(range.first, BasicIo::beg) != 0 || io.write(&range.second[0], size) != size)
+                    throw Error(kerImageWriteFailed);
+            }
+            if (io.error())
+                throw Error(kerImageWriteFailed);
+            return true;
+        }
+
     }  // namespace Internal
 
 }  // namespace Exiv2
@@ -26,6 +26,8 @@
 
 // + standard includes
 #include <string>
+#include <utility>
+#include <vector>
 
 #if (defined(__GNUG__) || defined(__GNUC__)) || defined(__clang__)
 #define ATTRIBUTE_FORMAT_PRINTF __attribute__((format(printf, 1, 0)))
@@ -36,6 +38,8 @@
 // *****************************************************************************
 // namespace extensions
 namespace Exiv2 {
+    class BasicIo;
+
     namespace Internal {
 
 // *****************************************************************************
@@ -123,6 +127,49 @@ namespace Exiv2 {
     /// @brief indent output for kpsRecursive in \em printStructure() \em .
     std::string indent(int32_t depth);
 
+    /*!
+      @brief Pad the XMP packet \em xmpPacket with whitespace to exactly
+             \em size bytes. The padding is inserted in front of the closing
+             xpacket processing instruction, where the XMP specification
+             places it, or appended to a packet without a wrapper.
+
+      @return true if successful;<BR>
+              false if the packet is already larger than \em size.
+     */
+    bool padXmpPacket(std::string& xmpPacket, size_t size);
+
+    /*!
+      @brief Byte ranges to be overwritten in an existing image file.
+
+      The writeMetadata() implementations collect the re-encoded metadata
+      blocks here while checking that each of them fits into the space of
+      the block it replaces. Nothing is written before apply() is called,
+      so a block that does not fit leaves the file untouched and the image
+      is rewritten instead.
+     */
+    class InPlaceUpdate {
+    public:
+        /*!
+          @brief Queue \em size bytes from \em data to be written at
+                 \em offset. \em current points to the bytes presently at
+                 that offset; the range is dropped if they are unchanged.
+         */
+        void add(long offset, const byte* current, const byte* data, size_t size);
+        /*!
+          @brief Write all queued ranges to \em io. The file is reopened
+                 for update, which requires a FileIo, and left open.
+
+          @return true if successful;<BR>
+                  false if \em io cannot be opened for writing. In that case
+                  it is reopened for reading and nothing has been written.
+          @throw Error if a write fails.
+         */
+        bool apply(BasicIo& io) const;
+
+    private:
+        std::vector<std::pair<long, Blob> > ranges_; //!< Offsets and new data
+    };
+
 }}                                      // namespace Internal, Exiv2
 
 #endif                                  // #ifndef IMAGE_INT_HPP_
@@ -220,6 +220,7 @@ static void boxes_check(size_t b,size_t m)
             if (io_->error() || io_->eof()) throw Error(kerFailedToReadImageData);
             throw Error(kerNotAnImage, "JPEG-2000");
         }
+        exifFiltered_ = !exifFilter_.empty();
 
         Jp2BoxHeader      box       = {0,0};
         Jp2BoxHeader      subBox    = {0,0};
@@ -385,7 +386,8 @@ static void boxes_check(size_t b,size_t m)
                                                                       iptcData(),
                                                                       xmpData(),
                                                                       rawData.c_data(pos),
-                                                                      rawData.size() - pos);
+                                                                      rawData.size() - pos,
+                                                                      &exifFilter_);
                                     setByteOrder(bo);
                                 }
                             }
@@ -631,19 +633,138 @@ static void boxes_check(size_t b,size_t m)
 
     void Jp2Image::writeMetadata()
     {
+        enforceExifUnfiltered();
         if (io_->open() != 0)
         {
             throw Error(kerDataSourceOpenFailed, io_->path(), strError());
         }
         IoCloser closer(*io_);
-        auto tempIo = std::make_unique<MemIo>();
+        if (writeMetadataInPlace()) {
+            writeMethod_ = wmNonIntrusive;
+            return;
+        }
+        io_->seekOrThrow(0, BasicIo::beg, kerInputDataReadFailed);
+        auto tempIo = io_->temporary();
 
         doWriteMetadata(*tempIo); // may throw
         io_->close();
         io_->transfer(*tempIo); // may throw
+        writeMethod_ = wmIntrusive;
 
     } // Jp2Image::writeMetadata
 
+    bool Jp2Image::writeMetadataInPlace()
+    {
+        if (dynamic_cast<FileIo*>(io_.get()) == nullptr || !isJp2Type(*io_, true))
+            return false;
+
+        // Offset of the data following the UUID and data of the boxes to update
+        long exifPos = -1;
+        long iptcPos = -1;
+        long xmpPos = -1;
+        int jp2hCount = 0;
+        DataBuf rawExif;
+        DataBuf rawIptc;
+        DataBuf rawXmp;
+
+        DataBuf bheaderBuf(8);
+        while (io_->tell() < static_cast<long>(io_->size())) {
+            io_->readOrThrow(bheaderBuf.data(), bheaderBuf.size(), kerInputDataReadFailed);
+            uint32_t length = bheaderBuf.read_uint32(0, bigEndian);
+            const uint32_t type = bheaderBuf.read_uint32(4, bigEndian);
+            if (length == 0) {
+                length = static_cast<uint32_t>(io_->size() - io_->tell() + 8);
+            }
+            if (length < 8 || length - 8 > static_cast<size_t>(io_->size() - io_->tell()))
+                return false;
+
+            if (type == kJp2BoxTypeJp2Header) {
+                // The header box is only kept if it is already encoded the way
+                // doWriteMetadata() would write it
+                DataBuf boxBuf(length);
+                boxBuf.copyBytes(0, bheaderBuf.c_data(), 8);
+                io_->readOrThrow(boxBuf.data(8), length - 8, kerInputDataReadFailed);
+                DataBuf newBuf;
+                encodeJp2Header(boxBuf, newBuf);
+                if (++jp2hCount > 1 || newBuf.size() != boxBuf.size() ||
+                    newBuf.cmpBytes(0, boxBuf.c_data(), boxBuf.size()) != 0) {
+                    return false;
+                }
+            } else if (type == kJp2BoxTypeUuid) {
+                if (length < 24)
+                    return false;
+                byte uuid[16];
+                io_->readOrThrow(uuid, sizeof(uuid), kerInputDataReadFailed);
+                const long pos = io_->tell();
+                long* dataPos = nullptr;
+                DataBuf* data = nullptr;
+                if (memcmp(uuid, kJp2UuidExif, sizeof(uuid)) == 0) {
+                    dataPos = &exifPos;
+                    data = &rawExif;
+                } else if (memcmp(uuid, kJp2UuidIptc, sizeof(uuid)) == 0) {
+                    dataPos = &iptcPos;
+                    data = &rawIptc;
+                } else if (memcmp(uuid, kJp2UuidXmp, sizeof(uuid)) == 0) {
+                    dataPos = &xmpPos;
+                    data = &rawXmp;
+                }
+                if (dataPos == nullptr) {
+                    io_->seekOrThrow(length - 24, BasicIo::cur, kerFailedToReadImageData);
+                } else {
+                    if (*dataPos != -1)
+                        return false;
+                    *dataPos = pos;
+                    data->alloc(length - 24);
+                    io_->readOrThrow(data->data(), data->size(), kerInputDataReadFailed);
+                }
+            } else {
+                io_->seekOrThrow(length - 8, BasicIo::cur, kerFailedToReadImageData);
+            }
+        }
+        if (jp2hCount == 0)
+            return false;
+
+        Internal::InPlaceUpdate update;
+
+        Blob blob;
+        if (exifData_.count() > 0) {
+            ExifParser::encode(blob, littleEndian, exifData_);
+        }
+        if ((exifPos != -1) != !blob.empty())
+            return false;
+        if (exifPos != -1) {
+            if (blob.size() > static_cast<size_t>(rawExif.size()))
+                return false;
+            blob.resize(rawExif.size(), 0);
+            update.add(exifPos, rawExif.c_data(), &blob[0], blob.size());
+        }
+
+        DataBuf newIptc;
+        if (iptcData_.count() > 0) {
+            newIptc = IptcParser::encode(iptcData_);
+        }
+        if ((iptcPos != -1) != (newIptc.size() > 0))
+            return false;
+        if (iptcPos != -1) {
+            if (newIptc.size() != rawIptc.size())
+                return false;
+            update.add(iptcPos, rawIptc.c_data(), newIptc.c_data(), newIptc.size());
+        }
+
+        if (!writeXmpFromPacket() && XmpParser::encode(xmpPacket_, xmpData_) > 1)
+            return false;
+        if ((xmpPos != -1) != !xmpPacket_.empty())
+            return false;
+        if (xmpPos != -1) {
+            std::string xmpPacket(xmpPacket_);
+            if (!Internal::padXmpPacket(xmpPacket, rawXmp.size()))
+                return false;
+            update.add(xmpPos, rawXmp.c_data(), reinterpret_cast<const byte*>(xmpPacket.data()), xmpPacket.size());
+        }
+
+        return update.apply(*io_);
+    } // Jp2Image::writeMetadataInPlace
+
 #ifdef __clang__
 // ignore cast align errors.  dataBuf.pData_ is allocated by malloc() and 4 (or 8 byte aligned).
 #pragma clang diagnostic push
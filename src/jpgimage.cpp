@@ -328,14 +328,12 @@ namespace Exiv2 {
 
     byte JpegBase::advanceToMarker(ErrorCode err) const
     {
-        int c = -1;
         // Skips potential padding between markers
-        while ((c=io_->getb()) != 0xff) {
-            if (c == EOF)
-                throw Error(err);
-        }
+        if (io_->seekToByte(0xff) != 0)
+            throw Error(err);
 
         // Markers can start with any number of 0xff
+        int c = -1;
         while ((c=io_->getb()) == 0xff) {
         }
         if (c == EOF)
@@ -356,6 +354,7 @@ namespace Exiv2 {
             throw Error(kerNotAJpeg);
         }
         clearMetadata();
+        exifFiltered_ = !exifFilter_.empty();
         int search = 6 ; // Exif, ICC, XMP, Comment, IPTC, SOF
         Blob psBlob;
         bool foundCompletePsData = false;
@@ -378,18 +377,20 @@ namespace Exiv2 {
                 enforce(size >= 2, kerFailedToReadImageData);
             }
 
-            // Read the rest of the segment.
-            DataBuf buf(size);
+            // Read the rest of the segment. IO sources which hold the file
+            // in memory lend the data, others copy it into buf. The
+            // segment data starts after the 2-byte size field.
+            DataBuf buf;
+            const byte* data = nullptr;
             if (size > 0) {
-                io_->readOrThrow(buf.data(2), size - 2, kerFailedToReadImageData);
-                buf.copyBytes(0, sizebuf, 2);
+                data = io_->readViewOrThrow(size - 2, buf, kerFailedToReadImageData);
             }
 
             if (   !foundExifData
                 && marker == app1_
                 && size >= 8  // prevent out-of-bounds read in memcmp on next line
-                && buf.cmpBytes(2, exifId_, 6) == 0) {
-                ByteOrder bo = ExifParser::decode(exifData_, buf.c_data(8), size - 8);
+                && std::memcmp(data, exifId_, 6) == 0) {
+                ByteOrder bo = ExifParser::decode(exifData_, data + 6, size - 8, &exifFilter_);
                 setByteOrder(bo);
                 if (size > 8 && byteOrder() == invalidByteOrder) {
 #ifndef SUPPRESS_WARNINGS
@@ -403,8 +404,8 @@ namespace Exiv2 {
             else if (   !foundXmpData
                      && marker == app1_
                      && size >= 31  // prevent out-of-bounds read in memcmp on next line
-                     && buf.cmpBytes(2, xmpId_, 29) == 0) {
-                xmpPacket_.assign(buf.c_str(31), size - 31);
+                     && std::memcmp(data, xmpId_, 29) == 0) {
+                xmpPacket_.assign(reinterpret_cast<const char*>(data + 29), size - 31);
                 if (!xmpPacket_.empty() && XmpParser::decode(xmpData_, xmpPacket_)) {
 #ifndef SUPPRESS_WARNINGS
                     EXV_WARNING << "Failed to decode XMP metadata.\n";
@@ -416,13 +417,13 @@ namespace Exiv2 {
             else if (   !foundCompletePsData
                      && marker == app13_
                      && size >= 16  // prevent out-of-bounds read in memcmp on next line
-                     && buf.cmpBytes(2, Photoshop::ps3Id_, 14) == 0) {
+                     && std::memcmp(data, Photoshop::ps3Id_, 14) == 0) {
 #ifdef EXIV2_DEBUG_MESSAGES
                 std::cerr << "Found app13 segment, size = " << size << "\n";
                 //hexdump(std::cerr, psData.pData_, psData.size_);
 #endif
                 // Append to psBlob
-                append(psBlob, buf.c_data(16), size - 16);
+                append(psBlob, data + 14, size - 16);
                 // Check whether psBlob is complete
                 if (!psBlob.empty() && Photoshop::valid(&psBlob[0], static_cast<long>(psBlob.size()))) {
                     --search;
@@ -434,7 +435,7 @@ namespace Exiv2 {
                 // JPEGs can have multiple comments, but for now only read
                 // the first one (most jpegs only have one anyway). Comments
                 // are simple single byte ISO-8859-1 strings.
-                comment_.assign(buf.c_str(2), size - 2);
+                comment_.assign(reinterpret_cast<const char*>(data), size - 2);
                 while (   comment_.length()
                        && comment_.at(comment_.length()-1) == '\0') {
                     comment_.erase(comment_.length()-1);
@@ -443,7 +444,7 @@ namespace Exiv2 {
             }
             else if (   marker == app2_
                      && size >= 13  // prevent out-of-bounds read in memcmp on next line
-                     && buf.cmpBytes(2, iccId_,11)==0) {
+                     && std::memcmp(data, iccId_, 11) == 0) {
                 if (size < 2+14+4) {
                     rc = 8;
                     break;
@@ -453,13 +454,13 @@ namespace Exiv2 {
                     foundIccData = true ;
                     --search ;
                 }
-                int chunk = static_cast<int>(buf.read_uint8(2 + 12));
-                int chunks = static_cast<int>(buf.read_uint8(2 + 13));
+                int chunk = static_cast<int>(data[12]);
+                int chunks = static_cast<int>(data[13]);
                 // ICC1v43_2010-12.pdf header is 14 bytes
                 // header = "ICC_PROFILE\0" (12 bytes)
                 // chunk/chunks are a single byte
                 // Spec 7.2 Profile bytes 0-3 size
-                uint32_t s = buf.read_uint32(2+14, bigEndian);
+                uint32_t s = getULong(data + 14, bigEndian);
 #ifdef EXIV2_DEBUG_MESSAGES
                 std::cerr << "Found ICC Profile chunk " << chunk
                           << " of "    << chunks
@@ -477,7 +478,7 @@ namespace Exiv2 {
                 if ( iccProfile_.size() ) {
                     profile.copyBytes(0, iccProfile_.c_data(), iccProfile_.size());
                 }
-                profile.copyBytes(iccProfile_.size(), buf.c_data(2+14), icc_size);
+                profile.copyBytes(iccProfile_.size(), data + 14, icc_size);
                 setIccProfile(std::move(profile),chunk==chunks);
             }
             else if (  pixelHeight_ == 0 && inRange2(marker,sof0_,sof3_,sof5_,sof15_) ) {
@@ -486,8 +487,8 @@ namespace Exiv2 {
                     rc = 7;
                     break;
                 }
-                pixelHeight_ = buf.read_uint16(3, bigEndian);
-                pixelWidth_ = buf.read_uint16(5, bigEndian);
+                pixelHeight_ = getUShort(data + 1, bigEndian);
+                pixelWidth_ = getUShort(data + 3, bigEndian);
                 if (pixelHeight_ != 0) --search;
             }
 
@@ -818,7 +819,7 @@ namespace Exiv2 {
             // exiv2 -pS E.jpg
 
             // binary copy io_ to a temporary file
-            auto tempIo = std::make_unique<MemIo>();
+            auto tempIo = io_->temporary();
             for (size_t i = 0; i < (count / 2) + 1; i++) {
                 long start = pos[2 * i] + 2;  // step JPG 2 byte marker
                 if (start == 2)
@@ -828,10 +829,7 @@ namespace Exiv2 {
 #ifdef EXIV2_DEBUG_MESSAGES
                     std::cout << start << ":" << length << std::endl;
 #endif
-                    io_->seekOrThrow(start, BasicIo::beg, kerFailedToReadImageData);
-                    DataBuf buf(length);
-                    io_->readOrThrow(buf.data(), buf.size(), kerFailedToReadImageData);
-                    tempIo->write(buf.c_data(), buf.size());
+                    tempIo->copyFrom(*io_, start, length);
                 }
             }
 
@@ -844,18 +842,157 @@ namespace Exiv2 {
 
     void JpegBase::writeMetadata()
     {
+        enforceExifUnfiltered();
         if (io_->open() != 0) {
             throw Error(kerDataSourceOpenFailed, io_->path(), strError());
         }
         IoCloser closer(*io_);
-        BasicIo::UniquePtr tempIo(new MemIo);
+        if (writeMetadataInPlace()) {
+            writeMethod_ = wmNonIntrusive;
+            return;
+        }
+        io_->seekOrThrow(0, BasicIo::beg, kerInputDataReadFailed);
+        BasicIo::UniquePtr tempIo = io_->temporary();
         assert (tempIo.get() != 0);
 
         doWriteMetadata(*tempIo); // may throw
         io_->close();
         io_->transfer(*tempIo); // may throw
+        writeMethod_ = wmIntrusive;
     } // JpegBase::writeMetadata
 
+    bool JpegBase::writeMetadataInPlace()
+    {
+        if (dynamic_cast<FileIo*>(io_.get()) == nullptr || !isThisType(*io_, true))
+            return false;
+
+        // Offset and contents of the first segment of each kind, excluding
+        // the segment identifier
+        long exifPos = -1;
+        long xmpPos = -1;
+        long psPos = -1;
+        long comPos = -1;
+        DataBuf rawExif;
+        DataBuf rawXmp;
+        DataBuf psData;
+        DataBuf rawCom;
+        int psCount = 0;
+        bool foundIccData = false;
+        Blob iccBlob;
+
+        byte marker = advanceToMarker(kerNoImageInInputData);
+        while (marker != sos_ && marker != eoi_) {
+            if (!markerHasLength(marker)) {
+                marker = advanceToMarker(kerNoImageInInputData);
+                continue;
+            }
+            byte sizebuf[2];
+            io_->readOrThrow(sizebuf, 2, kerFailedToReadImageData);
+            const uint16_t size = getUShort(sizebuf, bigEndian);
+            enforce(size >= 2, kerFailedToReadImageData);
+            const long pos = io_->tell();
+
+            // Only read the segments which may hold metadata
+            DataBuf buf;
+            if (marker == app1_ || marker == app2_ || marker == app13_ || marker == com_) {
+                buf.alloc(size - 2);
+                io_->readOrThrow(buf.data(), size - 2, kerFailedToReadImageData);
+            } else {
+                io_->seekOrThrow(size - 2, BasicIo::cur, kerFailedToReadImageData);
+            }
+
+            if (marker == app1_ && size >= 8 && buf.cmpBytes(0, exifId_, 6) == 0) {
+                if (exifPos == -1) {
+                    exifPos = pos + 6;
+                    rawExif = DataBuf(buf.c_data(6), size - 8);
+                }
+            } else if (marker == app1_ && size >= 31 && buf.cmpBytes(0, xmpId_, 29) == 0) {
+                if (xmpPos == -1) {
+                    xmpPos = pos + 29;
+                    rawXmp = DataBuf(buf.c_data(29), size - 31);
+                }
+            } else if (marker == app2_ && size >= 16 && buf.cmpBytes(0, iccId_, 11) == 0) {
+                foundIccData = true;
+                append(iccBlob, buf.c_data(14), size - 16);
+            } else if (marker == app13_ && size >= 16 && buf.cmpBytes(0, Photoshop::ps3Id_, 14) == 0) {
+                if (++psCount == 1) {
+                    psPos = pos + 14;
+                    psData = DataBuf(buf.c_data(14), size - 16);
+                }
+            } else if (marker == com_ && comPos == -1) {
+                comPos = pos;
+                rawCom = std::move(buf);
+            }
+            marker = advanceToMarker(kerNoImageInInputData);
+        }
+
+        Internal::InPlaceUpdate update;
+
+        if ((exifPos != -1) != (exifData_.count() > 0))
+            return false;
+        if (exifPos != -1) {
+            ByteOrder bo = byteOrder();
+            if (bo == invalidByteOrder) {
+                bo = littleEndian;
+                setByteOrder(bo);
+            }
+            // A non-intrusive encoding modifies the data in place
+            DataBuf exif(rawExif);
+            Blob blob;
+            if (ExifParser::encode(blob, exif.c_data(), exif.size(), bo, exifData_) == wmNonIntrusive) {
+                blob.assign(exif.c_data(), exif.c_data() + exif.size());
+            }
+            if (blob.empty() || blob.size() > static_cast<size_t>(rawExif.size()))
+                return false;
+            blob.resize(rawExif.size(), 0);
+            update.add(exifPos, rawExif.c_data(), &blob[0], blob.size());
+        }
+
+        if (!writeXmpFromPacket() &&
+            XmpParser::encode(xmpPacket_, xmpData_, XmpParser::useCompactFormat | XmpParser::omitAllFormatting) > 1) {
+            return false;
+        }
+        if ((xmpPos != -1) != !xmpPacket_.empty())
+            return false;
+        if (xmpPos != -1) {
+            std::string xmpPacket(xmpPacket_);
+            if (!Internal::padXmpPacket(xmpPacket, rawXmp.size()))
+                return false;
+            update.add(xmpPos, rawXmp.c_data(), reinterpret_cast<const byte*>(xmpPacket.data()), xmpPacket.size());
+        }
+
+        if (foundIccData != iccProfileDefined())
+            return false;
+        if (foundIccData && (static_cast<long>(iccBlob.size()) != iccProfile_.size() ||
+                             iccProfile_.cmpBytes(0, &iccBlob[0], iccBlob.size()) != 0)) {
+            return false;
+        }
+
+        if (psPos == -1 && iptcData_.count() > 0)
+            return false;
+        if (psPos != -1) {
+            if (psCount > 1 || !Photoshop::valid(psData.c_data(), psData.size()))
+                return false;
+            DataBuf newPsData = Photoshop::setIptcIrb(psData.c_data(), psData.size(), iptcData_);
+            if (newPsData.size() != psData.size())
+                return false;
+            update.add(psPos, psData.c_data(), newPsData.c_data(), newPsData.size());
+        }
+
+        if ((comPos != -1) != !comment_.empty())
+            return false;
+        if (comPos != -1) {
+            // Pad the comment with null bytes, which the reader strips
+            if (comment_.size() > static_cast<size_t>(rawCom.size()))
+                return false;
+            DataBuf com(rawCom.size());
+            com.copyBytes(0, comment_.data(), comment_.size());
+            update.add(comPos, rawCom.c_data(), com.c_data(), com.size());
+        }
+
+        return update.apply(*io_);
+    } // JpegBase::writeMetadataInPlace
+
     void JpegBase::doWriteMetadata(BasicIo& outIo)
     {
         if (!io_->isopen())
@@ -1245,12 +1382,8 @@ namespace Exiv2 {
         if (outIo.write(tmpBuf, 2) != 2)
             throw Error(kerImageWriteFailed);
 
-        DataBuf buf(4096);
-        long readSize = 0;
-        while ((readSize = io_->read(buf.data(), buf.size()))) {
-            if (outIo.write(buf.c_data(), readSize) != readSize)
-                throw Error(kerImageWriteFailed);
-        }
+        const long pos = io_->tell();
+        outIo.copyFrom(*io_, pos, io_->size() - pos);
         if (outIo.error())
             throw Error(kerImageWriteFailed);
 
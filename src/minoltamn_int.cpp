@@ -2028,7 +2028,7 @@ namespace Exiv2 {
 
     static std::ostream& resolvedLens(std::ostream& os,long lensID,long index)
     {
-        const TagDetails* td = find(minoltaSonyLensID, lensID);
+        const TagDetails* td = findTagDetails<EXV_COUNTOF(minoltaSonyLensID), minoltaSonyLensID>(lensID);
         std::vector<std::string> tokens = split(td[0].label_,"|");
         return os << exvGettext(trim(tokens.at(index-1)).c_str());
     }
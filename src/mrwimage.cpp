@@ -100,6 +100,7 @@ namespace Exiv2 {
             throw Error(kerNotAnImage, "MRW");
         }
         clearMetadata();
+        exifFiltered_ = !exifFilter_.empty();
 
         // Find the TTW block and read it into a buffer
         uint32_t const len = 8;
@@ -141,7 +142,8 @@ namespace Exiv2 {
                                           iptcData_,
                                           xmpData_,
                                           buf.c_data(),
-                                          buf.size());
+                                          buf.size(),
+                                          &exifFilter_);
         setByteOrder(bo);
     } // MrwImage::readMetadata
 
@@ -108,8 +108,10 @@ namespace Exiv2 {
             throw Error(kerNotAnImage, "ORF");
         }
         clearMetadata();
+        exifFiltered_ = !exifFilter_.empty();
         ByteOrder bo =
-            OrfParser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), static_cast<uint32_t>(io_->size()));
+            OrfParser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), static_cast<uint32_t>(io_->size()),
+                              &exifFilter_);
         setByteOrder(bo);
     } // OrfImage::readMetadata
 
@@ -118,6 +120,7 @@ namespace Exiv2 {
 #ifdef EXIV2_DEBUG_MESSAGES
         std::cerr << "Writing ORF file " << io_->path() << "\n";
 #endif
+        enforceExifUnfiltered();
         ByteOrder bo = byteOrder();
         byte* pData = nullptr;
         long size = 0;
@@ -137,15 +140,16 @@ namespace Exiv2 {
             bo = littleEndian;
         }
         setByteOrder(bo);
-        OrfParser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_); // may throw
+        writeMethod_ = OrfParser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_); // may throw
     } // OrfImage::writeMetadata
 
     ByteOrder OrfParser::decode(
-              ExifData& exifData,
-              IptcData& iptcData,
-              XmpData&  xmpData,
-        const byte*     pData,
-              uint32_t  size
+              ExifData&   exifData,
+              IptcData&   iptcData,
+              XmpData&    xmpData,
+        const byte*       pData,
+              uint32_t    size,
+        const ExifFilter* pFilter
     )
     {
         OrfHeader orfHeader;
@@ -156,7 +160,8 @@ namespace Exiv2 {
                                         size,
                                         Tag::root,
                                         TiffMapping::findDecoder,
-                                        &orfHeader);
+                                        &orfHeader,
+                                        pFilter);
     }
 
     WriteMethod OrfParser::encode(
@@ -1247,7 +1247,7 @@ namespace Exiv2 {
 
             if ( index > 0 )  {
                 const unsigned long lensID    = 0x32c;
-                const TagDetails* td = find(pentaxLensType, lensID);
+                const TagDetails* td = findTagDetails<EXV_COUNTOF(pentaxLensType), pentaxLensType>(lensID);
                 os << exvGettext(td[index].label_);
                 return os;
             }
@@ -1303,7 +1303,7 @@ namespace Exiv2 {
 
             if ( index > 0 )  {
                 const unsigned long lensID = 0x3ff;
-                const TagDetails* td = find(pentaxLensType, lensID);
+                const TagDetails* td = findTagDetails<EXV_COUNTOF(pentaxLensType), pentaxLensType>(lensID);
                 os << exvGettext(td[index].label_);
                 return os;
             }
@@ -1328,7 +1328,7 @@ namespace Exiv2 {
 
             if ( index > 0 )  {
                 const unsigned long lensID = 0x8ff;
-                const TagDetails* td = find(pentaxLensType, lensID);
+                const TagDetails* td = findTagDetails<EXV_COUNTOF(pentaxLensType), pentaxLensType>(lensID);
                 os << exvGettext(td[index].label_);
                 return os;
             }
@@ -1361,7 +1361,7 @@ namespace Exiv2 {
 
             if ( index > 0 )  {
                 const unsigned long lensID = 0x319;
-                const TagDetails* td = find(pentaxLensType, lensID);
+                const TagDetails* td = findTagDetails<EXV_COUNTOF(pentaxLensType), pentaxLensType>(lensID);
                 os << exvGettext(td[index].label_);
                 return os;
             }
@@ -88,7 +88,7 @@ namespace Exiv2 {
             }
             l += (value.toUint32(c) << ((count - c - 1) * 8));
         }
-        const TagDetails* td = find(array, l);
+        const TagDetails* td = findTagDetails<N, array>(l);
         if (td) {
             os << exvGettext(td->label_);
         }
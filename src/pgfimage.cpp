@@ -157,7 +157,7 @@ namespace Exiv2 {
             throw Error(kerDataSourceOpenFailed, io_->path(), strError());
         }
         IoCloser closer(*io_);
-        auto tempIo = std::make_unique<MemIo>();
+        auto tempIo = io_->temporary();
 
         doWriteMetadata(*tempIo); // may throw
         io_->close();
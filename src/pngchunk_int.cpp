@@ -68,17 +68,26 @@ namespace Exiv2
         void PngChunk::decodeIHDRChunk(const DataBuf& data, uint32_t* outWidth, uint32_t* outHeight)
         {
             assert(data.size() >= 8);
+            decodeIHDRChunk(data.c_data(), outWidth, outHeight);
+        }
 
+        void PngChunk::decodeIHDRChunk(const byte* pData, uint32_t* outWidth, uint32_t* outHeight)
+        {
             // Extract image width and height from IHDR chunk.
 
-            *outWidth = data.read_uint32(0, bigEndian);
-            *outHeight = data.read_uint32(4, bigEndian);
+            *outWidth = getULong(pData, bigEndian);
+            *outHeight = getULong(pData + 4, bigEndian);
         }
 
         void PngChunk::decodeTXTChunk(Image* pImage, const DataBuf& data, TxtChunkType type)
         {
-            DataBuf key = keyTXTChunk(data);
-            DataBuf arr = parseTXTChunk(data, key.size(), type);
+            decodeTXTChunk(pImage, data.c_data(), data.size(), type);
+        }
+
+        void PngChunk::decodeTXTChunk(Image* pImage, const byte* pData, long size, TxtChunkType type)
+        {
+            DataBuf key = keyTXTChunk(pData, size);
+            DataBuf arr = parseTXTChunk(pData, size, key.size(), type);
 
 #ifdef EXIV2_DEBUG_MESSAGES
             std::cout << "Exiv2::PngChunk::decodeTXTChunk: TXT chunk data: " << std::string(arr.c_str(), arr.size())
@@ -95,40 +104,44 @@ namespace Exiv2
             std::cout << "Exiv2::PngChunk::decodeTXTChunk: TXT chunk key: " << std::string(key.c_str(), key.size())
                       << std::endl;
 #endif
-            return parseTXTChunk(data, key.size(), type);
+            return parseTXTChunk(data.c_data(), data.size(), key.size(), type);
         }
 
         DataBuf PngChunk::keyTXTChunk(const DataBuf& data, bool stripHeader)
+        {
+            return keyTXTChunk(data.c_data(), data.size(), stripHeader);
+        }
+
+        DataBuf PngChunk::keyTXTChunk(const byte* pData, long size, bool stripHeader)
         {
             // From a tEXt, zTXt, or iTXt chunk, we get the keyword which is null terminated.
             const int offset = stripHeader ? 8 : 0;
-            if (data.size() <= offset)
+            if (size <= offset)
                 throw Error(kerFailedToReadImageData);
 
-            // Search for null char until the end of the DataBuf
-            const byte* dataPtr = data.c_data();
+            // Search for null char until the end of the chunk data
             int keysize = offset;
-            while (keysize < data.size() && dataPtr[keysize] != 0) {
+            while (keysize < size && pData[keysize] != 0) {
                 keysize++;
             }
 
-            if (keysize == data.size())
+            if (keysize == size)
                 throw Error(kerFailedToReadImageData);
 
-            return DataBuf(dataPtr + offset, keysize - offset);
+            return DataBuf(pData + offset, keysize - offset);
         }
 
-        DataBuf PngChunk::parseTXTChunk(const DataBuf& data, int keysize, TxtChunkType type)
+        DataBuf PngChunk::parseTXTChunk(const byte* pData, long size, int keysize, TxtChunkType type)
         {
             DataBuf arr;
 
             if (type == zTXt_Chunk) {
-                enforce(data.size() >= Safe::add(keysize, nullSeparators), Exiv2::kerCorruptedMetadata);
+                enforce(size >= Safe::add(keysize, nullSeparators), Exiv2::kerCorruptedMetadata);
 
                 // Extract a deflate compressed Latin-1 text chunk
 
                 // we get the compression method after the key
-                const byte* compressionMethod = data.c_data(keysize + 1);
+                const byte* compressionMethod = pData + keysize + 1;
                 if (*compressionMethod != 0x00) {
                     // then it isn't zlib compressed and we are sunk
 #ifdef EXIV2_DEBUG_MESSAGES
@@ -138,57 +151,58 @@ namespace Exiv2
                 }
 
                 // compressed string after the compression technique spec
-                const byte* compressedText = data.c_data(keysize + nullSeparators);
-                long compressedTextSize = data.size() - keysize - nullSeparators;
-                enforce(compressedTextSize < data.size(), kerCorruptedMetadata);
+                const byte* compressedText = pData + keysize + nullSeparators;
+                long compressedTextSize = size - keysize - nullSeparators;
+                enforce(compressedTextSize < size, kerCorruptedMetadata);
 
                 zlibUncompress(compressedText, compressedTextSize, arr);
             } else if (type == tEXt_Chunk) {
-                enforce(data.size() >= Safe::add(keysize, 1), Exiv2::kerCorruptedMetadata);
+                enforce(size >= Safe::add(keysize, 1), Exiv2::kerCorruptedMetadata);
                 // Extract a non-compressed Latin-1 text chunk
 
                 // the text comes after the key, but isn't null terminated
-                const byte* text = data.c_data(keysize + 1);
-                long textsize = data.size() - keysize - 1;
+                const byte* text = pData + keysize + 1;
+                long textsize = size - keysize - 1;
 
                 arr = DataBuf(text, textsize);
             } else if (type == iTXt_Chunk) {
-                enforce(data.size() >= Safe::add(keysize, 3), Exiv2::kerCorruptedMetadata);
-                const size_t nullCount = std::count(data.c_data(keysize + 3), data.c_data(data.size()), '\0');
+                enforce(size >= Safe::add(keysize, 3), Exiv2::kerCorruptedMetadata);
+                const size_t nullCount = std::count(pData + keysize + 3, pData + size, '\0');
                 enforce(nullCount >= nullSeparators, Exiv2::kerCorruptedMetadata);
 
                 // Extract a deflate compressed or uncompressed UTF-8 text chunk
 
                 // we get the compression flag after the key
-                const byte compressionFlag = data.read_uint8(keysize + 1);
+                const byte compressionFlag = pData[keysize + 1];
                 // we get the compression method after the compression flag
-                const byte compressionMethod = data.read_uint8(keysize + 2);
+                const byte compressionMethod = pData[keysize + 2];
 
                 enforce(compressionFlag == 0x00 || compressionFlag == 0x01, Exiv2::kerCorruptedMetadata);
                 enforce(compressionMethod == 0x00, Exiv2::kerCorruptedMetadata);
 
                 // language description string after the compression technique spec
-                const size_t languageTextMaxSize = data.size() - keysize - 3;
-                std::string languageText =
-                    string_from_unterminated(data.c_str(Safe::add(keysize, 3)), languageTextMaxSize);
+                const size_t languageTextMaxSize = size - keysize - 3;
+                std::string languageText = string_from_unterminated(
+                    reinterpret_cast<const char*>(pData) + Safe::add(keysize, 3), languageTextMaxSize);
                 const size_t languageTextSize = languageText.size();
 
-                enforce(static_cast<unsigned long>(data.size()) >=
+                enforce(static_cast<unsigned long>(size) >=
                             Safe::add(static_cast<size_t>(Safe::add(keysize, 4)), languageTextSize),
                         Exiv2::kerCorruptedMetadata);
                 // translated keyword string after the language description
-                std::string translatedKeyText = string_from_unterminated(
-                    data.c_str(keysize + 3 + languageTextSize + 1), data.size() - (keysize + 3 + languageTextSize + 1));
+                std::string translatedKeyText =
+                    string_from_unterminated(reinterpret_cast<const char*>(pData) + keysize + 3 + languageTextSize + 1,
+                                             size - (keysize + 3 + languageTextSize + 1));
                 const auto translatedKeyTextSize = static_cast<unsigned int>(translatedKeyText.size());
 
                 if ((compressionFlag == 0x00) || (compressionFlag == 0x01 && compressionMethod == 0x00)) {
                     enforce(Safe::add(static_cast<unsigned int>(keysize + 3 + languageTextSize + 1),
-                                      Safe::add(translatedKeyTextSize, 1U)) <= static_cast<size_t>(data.size()),
+                                      Safe::add(translatedKeyTextSize, 1U)) <= static_cast<size_t>(size),
                             Exiv2::kerCorruptedMetadata);
 
-                    const byte* text = data.c_data(keysize + 3 + languageTextSize + 1 + translatedKeyTextSize + 1);
+                    const byte* text = pData + keysize + 3 + languageTextSize + 1 + translatedKeyTextSize + 1;
                     const long textsize = static_cast<long>(
-                        data.size() - (keysize + 3 + languageTextSize + 1 + translatedKeyTextSize + 1));
+                        size - (keysize + 3 + languageTextSize + 1 + translatedKeyTextSize + 1));
 
                     if (compressionFlag == 0x00) {
                         // then it's an uncompressed iTXt chunk
@@ -256,7 +270,8 @@ namespace Exiv2
 #endif
                         pos = pos + sizeof(exifHeader);
                         ByteOrder bo = TiffParser::decode(pImage->exifData(), pImage->iptcData(), pImage->xmpData(),
-                                                          exifData.c_data(pos), length - pos);
+                                                          exifData.c_data(pos), length - pos,
+                                                          &pImage->exifFilter());
                         pImage->setByteOrder(bo);
                     } else {
 #ifndef SUPPRESS_WARNINGS
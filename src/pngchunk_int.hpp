@@ -66,6 +66,15 @@ namespace Exiv2 {
                                     uint32_t*      outWidth,
                                     uint32_t*      outHeight);
 
+        /*!
+          @brief Decode PNG IHDR chunk data from \em pData, which must be at
+                 least 8 bytes long, and return image size to \em outWidth
+                 and \em outHeight.
+        */
+        static void decodeIHDRChunk(const byte* pData,
+                                    uint32_t*   outWidth,
+                                    uint32_t*   outHeight);
+
         /*!
           @brief Decode PNG tEXt, zTXt, or iTXt chunk data from \em pImage passed by data buffer
                  \em data and extract Comment, Exif, Iptc, Xmp metadata accordingly.
@@ -78,6 +87,21 @@ namespace Exiv2 {
                                    const DataBuf& data,
                                    TxtChunkType   type);
 
+        /*!
+          @brief Decode PNG tEXt, zTXt, or iTXt chunk data from \em pImage passed by
+                 \em pData and \em size and extract Comment, Exif, Iptc, Xmp metadata
+                 accordingly. The chunk data is not copied.
+
+          @param pImage    Pointer to the image to hold the metadata
+          @param pData     PNG Chunk data.
+          @param size      Size of the PNG Chunk data.
+          @param type      PNG Chunk TXT type.
+        */
+        static void decodeTXTChunk(Image*       pImage,
+                                   const byte*  pData,
+                                   long         size,
+                                   TxtChunkType type);
+
         /*!
          @brief Decode PNG tEXt, zTXt, or iTXt chunk data from \em pImage passed by data buffer
          \em data and extract Comment, Exif, Iptc, Xmp to DataBuf
@@ -97,6 +121,15 @@ namespace Exiv2 {
         */
         static DataBuf keyTXTChunk(const DataBuf& data, bool stripHeader=false);
 
+        /*!
+          @brief Return PNG TXT chunk key as data buffer.
+
+          @param pData       PNG Chunk data.
+          @param size        Size of the PNG Chunk data.
+          @param stripHeader Set true if chunk data start with header bytes, else false (default).
+        */
+        static DataBuf keyTXTChunk(const byte* pData, long size, bool stripHeader=false);
+
         /*!
           @brief Return a complete PNG chunk data compressed or not as buffer.
                  Data returned is formated accordingly with metadata \em type
@@ -113,9 +146,10 @@ namespace Exiv2 {
           @brief Parse PNG Text chunk to determine type and extract content.
                  Supported Chunk types are tTXt, zTXt, and iTXt.
          */
-        static DataBuf parseTXTChunk(const DataBuf& data,
-                                     int            keysize,
-                                     TxtChunkType   type);
+        static DataBuf parseTXTChunk(const byte*  pData,
+                                     long         size,
+                                     int          keysize,
+                                     TxtChunkType type);
 
         /*!
           @brief Parse PNG chunk contents to extract metadata container and assign it to image.
@@ -37,6 +37,7 @@
 // + standard includes
 #include <algorithm>
 #include <array>
+#include <map>
 #include <string>
 #include <cstring>
 #include <iostream>
@@ -434,6 +435,7 @@ namespace Exiv2 {
             throw Error(kerNotAnImage, "PNG");
         }
         clearMetadata();
+        exifFiltered_ = !exifFilter_.empty();
 
         const long imgSize = static_cast<long>(io_->size());
         DataBuf cheaderBuf(8);       // Chunk header: 4 bytes (data size) + 4 bytes (chunk type).
@@ -465,26 +467,30 @@ namespace Exiv2 {
             || chunkType == "eXIf"
             || chunkType == "iTXt" || chunkType == "iCCP"
             ){
-                DataBuf chunkData(chunkLength);
-                readChunk(chunkData, *io_);  // Extract chunk data.
+                // Extract chunk data. IO sources which hold the file in memory
+                // lend the data, others copy it into chunkBuf.
+                DataBuf chunkBuf;
+                const byte* chunkData = io_->readViewOrThrow(chunkLength, chunkBuf, kerInputDataReadFailed);
+                const long chunkSize = static_cast<long>(chunkLength);
 
                 if (chunkType == "IEND") {
                     return;  // Last chunk found: we stop parsing.
                 }
-                if (chunkType == "IHDR" && chunkData.size() >= 8) {
+                if (chunkType == "IHDR" && chunkSize >= 8) {
                     PngChunk::decodeIHDRChunk(chunkData, &pixelWidth_, &pixelHeight_);
                 } else if (chunkType == "tEXt") {
-                    PngChunk::decodeTXTChunk(this, chunkData, PngChunk::tEXt_Chunk);
+                    PngChunk::decodeTXTChunk(this, chunkData, chunkSize, PngChunk::tEXt_Chunk);
                 } else if (chunkType == "zTXt") {
-                    PngChunk::decodeTXTChunk(this, chunkData, PngChunk::zTXt_Chunk);
+                    PngChunk::decodeTXTChunk(this, chunkData, chunkSize, PngChunk::zTXt_Chunk);
                 } else if (chunkType == "iTXt") {
-                    PngChunk::decodeTXTChunk(this, chunkData, PngChunk::iTXt_Chunk);
+                    PngChunk::decodeTXTChunk(this, chunkData, chunkSize, PngChunk::iTXt_Chunk);
                 } else if (chunkType == "eXIf") {
                     ByteOrder bo = TiffParser::decode(exifData(),
                                                       iptcData(),
                                                       xmpData(),
-                                                      chunkData.c_data(),
-                                                      chunkData.size());
+                                                      chunkData,
+                                                      chunkLength,
+                                                      &exifFilter_);
                     setByteOrder(bo);
                 } else if (chunkType == "iCCP") {
                     // The ICC profile name can vary from 1-79 characters.
@@ -492,13 +498,13 @@ namespace Exiv2 {
                     do {
                       enforce(iccOffset < 80 && iccOffset < chunkLength,
                               Exiv2::kerCorruptedMetadata);
-                    } while(chunkData.read_uint8(iccOffset++) != 0x00);
+                    } while(chunkData[iccOffset++] != 0x00);
 
-                    profileName_ = std::string(chunkData.c_str(), iccOffset-1);
+                    profileName_ = std::string(reinterpret_cast<const char*>(chunkData), iccOffset-1);
                     ++iccOffset; // +1 = 'compressed' flag
                     enforce(iccOffset <= chunkLength, Exiv2::kerCorruptedMetadata);
 
-                    zlibToDataBuf(chunkData.c_data(iccOffset), chunkLength - iccOffset, iccProfile_);
+                    zlibToDataBuf(chunkData + iccOffset, chunkLength - iccOffset, iccProfile_);
 #ifdef EXIV2_DEBUG_MESSAGES
                     std::cout << "Exiv2::PngImage::readMetadata: profile name: " << profileName_ << std::endl;
                     std::cout << "Exiv2::PngImage::readMetadata: iccProfile.size_ (uncompressed) : "
@@ -525,19 +531,183 @@ namespace Exiv2 {
 
     void PngImage::writeMetadata()
     {
+        enforceExifUnfiltered();
         if (io_->open() != 0)
         {
             throw Error(kerDataSourceOpenFailed, io_->path(), strError());
         }
         IoCloser closer(*io_);
-        auto tempIo = std::make_unique<MemIo>();
+        if (writeMetadataInPlace()) {
+            writeMethod_ = wmNonIntrusive;
+            return;
+        }
+        io_->seekOrThrow(0, BasicIo::beg, kerInputDataReadFailed);
+        auto tempIo = io_->temporary();
 
         doWriteMetadata(*tempIo); // may throw
         io_->close();
         io_->transfer(*tempIo); // may throw
+        writeMethod_ = wmIntrusive;
 
     } // PngImage::writeMetadata
 
+    bool PngImage::writeMetadataInPlace()
+    {
+        if (dynamic_cast<FileIo*>(io_.get()) == nullptr || !isPngType(*io_, true))
+            return false;
+
+        // Offset and contents (header, data and CRC) of the metadata chunks
+        std::map<MetadataId, std::pair<long, DataBuf> > found;
+
+        DataBuf cheaderBuf(8);
+        while (true) {
+            const long pos = io_->tell();
+            io_->readOrThrow(cheaderBuf.data(), 8, kerInputDataReadFailed);
+            uint32_t dataOffset = cheaderBuf.read_uint32(0, Exiv2::bigEndian);
+            if (dataOffset > 0x7FFFFFFF) throw Exiv2::Error(kerFailedToReadImageData);
+
+            if (cheaderBuf.cmpBytes(4, "IEND", 4) == 0) {
+                break;
+            }
+            if (cheaderBuf.cmpBytes(4, "eXIf", 4) == 0) {
+                // Only a rewrite can replace it with a text chunk
+                return false;
+            }
+            if (cheaderBuf.cmpBytes(4, "tEXt", 4) != 0 && cheaderBuf.cmpBytes(4, "zTXt", 4) != 0 &&
+                cheaderBuf.cmpBytes(4, "iTXt", 4) != 0 && cheaderBuf.cmpBytes(4, "iCCP", 4) != 0) {
+                io_->seekOrThrow(dataOffset + 4, BasicIo::cur, kerFailedToReadImageData);
+                continue;
+            }
+
+            DataBuf chunkBuf(8 + dataOffset + 4);
+            chunkBuf.copyBytes(0, cheaderBuf.c_data(), 8);
+            io_->readOrThrow(chunkBuf.data(8), dataOffset + 4, kerInputDataReadFailed);
+
+            // The same chunks which doWriteMetadata() strips
+            DataBuf key = PngChunk::keyTXTChunk(chunkBuf, true);
+            MetadataId id = mdNone;
+            if (compare("Raw profile type exif", key, 21) || compare("Raw profile type APP1", key, 21)) {
+                id = mdExif;
+            } else if (compare("Raw profile type iptc", key, 21)) {
+                id = mdIptc;
+            } else if (compare("Raw profile type xmp", key, 20) || compare("XML:com.adobe.xmp", key, 17)) {
+                id = mdXmp;
+            } else if (compare("icc", key, 3) || compare("ICC", key, 3)) {
+                id = mdIccProfile;
+            } else if (compare("Description", key, 11)) {
+                id = mdComment;
+            }
+            if (id != mdNone && !found.emplace(id, std::make_pair(pos, std::move(chunkBuf))).second) {
+                return false;
+            }
+        }
+
+        Internal::InPlaceUpdate update;
+        for (auto&& chunk : encodeMetadataChunks()) {
+            auto pos = found.find(chunk.first);
+            if (pos == found.end()) {
+                if (!chunk.second.empty())
+                    return false;
+                continue;
+            }
+            const DataBuf& oldChunk = pos->second.second;
+            const auto oldSize = static_cast<size_t>(oldChunk.size());
+            if (chunk.first == mdXmp && !chunk.second.empty() && chunk.second.size() < oldSize) {
+                // The XMP chunk is not compressed, pad the packet to fill the old one
+                std::string xmpPacket(xmpPacket_);
+                padXmpPacket(xmpPacket, xmpPacket.size() + oldSize - chunk.second.size());
+                chunk.second = PngChunk::makeMetadataChunk(xmpPacket, mdXmp);
+            }
+            if (chunk.second.size() != oldSize)
+                return false;
+            update.add(pos->second.first, oldChunk.c_data(), reinterpret_cast<const byte*>(chunk.second.data()),
+                       chunk.second.size());
+        }
+
+        return update.apply(*io_);
+    } // PngImage::writeMetadataInPlace
+
+    std::vector<std::pair<MetadataId, std::string> > PngImage::encodeMetadataChunks()
+    {
+        std::vector<std::pair<MetadataId, std::string> > chunks;
+
+        std::string comment;
+        if (!comment_.empty()) {
+            comment = PngChunk::makeMetadataChunk(comment_, mdComment);
+        }
+        chunks.emplace_back(mdComment, comment);
+
+        std::string exif;
+        if (exifData_.count() > 0) {
+            Blob blob;
+            ExifParser::encode(blob, littleEndian, exifData_);
+            if (!blob.empty()) {
+                static const char exifHeader[] = { 0x45, 0x78, 0x69, 0x66, 0x00, 0x00 };
+                std::string rawExif = std::string(exifHeader, 6) +
+                                      std::string(reinterpret_cast<const char*>(&blob[0]), blob.size());
+                exif = PngChunk::makeMetadataChunk(rawExif, mdExif);
+            }
+        }
+        chunks.emplace_back(mdExif, exif);
+
+        std::string iptc;
+        if (iptcData_.count() > 0) {
+            DataBuf newPsData = Photoshop::setIptcIrb(nullptr, 0, iptcData_);
+            if (newPsData.size() > 0) {
+                std::string rawIptc(newPsData.c_str(), newPsData.size());
+                iptc = PngChunk::makeMetadataChunk(rawIptc, mdIptc);
+            }
+        }
+        chunks.emplace_back(mdIptc, iptc);
+
+        std::string icc;
+        if ( iccProfileDefined() ) {
+            DataBuf compressed;
+            if ( zlibToCompressed(iccProfile_.c_data(),iccProfile_.size(),compressed) ) {
+                const auto nameLength = static_cast<uint32_t>(profileName_.size());
+                const uint32_t chunkLength = nameLength + 2 + compressed.size() ;
+                byte     length[4];
+                ul2Data (length,chunkLength,bigEndian);
+
+                // calculate CRC
+                uLong   tmp = crc32(0L, Z_NULL, 0);
+                tmp         = crc32(tmp, typeICCP, 4);
+                tmp         = crc32(tmp, (const Bytef*)profileName_.data(), nameLength);
+                tmp         = crc32(tmp, nullComp, 2);
+                tmp = crc32(tmp, compressed.c_data(), compressed.size());
+                byte    crc[4];
+                ul2Data(crc, tmp, bigEndian);
+
+                icc.append(reinterpret_cast<const char*>(length), 4);
+                icc.append(reinterpret_cast<const char*>(typeICCP), 4);
+                icc.append(profileName_);
+                icc.append(reinterpret_cast<const char*>(nullComp), 2);
+                icc.append(compressed.c_str(), compressed.size());
+                icc.append(reinterpret_cast<const char*>(crc), 4);
+#ifdef EXIV2_DEBUG_MESSAGES
+                std::cout << "Exiv2::PngImage::encodeMetadataChunks: build iCCP"
+                << " chunk (length: " << compressed.size() + chunkLength << ")" << std::endl;
+#endif
+            }
+        }
+        chunks.emplace_back(mdIccProfile, icc);
+
+        if (!writeXmpFromPacket()) {
+            if (XmpParser::encode(xmpPacket_, xmpData_) > 1) {
+#ifndef SUPPRESS_WARNINGS
+                EXV_ERROR << "Failed to encode XMP metadata.\n";
+#endif
+            }
+        }
+        std::string xmp;
+        if (!xmpPacket_.empty()) {
+            xmp = PngChunk::makeMetadataChunk(xmpPacket_, mdXmp);
+        }
+        chunks.emplace_back(mdXmp, xmp);
+
+        return chunks;
+    } // PngImage::encodeMetadataChunks
+
     void PngImage::doWriteMetadata(BasicIo& outIo)
     {
         if (!io_->isopen()) throw Error(kerInputDataReadFailed);
@@ -556,6 +726,7 @@ namespace Exiv2 {
         if (outIo.write(pngSignature, 8) != 8) throw Error(kerImageWriteFailed);
 
         DataBuf cheaderBuf(8);       // Chunk header : 4 bytes (data size) + 4 bytes (chunk type).
+        const size_t imgSize = io_->size();
 
         while(!io_->eof())
         {
@@ -571,6 +742,25 @@ namespace Exiv2 {
             uint32_t dataOffset = cheaderBuf.read_uint32(0, Exiv2::bigEndian);
             if (dataOffset > 0x7FFFFFFF) throw Exiv2::Error(kerFailedToReadImageData);
 
+            char szChunk[5];
+            memcpy(szChunk,cheaderBuf.c_data(4),4);
+            szChunk[4]  = 0;
+
+            if (strcmp(szChunk, "IEND") && strcmp(szChunk, "eXIf") && strcmp(szChunk, "IHDR") &&
+                strcmp(szChunk, "tEXt") && strcmp(szChunk, "zTXt") && strcmp(szChunk, "iTXt") &&
+                strcmp(szChunk, "iCCP")) {
+                // Copy all other chunks (image data) straight from the input.
+#ifdef EXIV2_DEBUG_MESSAGES
+                std::cout << "Exiv2::PngImage::doWriteMetadata:  copy " << szChunk
+                          << " chunk (length: " << dataOffset << ")" << std::endl;
+#endif
+                const long pos = io_->tell();
+                if (static_cast<size_t>(dataOffset) + 4 > imgSize - pos) throw Error(kerInputDataReadFailed);
+                if (outIo.write(cheaderBuf.c_data(), 8) != 8) throw Error(kerImageWriteFailed);
+                outIo.copyFrom(*io_, pos, dataOffset + 4);
+                continue;
+            }
+
             // Read whole chunk : Chunk header + Chunk data (not fixed size - can be null) + CRC (4 bytes).
 
             DataBuf chunkBuf(8 + dataOffset + 4);  // Chunk header (8 bytes) + Chunk data + CRC (4 bytes).
@@ -580,10 +770,6 @@ namespace Exiv2 {
             if (bufRead != static_cast<long>(dataOffset) + 4L)
                 throw Error(kerInputDataReadFailed);
 
-            char szChunk[5];
-            memcpy(szChunk,cheaderBuf.c_data(4),4);
-            szChunk[4]  = 0;
-
             if ( !strcmp(szChunk,"IEND") )
             {
                 // Last chunk found: we write it and done.
@@ -604,93 +790,9 @@ namespace Exiv2 {
                 if (outIo.write(chunkBuf.data(), chunkBuf.size()) != chunkBuf.size()) throw Error(kerImageWriteFailed);
 
                 // Write all updated metadata here, just after IHDR.
-                if (!comment_.empty())
-                {
-                    // Update Comment data to a new PNG chunk
-                    std::string chunk = PngChunk::makeMetadataChunk(comment_, mdComment);
-                    if (outIo.write(reinterpret_cast<const byte*>(chunk.data()), static_cast<long>(chunk.size())) !=
-                        static_cast<long>(chunk.size())) {
-                        throw Error(kerImageWriteFailed);
-                    }
-                }
-
-                if (exifData_.count() > 0)
-                {
-                    // Update Exif data to a new PNG chunk
-                    Blob blob;
-                    ExifParser::encode(blob, littleEndian, exifData_);
-                    if (!blob.empty()) {
-                        static const char exifHeader[] = { 0x45, 0x78, 0x69, 0x66, 0x00, 0x00 };
-                        std::string rawExif = std::string(exifHeader, 6) +
-                                              std::string(reinterpret_cast<const char*>(&blob[0]), blob.size());
-                        std::string chunk = PngChunk::makeMetadataChunk(rawExif, mdExif);
-                        if (outIo.write(reinterpret_cast<const byte*>(chunk.data()), static_cast<long>(chunk.size())) !=
-                            static_cast<long>(chunk.size())) {
-                            throw Error(kerImageWriteFailed);
-                        }
-                    }
-                }
-
-                if (iptcData_.count() > 0)
-                {
-                    // Update IPTC data to a new PNG chunk
-                    DataBuf newPsData = Photoshop::setIptcIrb(nullptr, 0, iptcData_);
-                    if (newPsData.size() > 0)
-                    {
-                        std::string rawIptc(newPsData.c_str(), newPsData.size());
-                        std::string chunk = PngChunk::makeMetadataChunk(rawIptc, mdIptc);
-                        if (outIo.write(reinterpret_cast<const byte*>(chunk.data()), static_cast<long>(chunk.size())) !=
-                            static_cast<long>(chunk.size())) {
-                            throw Error(kerImageWriteFailed);
-                        }
-                    }
-                }
-
-                if ( iccProfileDefined() ) {
-                    DataBuf compressed;
-                    if ( zlibToCompressed(iccProfile_.c_data(),iccProfile_.size(),compressed) ) {
-                        const auto nameLength = static_cast<uint32_t>(profileName_.size());
-                        const uint32_t chunkLength = nameLength + 2 + compressed.size() ;
-                        byte     length[4];
-                        ul2Data (length,chunkLength,bigEndian);
-
-                        // calculate CRC
-                        uLong   tmp = crc32(0L, Z_NULL, 0);
-                        tmp         = crc32(tmp, typeICCP, 4);
-                        tmp         = crc32(tmp, (const Bytef*)profileName_.data(), nameLength);
-                        tmp         = crc32(tmp, nullComp, 2);
-                        tmp = crc32(tmp, compressed.c_data(), compressed.size());
-                        byte    crc[4];
-                        ul2Data(crc, tmp, bigEndian);
-
-                        if( outIo.write(length, 4) != 4
-                        ||  outIo.write(typeICCP, 4) != 4
-                        ||  outIo.write(reinterpret_cast<const byte*>(profileName_.data()), nameLength) != nameLength
-                        ||  outIo.write(nullComp,2) != 2
-                        ||  outIo.write (compressed.c_data(),compressed.size()) != compressed.size()
-                        ||  outIo.write(crc,4)            != 4
-                        ){
-                            throw Error(kerImageWriteFailed);
-                        }
-#ifdef EXIV2_DEBUG_MESSAGES
-                        std::cout << "Exiv2::PngImage::doWriteMetadata: build iCCP"
-                        << " chunk (length: " << compressed.size() + chunkLength << ")" << std::endl;
-#endif
-                    }
-                }
-
-                if (!writeXmpFromPacket()) {
-                    if (XmpParser::encode(xmpPacket_, xmpData_) > 1) {
-#ifndef SUPPRESS_WARNINGS
-                        EXV_ERROR << "Failed to encode XMP metadata.\n";
-#endif
-                    }
-                }
-                if (!xmpPacket_.empty()) {
-                    // Update XMP data to a new PNG chunk
-                    std::string chunk = PngChunk::makeMetadataChunk(xmpPacket_, mdXmp);
-                    if (outIo.write(reinterpret_cast<const byte*>(chunk.data()), static_cast<long>(chunk.size())) !=
-                        static_cast<long>(chunk.size())) {
+                for (auto&& chunk : encodeMetadataChunks()) {
+                    if (outIo.write(reinterpret_cast<const byte*>(chunk.second.data()),
+                                    static_cast<long>(chunk.second.size())) != static_cast<long>(chunk.second.size())) {
                         throw Error(kerImageWriteFailed);
                     }
                 }
@@ -719,13 +821,6 @@ namespace Exiv2 {
                     if (outIo.write(chunkBuf.c_data(), chunkBuf.size()) != chunkBuf.size())
                         throw Error(kerImageWriteFailed);
                 }
-            } else {
-                // Write all others chunk as well.
-#ifdef EXIV2_DEBUG_MESSAGES
-                std::cout << "Exiv2::PngImage::doWriteMetadata:  copy " << szChunk
-                          << " chunk (length: " << dataOffset << ")" << std::endl;
-#endif
-                if (outIo.write(chunkBuf.c_data(), chunkBuf.size()) != chunkBuf.size()) throw Error(kerImageWriteFailed);
             }
         }
 
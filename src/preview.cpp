@@ -80,6 +80,32 @@ namespace {
      */
     DataBuf makePnm(uint32_t width, uint32_t height, const DataBuf &rgb);
 
+    /*!
+      @brief Keep an IO source open while a preview is read from it. An IO
+             source which is open already is left open. Previews are read
+             with BasicIo::readAt(), so several threads can read them from
+             the same open IO source at the same time.
+     */
+    class IoOpener {
+    public:
+        //! Constructor, opens \em io if it is not open
+        explicit IoOpener(BasicIo& io);
+        //! Destructor, closes the IO source if it was opened by the constructor
+        ~IoOpener();
+        IoOpener(const IoOpener&) = delete;
+        IoOpener& operator=(const IoOpener&) = delete;
+
+    private:
+        BasicIo& io_;  //!< The IO source
+        bool close_;   //!< True if the IO source has to be closed
+    };
+
+    /*!
+      @brief Read \em size bytes at offset \em offset of an open IO source.
+             Return an empty buffer if they are not available.
+     */
+    DataBuf readAt(BasicIo& io, size_t offset, size_t size);
+
     /*!
       Base class for image loaders. Provides virtual methods for reading properties
       and DataBuf.
@@ -459,27 +485,25 @@ namespace {
         if (!valid()) return DataBuf();
 
         BasicIo &io = image_.io();
-        if (io.open() != 0) {
-            throw Error(kerDataSourceOpenFailed, io.path(), strError());
-        }
-        IoCloser closer(io);
-        const byte* data = io.mmap();
-        if (static_cast<long>(io.size()) < nativePreview_.position_ + static_cast<long>(nativePreview_.size_)) {
+        IoOpener opener(io);
+        if (nativePreview_.position_ < 0 ||
+            static_cast<long>(io.size()) < nativePreview_.position_ + static_cast<long>(nativePreview_.size_)) {
 #ifndef SUPPRESS_WARNINGS
             EXV_WARNING << "Invalid native preview position or size.\n";
 #endif
             return DataBuf();
         }
+        DataBuf data = readAt(io, nativePreview_.position_, nativePreview_.size_);
         if (nativePreview_.filter_.empty()) {
-            return DataBuf(data + nativePreview_.position_, static_cast<long>(nativePreview_.size_));
+            return data;
         }
         if (nativePreview_.filter_ == "hex-ai7thumbnail-pnm") {
-            const DataBuf ai7thumbnail = decodeHex(data + nativePreview_.position_, static_cast<long>(nativePreview_.size_));
+            const DataBuf ai7thumbnail = decodeHex(data.c_data(), data.size());
             const DataBuf rgb = decodeAi7Thumbnail(ai7thumbnail);
             return makePnm(width_, height_, rgb);
         }
         if (nativePreview_.filter_ == "hex-irb") {
-            const DataBuf psData = decodeHex(data + nativePreview_.position_, static_cast<long>(nativePreview_.size_));
+            const DataBuf psData = decodeHex(data.c_data(), data.size());
             const byte *record;
             uint32_t sizeHdr = 0;
             uint32_t sizeData = 0;
@@ -564,15 +588,9 @@ namespace {
     {
         if (!valid()) return DataBuf();
         BasicIo &io = image_.io();
+        IoOpener opener(io);
 
-        if (io.open() != 0) {
-            throw Error(kerDataSourceOpenFailed, io.path(), strError());
-        }
-        IoCloser closer(io);
-
-        const Exiv2::byte* base = io.mmap();
-
-        return DataBuf(base + offset_, size_);
+        return readAt(io, offset_, size_);
     }
 
     bool LoaderExifJpeg::readDimensions()
@@ -580,16 +598,11 @@ namespace {
         if (!valid()) return false;
         if (width_ || height_) return true;
 
-        BasicIo &io = image_.io();
-
-        if (io.open() != 0) {
-            throw Error(kerDataSourceOpenFailed, io.path(), strError());
-        }
-        IoCloser closer(io);
-        const Exiv2::byte* base = io.mmap();
+        const DataBuf data = getData();
+        if (data.size() == 0) return false;
 
         try {
-            auto image = ImageFactory::open(base + offset_, size_);
+            auto image = ImageFactory::open(data.c_data(), data.size());
             if (!image)
                 return false;
             image->readMetadata();
@@ -774,23 +787,18 @@ namespace {
         if (dataValue.sizeDataArea() == 0) {
             // image data are not available via exifData, read them from image_.io()
             BasicIo &io = image_.io();
-
-            if (io.open() != 0) {
-                throw Error(kerDataSourceOpenFailed, io.path(), strError());
-            }
-            IoCloser closer(io);
-
-            const Exiv2::byte* base = io.mmap();
+            IoOpener opener(io);
 
             const Value &sizes = preview["Exif.Image." + sizeTag_].value();
 
             if (sizes.count() == dataValue.count()) {
                 if (sizes.count() == 1) {
-                    // this saves one copying of the buffer
                     uint32_t offset = dataValue.toUint32(0);
                     uint32_t size = sizes.toUint32(0);
-                    if (Safe::add(offset, size) <= static_cast<uint32_t>(io.size()))
-                        dataValue.setDataArea(base + offset, size);
+                    if (Safe::add(offset, size) <= static_cast<uint32_t>(io.size())) {
+                        const DataBuf buf = readAt(io, offset, size);
+                        dataValue.setDataArea(buf.c_data(), buf.size());
+                    }
                 }
                 else {
                     // FIXME: the buffer is probably copied twice, it should be optimized
@@ -807,7 +815,9 @@ namespace {
                         // That's why we check again for each step here to really make sure we don't overstep
                         enforce(Safe::add(idxBuf, size) <= size_, kerCorruptedMetadata);
                         if (size!=0 && Safe::add(offset, size) <= static_cast<uint32_t>(io.size())){
-                            buf.copyBytes(idxBuf, base + offset, size);
+                            if (io.readAt(offset, buf.data(idxBuf), static_cast<long>(size)) != static_cast<long>(size)) {
+                                return DataBuf();
+                            }
                         }
 
                         idxBuf += size;
@@ -884,6 +894,26 @@ namespace {
         return valid();
     }
 
+    IoOpener::IoOpener(BasicIo& io) : io_(io), close_(!io.isopen())
+    {
+        if (close_ && io_.open() != 0) {
+            throw Error(kerDataSourceOpenFailed, io_.path(), strError());
+        }
+    }
+
+    IoOpener::~IoOpener()
+    {
+        if (close_) io_.close();
+    }
+
+    DataBuf readAt(BasicIo& io, size_t offset, size_t size)
+    {
+        if (offset > io.size() || size > io.size() - offset) return DataBuf();
+        DataBuf buf(static_cast<long>(size));
+        if (io.readAt(static_cast<int64_t>(offset), buf.data(), buf.size()) != buf.size()) return DataBuf();
+        return buf;
+    }
+
     DataBuf decodeHex(const byte *src, long srcSize)
     {
         // create decoding table
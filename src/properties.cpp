@@ -34,6 +34,8 @@
 #include <cstring>
 #include <cstdlib>
 #include <cctype>
+#include <string_view>
+#include <unordered_map>
 
 // *****************************************************************************
 namespace {
@@ -3914,6 +3916,78 @@ namespace Exiv2 {
         {"Xmp.plus.Reuse",                       EXV_PRINT_VOCABULARY(plusReuse)                      }
     };
 
+    /*!
+      @brief Hash tables for the built-in namespaces in xmpNsInfo and their
+             property lists, built once on first use. Like the linear
+             searches of the tables they replace, the lookups return the
+             first match in table order.
+     */
+    class XmpNsIndex {
+    public:
+        //! Constructor, indexes xmpNsInfo and all property lists
+        XmpNsIndex();
+        //! Return the built-in namespace with prefix \em prefix or nullptr
+        const XmpNsInfo* byPrefix(std::string_view prefix) const;
+        //! Return the built-in namespace with URI \em ns or nullptr
+        const XmpNsInfo* byNs(std::string_view ns) const;
+        //! Return property \em name of the property list \em pl or nullptr
+        const XmpPropertyInfo* property(const XmpPropertyInfo* pl, std::string_view name) const;
+
+    private:
+        //! Type for the properties of one property list
+        typedef std::unordered_map<std::string_view, const XmpPropertyInfo*> PropertyMap;
+
+        std::unordered_map<std::string_view, const XmpNsInfo*> byPrefix_;  //!< Namespaces by prefix
+        std::unordered_map<std::string_view, const XmpNsInfo*> byNs_;      //!< Namespaces by URI
+        std::unordered_map<const XmpPropertyInfo*, PropertyMap> properties_;  //!< Properties by list and name
+
+    }; // class XmpNsIndex
+
+    XmpNsIndex::XmpNsIndex()
+    {
+        for (auto&& xn : xmpNsInfo) {
+            byPrefix_.emplace(xn.prefix_, &xn);
+            byNs_.emplace(xn.ns_, &xn);
+            if (xn.xmpPropertyInfo_ == nullptr || properties_.count(xn.xmpPropertyInfo_) != 0) continue;
+            PropertyMap& properties = properties_[xn.xmpPropertyInfo_];
+            for (const XmpPropertyInfo* pi = xn.xmpPropertyInfo_; pi->name_ != nullptr; ++pi) {
+                properties.emplace(pi->name_, pi);
+            }
+        }
+    }
+
+    const XmpNsInfo* XmpNsIndex::byPrefix(std::string_view prefix) const
+    {
+        auto pos = byPrefix_.find(prefix);
+        return pos == byPrefix_.end() ? nullptr : pos->second;
+    }
+
+    const XmpNsInfo* XmpNsIndex::byNs(std::string_view ns) const
+    {
+        auto pos = byNs_.find(ns);
+        return pos == byNs_.end() ? nullptr : pos->second;
+    }
+
+    const XmpPropertyInfo* XmpNsIndex::property(const XmpPropertyInfo* pl, std::string_view name) const
+    {
+        auto list = properties_.find(pl);
+        if (list == properties_.end()) {
+            for (; pl->name_ != nullptr; ++pl) {
+                if (name == pl->name_) return pl;
+            }
+            return nullptr;
+        }
+        auto pos = list->second.find(name);
+        return pos == list->second.end() ? nullptr : pos->second;
+    }
+
+    //! Return the index of the built-in namespaces
+    const XmpNsIndex& xmpNsIndex()
+    {
+        static const XmpNsIndex index;
+        return index;
+    }
+
     XmpNsInfo::Ns::Ns(std::string ns) : ns_(std::move(ns))
     {
     }
@@ -3924,29 +3998,26 @@ namespace Exiv2 {
 
     bool XmpNsInfo::operator==(const XmpNsInfo::Ns& ns) const
     {
-        std::string n(ns_);
-        return n == ns.ns_;
+        return ns.ns_ == ns_;
     }
 
     bool XmpNsInfo::operator==(const XmpNsInfo::Prefix& prefix) const
     {
-        std::string p(prefix_);
-        return p == prefix.prefix_;
+        return prefix.prefix_ == prefix_;
     }
 
     bool XmpPropertyInfo::operator==(const std::string& name) const
     {
-        std::string n(name_);
-        return n == name;
+        return name == name_;
     }
 
     XmpProperties::NsRegistry XmpProperties::nsRegistry_;
-    std::mutex XmpProperties::mutex_;
+    std::shared_mutex XmpProperties::mutex_;
 
     /// \todo not used internally. At least we should test it
     const XmpNsInfo* XmpProperties::lookupNsRegistry(const XmpNsInfo::Prefix& prefix)
     {
-        std::lock_guard<std::mutex> scoped_read_lock(mutex_);
+        std::shared_lock<std::shared_mutex> scoped_read_lock(mutex_);
         return lookupNsRegistryUnsafe(prefix);
     }
 
@@ -3962,7 +4033,7 @@ namespace Exiv2 {
     void XmpProperties::registerNs(const std::string& ns,
                                    const std::string& prefix)
     {
-        std::lock_guard<std::mutex> scoped_write_lock(mutex_);
+        std::lock_guard<std::shared_mutex> scoped_write_lock(mutex_);
         std::string ns2 = ns;
         if (   ns2.substr(ns2.size() - 1, 1) != "/"
             && ns2.substr(ns2.size() - 1, 1) != "#") ns2 += "/";
@@ -3994,7 +4065,7 @@ namespace Exiv2 {
 
     void XmpProperties::unregisterNs(const std::string& ns)
     {
-        std::lock_guard<std::mutex> scoped_write_lock(mutex_);
+        std::lock_guard<std::shared_mutex> scoped_write_lock(mutex_);
         unregisterNsUnsafe(ns);
     }
 
@@ -4010,7 +4081,7 @@ namespace Exiv2 {
 
     void XmpProperties::unregisterNs()
     {
-        std::lock_guard<std::mutex> scoped_write_lock(mutex_);
+        std::lock_guard<std::shared_mutex> scoped_write_lock(mutex_);
         /// \todo check if we are not unregistering the first NS
         auto i = nsRegistry_.begin();
         while (i != nsRegistry_.end()) {
@@ -4021,18 +4092,18 @@ namespace Exiv2 {
 
     std::string XmpProperties::prefix(const std::string& ns)
     {
-        std::lock_guard<std::mutex> scoped_read_lock(mutex_);
         std::string ns2 = ns;
         if (ns2.substr(ns2.size() - 1, 1) != "/" && ns2.substr(ns2.size() - 1, 1) != "#")
             ns2 += "/";
 
+        std::shared_lock<std::shared_mutex> scoped_read_lock(mutex_);
         auto i = nsRegistry_.find(ns2);
         std::string p;
         if (i != nsRegistry_.end()) {
             p = i->second.prefix_;
         }
         else {
-            const XmpNsInfo* xn = find(xmpNsInfo, XmpNsInfo::Ns(ns2));
+            const XmpNsInfo* xn = xmpNsIndex().byNs(ns2);
             if (xn)
                 p = std::string(xn->prefix_);
         }
@@ -4041,9 +4112,7 @@ namespace Exiv2 {
 
     std::string XmpProperties::ns(const std::string& prefix)
     {
-        std::lock_guard<std::mutex> scoped_read_lock(mutex_);
-        const XmpNsInfo* xn = lookupNsRegistryUnsafe(XmpNsInfo::Prefix(prefix));
-        if (xn != nullptr) return xn->ns_;
+        std::shared_lock<std::shared_mutex> scoped_read_lock(mutex_);
         return nsInfoUnsafe(prefix)->ns_;
     }
 
@@ -4086,14 +4155,7 @@ namespace Exiv2 {
         }
         const XmpPropertyInfo* pl = propertyList(prefix);
         if (!pl) return nullptr;
-        const XmpPropertyInfo* pi = nullptr;
-        for (int j = 0; pl[j].name_ != nullptr; ++j) {
-            if (0 == strcmp(pl[j].name_, property.c_str())) {
-                pi = pl + j;
-                break;
-            }
-        }
-        return pi;
+        return xmpNsIndex().property(pl, property);
     }
 
     /// \todo not used internally. At least we should test it
@@ -4109,15 +4171,14 @@ namespace Exiv2 {
 
     const XmpNsInfo* XmpProperties::nsInfo(const std::string& prefix)
     {
-        std::lock_guard<std::mutex> scoped_read_lock(mutex_);
+        std::shared_lock<std::shared_mutex> scoped_read_lock(mutex_);
         return nsInfoUnsafe(prefix);
     }
 
     const XmpNsInfo* XmpProperties::nsInfoUnsafe(const std::string& prefix)
     {
-        const XmpNsInfo::Prefix pf(prefix);
-        const XmpNsInfo* xn = lookupNsRegistryUnsafe(pf);
-        if (!xn) xn = find(xmpNsInfo, pf);
+        const XmpNsInfo* xn = nsRegistry_.empty() ? nullptr : lookupNsRegistryUnsafe(XmpNsInfo::Prefix(prefix));
+        if (!xn) xn = xmpNsIndex().byPrefix(prefix);
         if (!xn) throw Error(kerNoNamespaceInfoForXmpPrefix, prefix);
         return xn;
     }
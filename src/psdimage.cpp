@@ -150,6 +150,7 @@ namespace Exiv2 {
             throw Error(kerNotAnImage, "Photoshop");
         }
         clearMetadata();
+        exifFiltered_ = !exifFilter_.empty();
 
         /*
           The Photoshop header goes as follows -- all numbers are in big-endian byte order:
@@ -263,7 +264,7 @@ namespace Exiv2 {
                 DataBuf rawExif(resourceSize);
                 io_->read(rawExif.data(), rawExif.size());
                 if (io_->error() || io_->eof()) throw Error(kerFailedToReadImageData);
-                ByteOrder bo = ExifParser::decode(exifData_, rawExif.c_data(), rawExif.size());
+                ByteOrder bo = ExifParser::decode(exifData_, rawExif.c_data(), rawExif.size(), &exifFilter_);
                 setByteOrder(bo);
                 if (rawExif.size() > 0 && byteOrder() == invalidByteOrder) {
 #ifndef SUPPRESS_WARNINGS
@@ -345,12 +346,13 @@ namespace Exiv2 {
 
     void PsdImage::writeMetadata()
     {
+        enforceExifUnfiltered();
         if (io_->open() != 0)
         {
             throw Error(kerDataSourceOpenFailed, io_->path(), strError());
         }
         IoCloser closer(*io_);
-        auto tempIo = std::make_unique<MemIo>();
+        auto tempIo = io_->temporary();
 
         doWriteMetadata(*tempIo); // may throw
         io_->close();
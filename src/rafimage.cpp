@@ -295,6 +295,7 @@ namespace Exiv2 {
         }
 
         clearMetadata();
+        exifFiltered_ = !exifFilter_.empty();
 
         if (io_->seek(84,BasicIo::beg) != 0) throw Error(kerFailedToReadImageData);
         byte jpg_img_offset [4];
@@ -329,7 +330,8 @@ namespace Exiv2 {
                                           iptcData_,
                                           xmpData_,
                                           buf.c_data(),
-                                          buf.size());
+                                          buf.size(),
+                                          &exifFilter_);
 
         exifData_["Exif.Image2.JPEGInterchangeFormat"] = getULong(jpg_img_offset, bigEndian);
         exifData_["Exif.Image2.JPEGInterchangeFormatLength"] = getULong(jpg_img_length, bigEndian);
@@ -367,7 +369,8 @@ namespace Exiv2 {
                                    iptcData_,
                                    xmpData_,
                                    tiff.c_data(),
-                                   tiff.size());
+                                   tiff.size(),
+                                   &exifFilter_);
             }
         }
     } // RafImage::readMetadata
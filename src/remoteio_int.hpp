@@ -0,0 +1,214 @@
+// ***************************************************************** -*- C++ -*-
+/*
+ * Copyright (C) 2004-2021 Exiv2 authors
+ * This program is part of the Exiv2 distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, 5th Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef REMOTEIO_INT_HPP_
+#define REMOTEIO_INT_HPP_
+
+// *****************************************************************************
+// included header files
+#include "basicio.hpp"
+#include "futils.hpp"
+#include "types.hpp"
+
+// + standard includes
+#include <cassert>
+#include <cstring>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+// *****************************************************************************
+// namespace extensions
+namespace Exiv2 {
+
+    /*!
+      @brief Utility class provides the block mapping to the part of data. This avoids allocating
+            a single contiguous block of memory to the big data.
+     */
+    class EXIV2API BlockMap {
+    public:
+        //! the status of the block.
+        enum    blockType_e {bNone, bKnown, bMemory};
+        //! @name Creators
+        //@{
+        //! Default constructor. the init status of the block is bNone.
+        BlockMap() = default;
+
+        //! Destructor. Releases all managed memory.
+        ~BlockMap()
+        {
+            delete [] data_;
+        }
+
+        //! @brief Populate the block.
+        //! @param source The data populate to the block
+        //! @param num The size of data
+        void    populate (const byte* source, size_t num)
+        {
+            assert(source != nullptr);
+            delete [] data_;
+            size_ = num;
+            data_ = new byte [size_];
+            type_ = bMemory;
+            std::memcpy(data_, source, size_);
+        }
+
+        /*!
+          @brief Change the status to bKnow. bKnow blocks do not contain the data,
+                but they keep the size of data. This avoids allocating memory for parts
+                of the file that contain image-date (non-metadata/pixel data) which never change in exiv2.
+          @param num The size of the data
+         */
+        void    markKnown(size_t num)
+        {
+            type_ = bKnown;
+            size_ = num;
+        }
+
+        //! @brief Release the data of the block and change the status back to bNone.
+        void    release()
+        {
+            delete [] data_;
+            data_ = nullptr;
+            size_ = 0;
+            type_ = bNone;
+        }
+
+        bool    isNone() const
+        {
+            return type_ == bNone;
+        }
+
+        bool    isKnown () const
+        {
+            return type_ == bKnown;
+        }
+
+        byte*   getData () const
+        {
+            return data_;
+        }
+
+        size_t  getSize () const
+        {
+            return size_;
+        }
+
+    private:
+        blockType_e type_{bNone};
+        byte* data_{nullptr};
+        size_t size_{0};
+    }; // class BlockMap
+
+    /*!
+      @brief Internal Pimpl abstract structure of class RemoteIo. It is
+             declared here, so that tests can provide a protocol of their own.
+     */
+    class EXIV2API RemoteIo::Impl {
+    public:
+        //! Constructor
+        Impl(const std::string& url, size_t blockSize);
+        //! Destructor. Releases all managed memory.
+        virtual ~Impl();
+
+        // DATA
+        std::string     path_;          //!< (Standard) path
+        size_t          blockSize_;     //!< Size of the block memory.
+        BlockMap*       blocksMap_;     //!< An array contains all blocksMap
+        size_t          size_;          //!< The file size
+        long            idx_;           //!< Index into the memory area
+        bool            isMalloced_;    //!< Was the blocksMap_ allocated?
+        bool            eof_;           //!< EOF indicator
+        Protocol        protocol_;      //!< the protocol of url
+        uint32_t        totalRead_;     //!< bytes requested from host
+        std::list<size_t> lru_;         //!< Cached blocks, the most recently used first
+        std::vector<std::list<size_t>::iterator> lruPos_; //!< Position of each block in lru_, or lru_.end()
+        std::vector<bool> evicted_;     //!< Blocks removed from the cache, fetched again when needed
+        size_t          cached_;        //!< Bytes of the blocks in lru_
+        size_t          nextBlock_;     //!< Block following the last fetched range
+        size_t          readAhead_;     //!< Current number of blocks to read ahead
+
+        // METHODS
+        /*!
+          @brief Get the length (in bytes) of the remote file.
+          @return Return -1 if the size is unknown. Otherwise it returns the length of remote file (in bytes).
+          @throw Error if the server returns the error code.
+         */
+        virtual long getFileLength() = 0;
+        /*!
+          @brief Get the data by range.
+          @param lowBlock The start block index.
+          @param highBlock The end block index.
+          @param response The data from the server.
+          @throw Error if the server returns the error code.
+          @note Set lowBlock = -1 and highBlock = -1 to get the whole file content.
+         */
+        virtual void getDataByRange(long lowBlock, long highBlock, std::string& response) = 0;
+        /*!
+          @brief Get the data of several ranges of blocks. The default implementation calls
+                getDataByRange() for each of them.
+          @param ranges The start and end block index of each range.
+          @param responses The data from the server for each range.
+          @throw Error if the server returns the error code.
+         */
+        virtual void getDataByRanges(const std::vector<std::pair<size_t, size_t>>& ranges,
+                                     std::vector<std::string>& responses);
+        /*!
+          @brief Submit the data to the remote machine. The data replace a part of the remote file.
+                The replaced part of remote file is indicated by from and to parameters.
+          @param data The data are submitted to the remote machine.
+          @param size The size of data.
+          @param from The start position in the remote file where the data replace.
+          @param to The end position in the remote file where the data replace.
+          @note The write access is available on some protocols. HTTP and HTTPS require the script file
+                on the remote machine to handle the data. SSH requires the permission to edit the file.
+          @throw Error if it fails.
+         */
+        virtual void writeRemote(const byte* data, size_t size, long from, long to) = 0;
+        /*!
+          @brief Get the data from the remote machine and write them to the memory blocks.
+          @param lowBlock The start block index.
+          @param highBlock The end block index.
+          @return Number of bytes written to the memory block successfully
+          @throw Error if it fails.
+         */
+        virtual size_t populateBlocks(size_t lowBlock, size_t highBlock);
+        /*!
+          @brief Return true if getDataByRange() may be called from several threads at
+                the same time. RemoteIo then sends its read-ahead requests concurrently.
+         */
+        virtual bool canFetchConcurrently() const { return false; }
+        //! Allocate the block map for a file of size_ bytes.
+        void allocBlocks();
+        //! Copy the data returned by getDataByRange() for the range starting at \em lowBlock to the blocks.
+        void fillBlocks(size_t lowBlock, const std::string& data);
+        //! Mark \em block as the most recently used block.
+        void touchBlock(size_t block);
+        /*!
+          @brief Release the least recently used blocks until the cache fits into
+                remoteCacheSize(). Blocks from \em lowBlock to \em highBlock are kept.
+         */
+        void evictBlocks(size_t lowBlock, size_t highBlock);
+
+    }; // class RemoteIo::Impl
+
+}                                       // namespace Exiv2
+
+#endif                                  // #ifndef REMOTEIO_INT_HPP_
@@ -119,8 +119,10 @@ namespace Exiv2 {
             throw Error(kerNotAnImage, "RW2");
         }
         clearMetadata();
+        exifFiltered_ = !exifFilter_.empty();
         ByteOrder bo =
-            Rw2Parser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), static_cast<uint32_t>(io_->size()));
+            Rw2Parser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), static_cast<uint32_t>(io_->size()),
+                              &exifFilter_);
         setByteOrder(bo);
 
         // A lot more metadata is hidden in the embedded preview image
@@ -216,11 +218,12 @@ namespace Exiv2 {
     } // Rw2Image::writeMetadata
 
     ByteOrder Rw2Parser::decode(
-              ExifData& exifData,
-              IptcData& iptcData,
-              XmpData&  xmpData,
-        const byte*     pData,
-              uint32_t  size
+              ExifData&   exifData,
+              IptcData&   iptcData,
+              XmpData&    xmpData,
+        const byte*       pData,
+              uint32_t    size,
+        const ExifFilter* pFilter
     )
     {
         Rw2Header rw2Header;
@@ -231,7 +234,8 @@ namespace Exiv2 {
                                         size,
                                         Tag::pana,
                                         TiffMapping::findDecoder,
-                                        &rw2Header);
+                                        &rw2Header,
+                                        pFilter);
     }
 
     // *************************************************************************
@@ -48,6 +48,9 @@
 #include <cassert>
 #include <cmath>
 #include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 // *****************************************************************************
 // class member definitions
@@ -227,6 +230,8 @@ namespace Exiv2 {
 
         // DATA
         static constexpr auto familyName_ = "Exif";  //!< "Exif"
+        //! Maximum number of decomposed key strings remembered by decomposeKey()
+        static constexpr size_t maxDecomposedKeys_ = 4096;
 
         const TagInfo* tagInfo_{nullptr};  //!< Tag info
         uint16_t tag_{0};               //!< Tag value
@@ -249,6 +254,20 @@ namespace Exiv2 {
 
     void ExifKey::Impl::decomposeKey(const std::string& key)
     {
+        // Parsing a key involves linear searches of the group and tag
+        // tables. The same keys are created over and over again, so the
+        // results are remembered.
+        static std::shared_mutex mutex;
+        static std::unordered_map<std::string, Impl> decomposedKeys;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            auto pos = decomposedKeys.find(key);
+            if (pos != decomposedKeys.end()) {
+                *this = pos->second;
+                return;
+            }
+        }
+
         // Get the family name, IFD name and tag name parts of the key
         std::string::size_type pos1 = key.find('.');
         if (pos1 == std::string::npos) throw Error(kerInvalidKey, key);
@@ -282,6 +301,11 @@ namespace Exiv2 {
         groupName_ = groupName;
         // tagName() translates hex tag name (0xabcd) to a real tag name if there is one
         key_ = familyName + "." + groupName + "." + tagName();
+
+        std::lock_guard<std::shared_mutex> lock(mutex);
+        if (decomposedKeys.size() < maxDecomposedKeys_) {
+            decomposedKeys.emplace(key, *this);
+        }
     }
 
     void ExifKey::Impl::makeKey(uint16_t tag, IfdId ifdId, const TagInfo* tagInfo)
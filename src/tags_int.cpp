@@ -41,6 +41,9 @@
 
 #include <cmath>
 #include <algorithm>
+#include <cstring>
+#include <map>
+#include <vector>
 
 // *****************************************************************************
 // local declarations
@@ -188,6 +191,100 @@ namespace Exiv2 {
         { lastId,          "(Last IFD info)", "(Last IFD item)", nullptr }
     };
 
+    //! Lookup structures for one tag list
+    struct TagListIndex {
+        const TagInfo* end_;                    //!< End of list marker of the tag list
+        std::vector<const TagInfo*> byTag_;     //!< Tags, sorted by tag number
+        std::vector<const TagInfo*> byName_;    //!< Tags, sorted by name
+    };
+
+    /*!
+      @brief Lookup structures for the groups in groupInfo and their tag
+             lists, built once on first use. Like the linear searches of the
+             tables they replace, the lookups return the first match in table
+             order.
+     */
+    class GroupIndex {
+    public:
+        //! Constructor, indexes groupInfo and all tag lists
+        GroupIndex();
+        //! Return the group with IFD id \em ifdId or nullptr
+        const GroupInfo* group(IfdId ifdId) const;
+        //! Return the group named \em groupName or nullptr
+        const GroupInfo* group(const std::string& groupName) const;
+        //! Return the index of the tag list of the group \em ifdId or nullptr
+        const TagListIndex* tags(IfdId ifdId) const;
+
+    private:
+        std::vector<const GroupInfo*> byId_;          //!< Groups, indexed by IFD id
+        std::vector<const GroupInfo*> byName_;        //!< Groups, sorted by name
+        std::vector<const TagListIndex*> tagsById_;   //!< Tag list indexes, indexed by IFD id
+        std::map<const TagInfo*, TagListIndex> tagLists_;  //!< Indexes of all tag lists
+
+    }; // class GroupIndex
+
+    GroupIndex::GroupIndex()
+        : byId_(lastId + 1, nullptr), tagsById_(lastId + 1, nullptr)
+    {
+        for (auto&& gi : groupInfo) {
+            if (gi.ifdId_ < 0 || gi.ifdId_ > lastId || byId_[gi.ifdId_] != nullptr) continue;
+            byId_[gi.ifdId_] = &gi;
+            byName_.push_back(&gi);
+            if (gi.tagList_ == nullptr) continue;
+
+            const TagInfo* tagList = gi.tagList_();
+            auto pos = tagLists_.find(tagList);
+            if (pos == tagLists_.end()) {
+                TagListIndex index;
+                const TagInfo* ti = tagList;
+                for (; ti->tag_ != 0xffff; ++ti) {
+                    index.byTag_.push_back(ti);
+                }
+                index.end_ = ti;
+                index.byName_ = index.byTag_;
+                std::stable_sort(index.byTag_.begin(), index.byTag_.end(),
+                                 [](const TagInfo* lhs, const TagInfo* rhs) { return lhs->tag_ < rhs->tag_; });
+                std::stable_sort(index.byName_.begin(), index.byName_.end(), [](const TagInfo* lhs, const TagInfo* rhs) {
+                    return strcmp(lhs->name_, rhs->name_) < 0;
+                });
+                pos = tagLists_.emplace(tagList, std::move(index)).first;
+            }
+            tagsById_[gi.ifdId_] = &pos->second;
+        }
+        std::stable_sort(byName_.begin(), byName_.end(), [](const GroupInfo* lhs, const GroupInfo* rhs) {
+            return strcmp(lhs->groupName_, rhs->groupName_) < 0;
+        });
+    }
+
+    const GroupInfo* GroupIndex::group(IfdId ifdId) const
+    {
+        if (ifdId < 0 || ifdId > lastId) return nullptr;
+        return byId_[ifdId];
+    }
+
+    const GroupInfo* GroupIndex::group(const std::string& groupName) const
+    {
+        const char* gn = groupName.c_str();
+        auto pos = std::lower_bound(byName_.begin(), byName_.end(), gn, [](const GroupInfo* gi, const char* name) {
+            return strcmp(gi->groupName_, name) < 0;
+        });
+        if (pos == byName_.end() || strcmp((*pos)->groupName_, gn) != 0) return nullptr;
+        return *pos;
+    }
+
+    const TagListIndex* GroupIndex::tags(IfdId ifdId) const
+    {
+        if (ifdId < 0 || ifdId > lastId) return nullptr;
+        return tagsById_[ifdId];
+    }
+
+    //! Return the lookup structures for groupInfo
+    const GroupIndex& groupIndex()
+    {
+        static const GroupIndex index;
+        return index;
+    }
+
     //! Units for measuring X and Y resolution, tags 0x0128, 0xa210
     constexpr TagDetails exifUnit[] = {
         { 1, N_("none") },
@@ -2491,7 +2588,7 @@ namespace Exiv2 {
     bool isMakerIfd(IfdId ifdId)
     {
         bool rc = false;
-        const GroupInfo* ii = find(groupInfo, ifdId);
+        const GroupInfo* ii = groupIndex().group(ifdId);
         if (ii != nullptr && 0 == strcmp(ii->ifdName_, "Makernote")) {
             rc = true;
         }
@@ -2538,54 +2635,51 @@ namespace Exiv2 {
 
     const TagInfo* tagList(IfdId ifdId)
     {
-        const GroupInfo* ii = find(groupInfo, ifdId);
+        const GroupInfo* ii = groupIndex().group(ifdId);
         if (ii == nullptr || ii->tagList_ == nullptr) return nullptr;
         return ii->tagList_();
     } // tagList
 
     const TagInfo* tagInfo(uint16_t tag, IfdId ifdId)
     {
-        const TagInfo* ti = tagList(ifdId);
-        if (ti == nullptr) return nullptr;
-        int idx = 0;
-        for (idx = 0; ti[idx].tag_ != 0xffff; ++idx) {
-            if (ti[idx].tag_ == tag) break;
-        }
-        return &ti[idx];
+        const TagListIndex* index = groupIndex().tags(ifdId);
+        if (index == nullptr) return nullptr;
+        auto pos = std::lower_bound(index->byTag_.begin(), index->byTag_.end(), tag,
+                                    [](const TagInfo* ti, uint16_t t) { return ti->tag_ < t; });
+        if (pos == index->byTag_.end() || (*pos)->tag_ != tag) return index->end_;
+        return *pos;
     } // tagInfo
 
     const TagInfo* tagInfo(const std::string& tagName, IfdId ifdId)
     {
-        const TagInfo* ti = tagList(ifdId);
-        if (ti == nullptr) return nullptr;
+        const TagListIndex* index = groupIndex().tags(ifdId);
+        if (index == nullptr) return nullptr;
         if (tagName.empty()) return nullptr;
         const char* tn = tagName.c_str();
-        for (int idx = 0; ti[idx].tag_ != 0xffff; ++idx) {
-            if (0 == strcmp(ti[idx].name_, tn)) {
-                return &ti[idx];
-            }
-        }
-        return nullptr;
+        auto pos = std::lower_bound(index->byName_.begin(), index->byName_.end(), tn,
+                                    [](const TagInfo* ti, const char* name) { return strcmp(ti->name_, name) < 0; });
+        if (pos == index->byName_.end() || strcmp((*pos)->name_, tn) != 0) return nullptr;
+        return *pos;
     } // tagInfo
 
     IfdId groupId(const std::string& groupName)
     {
         IfdId ifdId = ifdIdNotSet;
-        const GroupInfo* ii = find(groupInfo, GroupInfo::GroupName(groupName));
+        const GroupInfo* ii = groupIndex().group(groupName);
         if (ii != nullptr) ifdId = static_cast<IfdId>(ii->ifdId_);
         return ifdId;
     }
 
     const char* ifdName(IfdId ifdId)
     {
-        const GroupInfo* ii = find(groupInfo, ifdId);
+        const GroupInfo* ii = groupIndex().group(ifdId);
         if (ii == nullptr) return groupInfo[0].ifdName_;
         return ii->ifdName_;
     }
 
     const char* groupName(IfdId ifdId)
     {
-        const GroupInfo* ii = find(groupInfo, ifdId);
+        const GroupInfo* ii = groupIndex().group(ifdId);
         if (ii == nullptr) return groupInfo[0].groupName_;
         return ii->groupName_;
     }
@@ -3308,7 +3402,7 @@ namespace Exiv2 {
 
     const TagInfo* tagList(const std::string& groupName)
     {
-        const GroupInfo* ii = find(groupInfo, GroupInfo::GroupName(groupName));
+        const GroupInfo* ii = groupIndex().group(groupName);
         if (ii == nullptr || ii->tagList_ == nullptr) {
             return nullptr;
         }
@@ -24,6 +24,11 @@
 // included header files
 #include "tags.hpp"
 
+// + standard includes
+#include <algorithm>
+#include <array>
+#include <utility>
+
 // *****************************************************************************
 // namespace extensions
 
@@ -253,6 +258,64 @@ namespace Exiv2 {
         bool operator==(const std::string& key) const;
     }; // struct TagDetails
 
+    //! Tables of TagDetails with fewer entries than this are searched linearly
+    constexpr int tagDetailsLinearSearchMax = 32;
+
+    /*!
+      @brief Return pointers to the entries of a TagDetails table, sorted by value.
+
+      Entries with the same value keep the order they have in the table. The index
+      is built once, on the first call for each table.
+     */
+    template <int N, const TagDetails (&array)[N]>
+    const std::array<const TagDetails*, N>& sortedTagDetails()
+    {
+        static const auto index = [] {
+            std::array<const TagDetails*, N> idx{};
+            for (int i = 0; i < N; ++i) {
+                idx[i] = array + i;
+            }
+            std::stable_sort(idx.begin(), idx.end(),
+                             [](const TagDetails* a, const TagDetails* b) { return a->val_ < b->val_; });
+            return idx;
+        }();
+        return index;
+    }
+
+    /*!
+      @brief Return the entries of a TagDetails table with the value \em value, in
+             table order, as a range of the index returned by sortedTagDetails().
+     */
+    template <int N, const TagDetails (&array)[N]>
+    std::pair<const TagDetails* const*, const TagDetails* const*> findTagDetailsRange(int64_t value)
+    {
+        const auto& index = sortedTagDetails<N, array>();
+        struct Compare {
+            bool operator()(const TagDetails* td, int64_t val) const { return td->val_ < val; }
+            bool operator()(int64_t val, const TagDetails* td) const { return val < td->val_; }
+        };
+        return std::equal_range(index.data(), index.data() + N, value, Compare());
+    }
+
+    /*!
+      @brief Return the first entry of a TagDetails table with the value \em value,
+             or 0 if there is none. Same result as find(array, value), but large
+             tables are searched with a binary search.
+     */
+    template <int N, const TagDetails (&array)[N]>
+    const TagDetails* findTagDetails(int64_t value)
+    {
+        if constexpr (N < tagDetailsLinearSearchMax) {
+            return find(array, value);
+        }
+        else {
+            const auto& index = sortedTagDetails<N, array>();
+            auto pos = std::lower_bound(index.begin(), index.end(), value,
+                                        [](const TagDetails* td, int64_t val) { return td->val_ < val; });
+            return pos != index.end() && (*pos)->val_ == value ? *pos : nullptr;
+        }
+    }
+
     /*!
       @brief Generic pretty-print function to translate a long value to a description
              by looking up a reference table.
@@ -260,7 +323,7 @@ namespace Exiv2 {
     template <int N, const TagDetails (&array)[N]>
     std::ostream& printTag(std::ostream& os, const int64_t value, const ExifData*)
     {
-        const TagDetails* td = find(array, value);
+        const TagDetails* td = findTagDetails<N, array>(value);
         if (td) {
             os << exvGettext(td->label_);
         }
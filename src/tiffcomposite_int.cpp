@@ -32,10 +32,13 @@
 
 // + standard includes
 #include <string>
+#include <cstddef>
 #include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <atomic>
+#include <vector>
 
 // *****************************************************************************
 namespace {
@@ -57,7 +60,7 @@ namespace Exiv2 {
     }
 
     IoWrapper::IoWrapper(BasicIo& io, const byte* pHeader, long size, OffsetWriter* pow)
-        : io_(io), pHeader_(pHeader), size_(size), wroteHeader_(false), pow_(pow)
+        : io_(io), pHeader_(pHeader), size_(size), wroteHeader_(false), pow_(pow), pKept_(nullptr), keptSize_(0)
     {
         if (pHeader_ == nullptr || size_ == 0)
             wroteHeader_ = true;
@@ -89,7 +92,122 @@ namespace Exiv2 {
         if (pow_) pow_->setTarget(OffsetWriter::OffsetId(id), static_cast<uint32_t>(target));
     }
 
-    TiffComponent::TiffComponent(uint16_t tag, IfdId group) : tag_(tag), group_(group), pStart_(nullptr)
+    void IoWrapper::keepImageData(const byte* pData, uint32_t size)
+    {
+        pKept_ = pData;
+        keptSize_ = size;
+    }
+
+    bool IoWrapper::keepsData(const byte* pData, uint32_t size) const
+    {
+        return    pKept_ != nullptr && pData != nullptr
+               && pData >= pKept_ && static_cast<uint32_t>(pData - pKept_) <= keptSize_
+               && size <= keptSize_ - static_cast<uint32_t>(pData - pKept_);
+    }
+
+    uint32_t IoWrapper::keptOffset(const byte* pData) const
+    {
+        return static_cast<uint32_t>(pData - pKept_);
+    }
+
+    /*!
+      @brief The arena of TiffArena. Each allocation is preceded by a header
+             with a pointer to the arena it was allocated from, or 0 if it was
+             allocated from the heap. The arena is reference counted: the
+             scope that installed it and each allocation hold a reference.
+     */
+    class TiffArena::Impl {
+    public:
+        //! Size of the blocks of the arena
+        static constexpr std::size_t blockSize_ = 32 * 1024;
+        //! Size of the header of an allocation, keeps the allocation aligned
+        static constexpr std::size_t headerSize_ = alignof(std::max_align_t);
+
+        //! Return \em size bytes from the current block, or 0 if \em size is too large
+        char* allocate(std::size_t size);
+        //! Add a reference to the arena
+        void addRef() { ++refs_; }
+        //! Drop a reference to the arena, delete the arena with the last one
+        void release() { if (refs_.fetch_sub(1) == 1) delete this; }
+
+        static thread_local Impl* current_;     //!< Arena of the current thread
+
+    private:
+        std::vector<std::unique_ptr<char[]>> blocks_;  //!< Blocks of the arena
+        char* next_ = nullptr;                          //!< Next free byte of the current block
+        std::size_t left_ = 0;                          //!< Free bytes of the current block
+        std::atomic<std::size_t> refs_{1};              //!< Reference count
+    }; // class TiffArena::Impl
+
+    thread_local TiffArena::Impl* TiffArena::Impl::current_ = nullptr;
+
+    char* TiffArena::Impl::allocate(std::size_t size)
+    {
+        // Large objects would waste too much of a block
+        if (size > blockSize_ / 4) return nullptr;
+        if (size > left_) {
+            blocks_.emplace_back(new char[blockSize_]);
+            next_ = blocks_.back().get();
+            left_ = blockSize_;
+        }
+        char* p = next_;
+        next_ += size;
+        left_ -= size;
+        return p;
+    }
+
+    TiffArena::Scope::Scope() : pImpl_(nullptr)
+    {
+        if (Impl::current_ == nullptr) {
+            pImpl_ = new Impl;
+            Impl::current_ = pImpl_;
+        }
+    }
+
+    TiffArena::Scope::~Scope()
+    {
+        if (pImpl_ != nullptr) {
+            Impl::current_ = nullptr;
+            pImpl_->release();
+        }
+    }
+
+    void* TiffArena::allocate(std::size_t size)
+    {
+        const std::size_t h = Impl::headerSize_;
+        Impl* arena = Impl::current_;
+        char* p = nullptr;
+        if (arena != nullptr) {
+            p = arena->allocate(h + (size + h - 1) / h * h);
+        }
+        if (p != nullptr) {
+            arena->addRef();
+        }
+        else {
+            p = static_cast<char*>(::operator new(h + size));
+            arena = nullptr;
+        }
+        std::memcpy(p, &arena, sizeof(arena));
+        return p + h;
+    }
+
+    void TiffArena::deallocate(void* p)
+    {
+        if (p == nullptr) return;
+        char* block = static_cast<char*>(p) - Impl::headerSize_;
+        Impl* arena = nullptr;
+        std::memcpy(&arena, block, sizeof(arena));
+        if (arena != nullptr) {
+            arena->release();
+        }
+        else {
+            ::operator delete(block);
+        }
+    }
+
+    TiffComponent::TiffComponent(uint16_t tag, IfdId group)
+        : tag_(tag), group_(group), pStart_(nullptr),
+          sizeCache_(0), cachedSize_(0), cachedSizeData_(0), cachedSizeImage_(0)
     {
     }
 
@@ -1296,7 +1414,13 @@ namespace Exiv2 {
         DataBuf buf(static_cast<long>(strips_.size()) * 4);
         buf.clear();
         uint32_t idx = 0;
+        const bool keep = keepsImage(ioWrapper);
         for (auto&& strip : strips_) {
+            if (keep) {
+                // Point to the image data where it is
+                idx += writeOffset(buf.data(idx), ioWrapper.keptOffset(strip.first), tiffType(), byteOrder);
+                continue;
+            }
             idx += writeOffset(buf.data(idx), o2, tiffType(), byteOrder);
             o2 += strip.second;
             o2 += strip.second & 1;             // Align strip data to word boundary
@@ -1309,6 +1433,15 @@ namespace Exiv2 {
         return buf.size();
     } // TiffImageEntry::doWrite
 
+    bool TiffImageEntry::keepsImage(const IoWrapper& ioWrapper) const
+    {
+        // Image data in makernotes or in a data area of the value is always written
+        if (group() > mnId || !pValue() || pValue()->sizeDataArea() > 0 || strips_.empty()) return false;
+        return std::all_of(strips_.begin(), strips_.end(), [&ioWrapper](const Strips::value_type& strip) {
+            return ioWrapper.keepsData(strip.first, strip.second);
+        });
+    } // TiffImageEntry::keepsImage
+
     uint32_t TiffSubIfd::doWrite(IoWrapper& ioWrapper,
                                  ByteOrder byteOrder,
                                  int64_t   offset,
@@ -1588,6 +1721,7 @@ namespace Exiv2 {
                                           ByteOrder  /*byteOrder*/) const
     {
         if ( !pValue() ) throw Error(kerImageWriteFailed); // #1296
+        if (keepsImage(ioWrapper)) return 0;
 
         uint32_t len = pValue()->sizeDataArea();
         if (len > 0) {
@@ -1625,9 +1759,20 @@ namespace Exiv2 {
         return len;
     } // TiffImageEntry::doWriteImage
 
+    void TiffComponent::cacheSizes(bool enable)
+    {
+        sizeCache_ = enable ? scEnabled : 0;
+    } // TiffComponent::cacheSizes
+
     uint32_t TiffComponent::size() const
     {
-        return doSize();
+        if (sizeCache_ & scSize) return cachedSize_;
+        uint32_t len = doSize();
+        if (sizeCache_ & scEnabled) {
+            cachedSize_ = len;
+            sizeCache_ |= scSize;
+        }
+        return len;
     } // TiffComponent::size
 
     uint32_t TiffDirectory::doSize() const
@@ -1722,7 +1867,13 @@ namespace Exiv2 {
 
     uint32_t TiffComponent::sizeData() const
     {
-        return doSizeData();
+        if (sizeCache_ & scSizeData) return cachedSizeData_;
+        uint32_t len = doSizeData();
+        if (sizeCache_ & scEnabled) {
+            cachedSizeData_ = len;
+            sizeCache_ |= scSizeData;
+        }
+        return len;
     } // TiffComponent::sizeData
 
     uint32_t TiffDirectory::doSizeData() const
@@ -1769,7 +1920,13 @@ namespace Exiv2 {
 
     uint32_t TiffComponent::sizeImage() const
     {
-        return doSizeImage();
+        if (sizeCache_ & scSizeImage) return cachedSizeImage_;
+        uint32_t len = doSizeImage();
+        if (sizeCache_ & scEnabled) {
+            cachedSizeImage_ = len;
+            sizeCache_ |= scSizeImage;
+        }
+        return len;
     } // TiffComponent::sizeImage
 
     uint32_t TiffDirectory::doSizeImage() const
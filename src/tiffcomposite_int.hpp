@@ -143,6 +143,20 @@ namespace Exiv2 {
         int putb(byte data);
         //! Wrapper for OffsetWriter::setTarget(), using an int instead of the enum to reduce include deps
         void setTarget(int id, int64_t target);
+        /*!
+          @brief Don't write image data which is in the TIFF data \em pData of
+                 length \em size, refer to it at its offset in \em pData.
+                 The written structure must be placed in the same file.
+         */
+        void keepImageData(const byte* pData, uint32_t size);
+        //@}
+
+        //! @name Accessors
+        //@{
+        //! Return true if the \em size bytes at \em pData are kept where they are
+        bool keepsData(const byte* pData, uint32_t size) const;
+        //! Return the offset of the kept data at \em pData
+        uint32_t keptOffset(const byte* pData) const;
         //@}
 
     private:
@@ -152,8 +166,50 @@ namespace Exiv2 {
         long size_;                //! Size of the header data.
         bool wroteHeader_;         //! Indicates if the header has been written.
         OffsetWriter* pow_;        //! Pointer to an offset-writer, if any, or 0
+        const byte* pKept_;        //! TIFF data with image data which is not written, or 0
+        uint32_t keptSize_;        //! Size of the TIFF data with image data which is not written
     }; // class IoWrapper
 
+    /*!
+      @brief Memory arena for the components of TIFF composites.
+
+      Components are allocated with a bump pointer from large blocks of the
+      arena of the current thread, if there is one, and from the heap
+      otherwise. An arena is installed for the lifetime of a TiffArena::Scope.
+      It is released in one step when the scope has ended and the last
+      component allocated from it is deleted, so a composite can outlive the
+      scope it was built in. The memory of deleted components is not reused
+      before that.
+     */
+    class TiffArena {
+        class Impl;
+
+    public:
+        /*!
+          @brief Install an arena for the current thread, unless one is
+                 already installed, until the object is destroyed.
+         */
+        class Scope {
+        public:
+            //! Constructor, installs a new arena if there is none
+            Scope();
+            //! Destructor, uninstalls the arena installed by the constructor
+            ~Scope();
+            //! Not copyable
+            Scope(const Scope&) = delete;
+            //! Not assignable
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            Impl* pImpl_;           //!< The arena installed by this scope, or 0
+        }; // class TiffArena::Scope
+
+        //! Allocate \em size bytes from the arena of the current thread, if any
+        static void* allocate(std::size_t size);
+        //! Release memory returned by allocate()
+        static void deallocate(void* p);
+    }; // class TiffArena
+
     /*!
       @brief Interface class for components of a TIFF directory hierarchy
              (Composite pattern).  Both TIFF directories as well as entries
@@ -175,6 +231,10 @@ namespace Exiv2 {
         TiffComponent(uint16_t tag, IfdId group);
         //! Virtual destructor.
         virtual ~TiffComponent() = default;
+        //! Allocate the component with TiffArena
+        static void* operator new(std::size_t size) { return TiffArena::allocate(size); }
+        //! Release a component allocated with TiffArena
+        static void operator delete(void* p) { TiffArena::deallocate(p); }
         //@}
 
         //! @name Manipulators
@@ -241,6 +301,16 @@ namespace Exiv2 {
                        uint32_t  valueIdx,
                        uint32_t  dataIdx,
                        uint32_t& imageIdx);
+        /*!
+          @brief Enable or disable caching of the values returned by size(),
+                 sizeData() and sizeImage(). Any cached values are discarded.
+
+          Writing a directory asks each of its components for their sizes
+          several times and the sizes of nested directories are the sums of
+          the sizes of their components. While the composite is written, its
+          sizes don't change and can be computed once. See TiffSizeCacher.
+         */
+        void cacheSizes(bool enable);
         //@}
 
         //! @name Accessors
@@ -361,6 +431,18 @@ namespace Exiv2 {
          */
         byte*    pStart_;
 
+        //! Flags for the size cache, see cacheSizes()
+        enum SizeCacheFlags {
+            scEnabled   = 1,            //!< Caching is enabled
+            scSize      = 2,            //!< cachedSize_ is valid
+            scSizeData  = 4,            //!< cachedSizeData_ is valid
+            scSizeImage = 8             //!< cachedSizeImage_ is valid
+        };
+        mutable uint8_t  sizeCache_;        //!< Size cache flags
+        mutable uint32_t cachedSize_;       //!< Cached result of size()
+        mutable uint32_t cachedSizeData_;   //!< Cached result of sizeData()
+        mutable uint32_t cachedSizeImage_;  //!< Cached result of sizeImage()
+
     }; // class TiffComponent
 
     //! TIFF mapping table for functions to decode special cases
@@ -801,6 +883,9 @@ namespace Exiv2 {
         //! Pointers to the image data (strips) and their sizes.
         using Strips = std::vector<std::pair<const byte*, uint32_t>>;
 
+        //! Return true if the image data is kept where it is, see IoWrapper::keepImageData()
+        bool keepsImage(const IoWrapper& ioWrapper) const;
+
         // DATA
         Strips   strips_;       //!< Image strips data (never alloc'd) and sizes
 
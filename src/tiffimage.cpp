@@ -185,9 +185,11 @@ namespace Exiv2 {
             throw Error(kerNotAnImage, "TIFF");
         }
         clearMetadata();
+        exifFiltered_ = !exifFilter_.empty();
 
         ByteOrder bo =
-            TiffParser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), static_cast<uint32_t>(io_->size()));
+            TiffParser::decode(exifData_, iptcData_, xmpData_, io_->mmap(), static_cast<uint32_t>(io_->size()),
+                               &exifFilter_);
         setByteOrder(bo);
 
         // read profile from the metadata
@@ -209,6 +211,7 @@ namespace Exiv2 {
 #ifdef EXIV2_DEBUG_MESSAGES
         std::cerr << "Writing TIFF file " << io_->path() << "\n";
 #endif
+        enforceExifUnfiltered();
         ByteOrder bo = byteOrder();
         byte* pData = nullptr;
         long size = 0;
@@ -244,15 +247,17 @@ namespace Exiv2 {
         // set usePacket to influence TiffEncoder::encodeXmp() called by TiffVisitor.encode()
         xmpData().usePacket(writeXmpFromPacket());
 
-        TiffParser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_); // may throw
+        writeMethod_ = TiffParser::encode(*io_, pData, size, bo, exifData_, iptcData_, xmpData_,
+                                          appendMetadata()); // may throw
     } // TiffImage::writeMetadata
 
     ByteOrder TiffParser::decode(
-              ExifData& exifData,
-              IptcData& iptcData,
-              XmpData&  xmpData,
-        const byte*     pData,
-              uint32_t  size
+              ExifData&   exifData,
+              IptcData&   iptcData,
+              XmpData&    xmpData,
+        const byte*       pData,
+              uint32_t    size,
+        const ExifFilter* pFilter
     )
     {
         uint32_t root = Tag::root;
@@ -271,7 +276,9 @@ namespace Exiv2 {
                                         pData,
                                         size,
                                         root,
-                                        TiffMapping::findDecoder);
+                                        TiffMapping::findDecoder,
+                                        nullptr,
+                                        pFilter);
     } // TiffParser::decode
 
     WriteMethod TiffParser::encode(
@@ -281,7 +288,8 @@ namespace Exiv2 {
               ByteOrder byteOrder,
         const ExifData& exifData,
         const IptcData& iptcData,
-        const XmpData&  xmpData
+        const XmpData&  xmpData,
+              bool      append
     )
     {
         // Copy to be able to modify the Exif data
@@ -300,7 +308,7 @@ namespace Exiv2 {
 
         std::unique_ptr<TiffHeaderBase> header(new TiffHeader(byteOrder));
         return TiffParserWorker::encode(io, pData, size, ed, iptcData, xmpData, Tag::root, TiffMapping::findEncoder,
-                                        header.get(), nullptr);
+                                        header.get(), nullptr, append);
     } // TiffParser::encode
 
     // *************************************************************************
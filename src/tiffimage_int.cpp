@@ -19,6 +19,7 @@
  */
 
 #include "tiffimage_int.hpp"
+#include "basicio.hpp"
 #include "error.hpp"
 #include "makernote_int.hpp"
 #include "sonymn_int.hpp"
@@ -26,7 +27,13 @@
 #include "tiffvisitor_int.hpp"
 #include "i18n.h"                // NLS support.
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 // Shortcuts for the newTiffBinaryArray templates.
 #define EXV_BINARY_ARRAY(arrayCfg, arrayDef) (newTiffBinaryArray0<&arrayCfg, EXV_COUNTOF(arrayDef), arrayDef>)
@@ -2003,11 +2010,100 @@ namespace Exiv2 {
         return key.r_ == root_ && key.g_ == group_;
     }
 
+    /*!
+      @brief Lookup structures for tiffGroupStruct_ and tiffTreeStruct_, built
+             once on first use. Like the linear searches of the tables they
+             replace, the lookups return the first match in table order.
+     */
+    class TiffCreator::Index {
+    public:
+        //! Constructor, indexes tiffGroupStruct_ and tiffTreeStruct_
+        Index();
+        //! Return the entry of tiffGroupStruct_ for \em extendedTag and \em group or nullptr
+        const TiffGroupStruct* groupStruct(uint32_t extendedTag, IfdId group) const;
+        /*!
+          @brief Return the path from the parent of \em group up to the root
+                 of the tree \em root, in the order getPath() pushes it, or
+                 nullptr if the tree doesn't contain \em group.
+         */
+        const std::vector<TiffPathItem>* parents(uint32_t root, IfdId group) const;
+
+    private:
+        //! Entries of tiffGroupStruct_ for one group
+        struct Group {
+            const TiffGroupStruct* all_ = nullptr;                        //!< Entry for Tag::all
+            std::unordered_map<uint32_t, const TiffGroupStruct*> tags_;  //!< Entries by extended tag
+        };
+        //! Return the key of group \em group in the tree \em root
+        static uint64_t treeKey(uint32_t root, IfdId group)
+        {
+            return static_cast<uint64_t>(root) << 32 | static_cast<uint32_t>(group);
+        }
+
+        std::vector<Group> groups_;                                            //!< Groups, indexed by IFD id
+        std::unordered_map<uint64_t, std::vector<TiffPathItem>> parents_;     //!< Paths by tree and group
+
+    }; // class TiffCreator::Index
+
+    TiffCreator::Index::Index() : groups_(lastId + 1)
+    {
+        for (auto&& ts : tiffGroupStruct_) {
+            if (ts.group_ < 0 || ts.group_ > lastId) continue;
+            Group& group = groups_[ts.group_];
+            if (ts.extendedTag_ == Tag::all) {
+                if (group.all_ == nullptr) group.all_ = &ts;
+            }
+            else {
+                group.tags_.emplace(ts.extendedTag_, &ts);
+            }
+        }
+
+        std::unordered_map<uint64_t, const TiffTreeStruct*> nodes;
+        for (auto&& ts : tiffTreeStruct_) {
+            nodes.emplace(treeKey(ts.root_, ts.group_), &ts);
+        }
+        for (auto&& node : nodes) {
+            // Follow the parents up to the root, as getPath() did with the table
+            std::vector<TiffPathItem> path;
+            const TiffTreeStruct* ts = node.second;
+            while (ts != nullptr && ts->group_ != ifdIdNotSet && path.size() < nodes.size()) {
+                path.emplace_back(ts->parentExtTag_, ts->parentGroup_);
+                auto parent = nodes.find(treeKey(ts->root_, ts->parentGroup_));
+                ts = parent == nodes.end() ? nullptr : parent->second;
+            }
+            if (ts == nullptr || ts->group_ != ifdIdNotSet) continue;
+            parents_.emplace(node.first, std::move(path));
+        }
+    }
+
+    const TiffGroupStruct* TiffCreator::Index::groupStruct(uint32_t extendedTag, IfdId group) const
+    {
+        if (group < 0 || group > lastId) return nullptr;
+        const Group& g = groups_[group];
+        const TiffGroupStruct* ts = nullptr;
+        auto pos = g.tags_.find(extendedTag);
+        if (pos != g.tags_.end()) ts = pos->second;
+        if (g.all_ != nullptr && (ts == nullptr || g.all_ < ts)) ts = g.all_;
+        return ts;
+    }
+
+    const std::vector<TiffPathItem>* TiffCreator::Index::parents(uint32_t root, IfdId group) const
+    {
+        auto pos = parents_.find(treeKey(root, group));
+        return pos == parents_.end() ? nullptr : &pos->second;
+    }
+
+    const TiffCreator::Index& TiffCreator::index()
+    {
+        static const Index index;
+        return index;
+    }
+
     TiffComponent::UniquePtr TiffCreator::create(uint32_t extendedTag, IfdId group)
     {
         std::unique_ptr<TiffComponent> tc;
         auto tag = static_cast<uint16_t>(extendedTag & 0xffff);
-        const TiffGroupStruct* ts = find(tiffGroupStruct_, TiffGroupStruct::Key(extendedTag, group));
+        const TiffGroupStruct* ts = index().groupStruct(extendedTag, group);
         if (ts && ts->newTiffCompFct_) {
             tc = ts->newTiffCompFct_(tag, group);
         }
@@ -2032,6 +2128,15 @@ namespace Exiv2 {
                               IfdId     group,
                               uint32_t  root)
     {
+        const std::vector<TiffPathItem>* parents = index().parents(root, group);
+        if (parents != nullptr) {
+            tiffPath.push(TiffPathItem(extendedTag, group));
+            for (auto&& tpi : *parents) {
+                tiffPath.push(tpi);
+            }
+            return;
+        }
+
         const TiffTreeStruct* ts = nullptr;
         do {
             tiffPath.push(TiffPathItem(extendedTag, group));
@@ -2043,6 +2148,236 @@ namespace Exiv2 {
 
     } // TiffCreator::getPath
 
+    void TiffCreator::selectGroups(std::vector<bool>& groups,
+                                   const ExifFilter&  filter,
+                                   uint32_t           root)
+    {
+        groups.assign(lastId + 1, false);
+        for (int group = 0; group <= lastId; ++group) {
+            if (filter.selectsGroup(group)) groups[group] = true;
+        }
+        selectParents(groups, root);
+
+    } // TiffCreator::selectGroups
+
+    void TiffCreator::selectParents(std::vector<bool>& groups,
+                                    uint32_t           root)
+    {
+        // The MakerNote group describes the makernote, which is in the Exif IFD
+        if (groups[mnId]) groups[exifId] = true;
+        // Add the parents, a group can have several, until there are no more
+        bool added = true;
+        while (added) {
+            added = false;
+            for (auto&& ts : tiffTreeStruct_) {
+                if (   ts.root_ != root
+                    || ts.group_ < 0 || ts.group_ > lastId || !groups[ts.group_]
+                    || ts.parentGroup_ < 0 || ts.parentGroup_ > lastId || groups[ts.parentGroup_]) continue;
+                groups[ts.parentGroup_] = true;
+                added = true;
+            }
+        }
+
+    } // TiffCreator::selectParents
+
+    namespace {
+        //! Return the groups of makernotes, including the MakerNote group, indexed by IfdId
+        const std::vector<bool>& makerGroups()
+        {
+            static const std::vector<bool> groups = [] {
+                std::vector<bool> g(lastId + 1, false);
+                for (int group = 0; group <= lastId; ++group) {
+                    g[group] = group == mnId || isMakerIfd(static_cast<IfdId>(group));
+                }
+                return g;
+            }();
+            return groups;
+        }
+
+        //! Find the decoders of the makernote only
+        DecoderFct findMakernoteDecoder(const std::string& make, uint32_t extendedTag, IfdId group)
+        {
+            if (group < 0 || group > lastId || !makerGroups()[group]) return nullptr;
+            return TiffMapping::findDecoder(make, extendedTag, group);
+        }
+
+        /*!
+          @brief Find the end of the IFD entries and their values in a TIFF
+                 composite, relative to the start of the TIFF data \em pData.
+                 Image data which is only referenced by offsets isn't included.
+         */
+        class TiffExtent : public TiffVisitor {
+        public:
+            //! Constructor
+            explicit TiffExtent(const byte* pData) : pData_(pData), end_(0) {}
+
+            void visitEntry(TiffEntry* object) override { extend(object); }
+            void visitDataEntry(TiffDataEntry* object) override { extend(object); }
+            void visitImageEntry(TiffImageEntry* object) override { extend(object); }
+            void visitSizeEntry(TiffSizeEntry* object) override { extend(object); }
+            void visitDirectory(TiffDirectory* /*object*/) override {}
+            void visitSubIfd(TiffSubIfd* object) override { extend(object); }
+            void visitMnEntry(TiffMnEntry* object) override { extend(object); }
+            void visitIfdMakernote(TiffIfdMakernote* /*object*/) override {}
+            void visitBinaryArray(TiffBinaryArray* object) override { extend(object); }
+            void visitBinaryElement(TiffBinaryElement* /*object*/) override {}
+
+            //! Return the end of the entries and values
+            size_t end() const { return end_; }
+
+        private:
+            void extend(const TiffEntryBase* object)
+            {
+                // An IFD entry is 12 bytes, its value may follow the entry or not
+                if (object->start() && object->start() >= pData_) {
+                    end_ = std::max(end_, static_cast<size_t>(object->start() + 12 - pData_));
+                }
+                if (object->pData() && object->pData() >= pData_) {
+                    end_ = std::max(end_, static_cast<size_t>(object->pData() + object->size() - pData_));
+                }
+            }
+
+            const byte* pData_;                     //!< Start of the TIFF data
+            size_t end_;                            //!< End of the entries and values
+        };
+
+        //! Largest copy of the TIFF data kept for a deferred makernote
+        constexpr size_t maxDeferredSize = 0x40000;
+
+        /*!
+          @brief Makernote decoder for ExifData::setMakernoteDecoder(). It
+                 reads the TIFF data, usually a copy of it up to the end of
+                 the metadata, at the offsets of the IFD entries needed to
+                 read the makernote again: the camera make and model and the
+                 makernote.
+         */
+        class DeferredMakernote {
+        public:
+            //! An IFD entry to read: tag, group and offset of the entry
+            using Entry = std::tuple<uint16_t, IfdId, uint32_t>;
+
+            /*!
+              @brief Constructor. The decoder reads \em size bytes at \em pData,
+                     which must remain valid while it is used, unless they
+                     are owned by \em buf.
+             */
+            DeferredMakernote(std::shared_ptr<const DataBuf> buf,
+                              const byte*                    pData,
+                              uint32_t                       size,
+                              std::vector<Entry>             entries,
+                              ByteOrder                      byteOrder,
+                              uint32_t                       root,
+                              std::vector<bool>              groups,
+                              const ExifFilter*              pFilter)
+                : buf_(std::move(buf)), pData_(pData), size_(size), entries_(std::move(entries)),
+                  byteOrder_(byteOrder), root_(root), groups_(std::move(groups)),
+                  filter_(pFilter ? *pFilter : ExifFilter())
+            {
+            }
+
+            //! Read the makernote and decode it into \em exifData
+            void operator()(ExifData& exifData) const
+            {
+                TiffArena::Scope arenaScope;
+                auto rootDir = TiffCreator::create(root_, ifdIdNotSet);
+                if (!rootDir) return;
+                std::vector<TiffComponent*> components;
+                for (auto&& entry : entries_) {
+                    auto tc = TiffCreator::create(std::get<0>(entry), std::get<1>(entry));
+                    if (!tc) continue;
+                    tc->setStart(pData_ + std::get<2>(entry));
+                    components.push_back(rootDir->addChild(std::move(tc)));
+                }
+                TiffReader reader(pData_, size_, rootDir.get(), TiffRwState(byteOrder_, 0), &groups_);
+                for (auto&& tc : components) {
+                    if (tc) tc->accept(reader);
+                }
+                reader.postProcess();
+                IptcData iptcData;
+                XmpData xmpData;
+                TiffDecoder decoder(exifData, iptcData, xmpData, rootDir.get(), findMakernoteDecoder,
+                                    filter_.empty() ? nullptr : &filter_);
+                rootDir->accept(decoder);
+            }
+
+        private:
+            std::shared_ptr<const DataBuf> buf_;    //!< Copy of the TIFF data, if it is kept
+            const byte* pData_;                     //!< TIFF data to read
+            uint32_t size_;                         //!< Size of the TIFF data
+            std::vector<Entry> entries_;            //!< IFD entries to read
+            ByteOrder byteOrder_;                   //!< Byte order of the TIFF data
+            uint32_t root_;                         //!< Root tag of the TIFF tree
+            std::vector<bool> groups_;              //!< Groups to read
+            ExifFilter filter_;                     //!< Selection of the metadata to decode
+        };
+
+        /*!
+          @brief Set a decoder for the makernote in the TIFF tree \em pRoot
+                 parsed from \em pData to \em exifData, if there is a
+                 makernote with groups selected by \em pFilter.
+
+          If the metadata extends too far into the TIFF data to copy it
+          cheaply, e.g., in a TIFF image with the IFDs after the image data,
+          the makernote is decoded right away instead.
+         */
+        void deferMakernote(ExifData&         exifData,
+                            const byte*       pData,
+                            uint32_t          size,
+                            TiffComponent*    pRoot,
+                            ByteOrder         byteOrder,
+                            uint32_t          root,
+                            const ExifFilter* pFilter)
+        {
+            std::vector<bool> groups(lastId + 1, false);
+            bool selected = false;
+            for (int group = 0; group <= lastId; ++group) {
+                if (!makerGroups()[group] || (pFilter && !pFilter->selectsGroup(group))) continue;
+                groups[group] = true;
+                selected = true;
+            }
+            if (!selected) return;
+            TiffCreator::selectParents(groups, root);
+
+            static const std::pair<uint16_t, IfdId> tags[] = {
+                { 0x010f, ifd0Id }, // Make
+                { 0x0110, ifd0Id }, // Model
+                { 0x927c, exifId }, // MakerNote
+                { 0xc634, ifd0Id }  // DNGPrivateData
+            };
+            std::vector<DeferredMakernote::Entry> entries;
+            bool makernote = false;
+            for (auto&& tag : tags) {
+                TiffFinder finder(tag.first, tag.second);
+                pRoot->accept(finder);
+                auto te = dynamic_cast<const TiffEntryBase*>(finder.result());
+                if (!te || !te->start()) continue;
+                makernote = makernote || tag.first == 0x927c || tag.first == 0xc634;
+                entries.emplace_back(tag.first, tag.second, static_cast<uint32_t>(te->start() - pData));
+            }
+            if (!makernote) return;
+            // Keep the IFDs and their values. Makernotes can also refer to data after them,
+            // so keep at least 64 KB, which is all of the Exif data of a JPEG image.
+            TiffExtent extent(pData);
+            pRoot->accept(extent);
+            const size_t end = std::min(std::max(extent.end(), static_cast<size_t>(0x10000)),
+                                        static_cast<size_t>(size));
+            if (end > maxDeferredSize) {
+                // Offsets are relative to the start of the TIFF data, so a copy must start there
+                exifData.setMakernoteDecoder(DeferredMakernote(nullptr, pData, size, std::move(entries), byteOrder,
+                                                               root, std::move(groups), pFilter));
+                // Counting the metadata decodes the makernote while pData is valid
+                exifData.count();
+                return;
+            }
+            auto buf = std::make_shared<DataBuf>(pData, static_cast<long>(end));
+            const byte* pBuf = buf->c_data();
+            exifData.setMakernoteDecoder(DeferredMakernote(std::move(buf), pBuf, static_cast<uint32_t>(end),
+                                                           std::move(entries), byteOrder, root, std::move(groups),
+                                                           pFilter));
+        }
+
+    } // namespace
+
     ByteOrder TiffParserWorker::decode(
               ExifData&          exifData,
               IptcData&          iptcData,
@@ -2051,7 +2386,8 @@ namespace Exiv2 {
               uint32_t           size,
               uint32_t           root,
               FindDecoderFct     findDecoderFct,
-              TiffHeaderBase*    pHeader
+              TiffHeaderBase*    pHeader,
+        const ExifFilter*        pFilter
     )
     {
         // Create standard TIFF header if necessary
@@ -2061,14 +2397,31 @@ namespace Exiv2 {
             pHeader = ph.get();
         }
 
-        auto rootDir = parse(pData, size, root, pHeader);
+        // The makernote decoder can only defer the standard makernote decoders
+        const bool defer =    pFilter != nullptr && pFilter->defersMakernote()
+                           && findDecoderFct == &TiffMapping::findDecoder;
+        if (pFilter != nullptr && pFilter->empty()) pFilter = nullptr;
+        std::vector<bool> groups;
+        if (pFilter != nullptr) TiffCreator::selectGroups(groups, *pFilter, root);
+        if (defer) {
+            // Don't read the makernote now
+            if (groups.empty()) groups.assign(lastId + 1, true);
+            for (int group = 0; group <= lastId; ++group) {
+                if (makerGroups()[group]) groups[group] = false;
+            }
+        }
+        auto rootDir = parse(pData, size, root, pHeader, groups.empty() ? nullptr : &groups);
         if (nullptr != rootDir.get()) {
             TiffDecoder decoder(exifData,
                                 iptcData,
                                 xmpData,
                                 rootDir.get(),
-                                findDecoderFct);
+                                findDecoderFct,
+                                pFilter);
             rootDir->accept(decoder);
+            if (defer) {
+                deferMakernote(exifData, pData, size, rootDir.get(), pHeader->byteOrder(), root, pFilter);
+            }
         }
         return pHeader->byteOrder();
 
@@ -2084,7 +2437,8 @@ namespace Exiv2 {
               uint32_t           root,
               FindEncoderFct     findEncoderFct,
               TiffHeaderBase*    pHeader,
-              OffsetWriter*      pOffsetWriter
+              OffsetWriter*      pOffsetWriter,
+              bool               append
     )
     {
         /*
@@ -2093,9 +2447,13 @@ namespace Exiv2 {
            3) else, create a new tree and write a new TIFF structure ("intrusive
               writing"). If there is a parsed tree, it is only used to access the
               image data in this case.
+           4) if requested, append the new TIFF structure to the binary image
+              instead, keeping the image data where it is
          */
         assert(pHeader);
         assert(pHeader->byteOrder() != invalidByteOrder);
+        // Allocate the components of both trees from one arena
+        TiffArena::Scope arenaScope;
         WriteMethod writeMethod = wmIntrusive;
         auto parsedTree = parse(pData, size, root, pHeader);
         PrimaryGroups primaryGroups;
@@ -2124,23 +2482,60 @@ namespace Exiv2 {
             TiffEncoder encoder(exifData, iptcData, xmpData, createdTree.get(), parsedTree.get() == nullptr,
                                 &primaryGroups, pHeader, findEncoderFct);
             encoder.add(createdTree.get(), parsedTree.get(), root);
-            // Write binary representation from the composite tree
-            DataBuf header = pHeader->write();
-            auto tempIo = std::make_unique<MemIo>();
-            assert(tempIo.get() != 0);
-            IoWrapper ioWrapper(*tempIo, header.c_data(), header.size(), pOffsetWriter);
-            auto imageIdx(uint32_t(-1));
-            createdTree->write(ioWrapper,
-                               pHeader->byteOrder(),
-                               header.size(),
-                               uint32_t(-1),
-                               uint32_t(-1),
-                               imageIdx);
-            if (pOffsetWriter) pOffsetWriter->writeOffsets(*tempIo);
-            io.transfer(*tempIo); // may throw
+            // Compute the size of each component only once while writing
+            TiffSizeCacher sizeCacher(true);
+            createdTree->accept(sizeCacher);
+            // Append the new structure at a word boundary after the existing data
+            const int64_t appendOffset = static_cast<int64_t>(size) + (size & 1);
+            if (   append
+                && nullptr != parsedTree.get()
+                && nullptr == pOffsetWriter
+                && io.size() == size
+                && appendOffset + createdTree->size() <= std::numeric_limits<uint32_t>::max()) {
+                // Write the structure to memory first, pData may be the memory of io
+                MemIo memIo;
+                if (size & 1) memIo.putb(0x0);
+                IoWrapper ioWrapper(memIo, nullptr, 0, nullptr);
+                ioWrapper.keepImageData(pData, size);
+                auto imageIdx(uint32_t(-1));
+                createdTree->write(ioWrapper,
+                                   pHeader->byteOrder(),
+                                   appendOffset,
+                                   uint32_t(-1),
+                                   uint32_t(-1),
+                                   imageIdx);
+                // Append the structure, then point the IFD offset of the header to it
+                byte offset[4];
+                ul2Data(offset, static_cast<uint32_t>(appendOffset), pHeader->byteOrder());
+                memIo.seek(0, BasicIo::beg);
+                io.seek(0, BasicIo::end);
+                if (io.write(memIo) != static_cast<long>(memIo.size())) throw Error(kerImageWriteFailed);
+                io.seek(4, BasicIo::beg);
+                if (io.write(offset, 4) != 4) throw Error(kerImageWriteFailed);
+                writeMethod = wmAppend;
 #ifndef SUPPRESS_WARNINGS
-            EXV_INFO << "Write strategy: Intrusive\n";
+                EXV_INFO << "Write strategy: Append\n";
 #endif
+            }
+            else {
+                // Write binary representation from the composite tree
+                DataBuf header = pHeader->write();
+                auto tempIo = io.temporary();
+                assert(tempIo.get() != 0);
+                IoWrapper ioWrapper(*tempIo, header.c_data(), header.size(), pOffsetWriter);
+                auto imageIdx(uint32_t(-1));
+                createdTree->write(ioWrapper,
+                                   pHeader->byteOrder(),
+                                   header.size(),
+                                   uint32_t(-1),
+                                   uint32_t(-1),
+                                   imageIdx);
+                if (pOffsetWriter) pOffsetWriter->writeOffsets(*tempIo);
+                io.transfer(*tempIo); // may throw
+#ifndef SUPPRESS_WARNINGS
+                EXV_INFO << "Write strategy: Intrusive\n";
+#endif
+            }
         }
 #ifndef SUPPRESS_WARNINGS
         else {
@@ -2154,7 +2549,8 @@ namespace Exiv2 {
         const byte*              pData,
               uint32_t           size,
               uint32_t           root,
-              TiffHeaderBase*    pHeader
+              TiffHeaderBase*    pHeader,
+        const std::vector<bool>* pGroups
     )
     {
         if (pData == nullptr || size == 0)
@@ -2162,11 +2558,12 @@ namespace Exiv2 {
         if (!pHeader->read(pData, size) || pHeader->offset() >= size) {
             throw Error(kerNotAnImage, "TIFF");
         }
+        TiffArena::Scope arenaScope;
         auto rootDir = TiffCreator::create(root, ifdIdNotSet);
         if (rootDir) {
             rootDir->setStart(pData + pHeader->offset());
             TiffRwState state(pHeader->byteOrder(), 0);
-            TiffReader reader(pData, size, rootDir.get(), state);
+            TiffReader reader(pData, size, rootDir.get(), state, pGroups);
             rootDir->accept(reader);
             reader.postProcess();
         }
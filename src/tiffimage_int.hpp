@@ -252,8 +252,27 @@ namespace Exiv2 {
                             uint32_t  extendedTag,
                             IfdId     group,
                             uint32_t  root);
+        /*!
+          @brief Mark the groups of the tree \em root which contain metadata
+                 selected by \em filter, i.e., the selected groups and all
+                 groups on their paths from the root, in \em groups. The
+                 vector is indexed by IfdId.
+        */
+        static void selectGroups(std::vector<bool>& groups,
+                                 const ExifFilter&  filter,
+                                 uint32_t           root);
+        /*!
+          @brief Add the groups on the paths from the root of the tree \em root
+                 to the groups marked in \em groups to \em groups.
+        */
+        static void selectParents(std::vector<bool>& groups,
+                                  uint32_t           root);
 
     private:
+        class Index;
+        //! Return the lookup structures for tiffGroupStruct_ and tiffTreeStruct_
+        static const Index& index();
+
         static const TiffTreeStruct  tiffTreeStruct_[];  //<! TIFF tree structure
         static const TiffGroupStruct tiffGroupStruct_[]; //<! TIFF group structure
 
@@ -283,6 +302,10 @@ namespace Exiv2 {
           @param findDecoderFct Function to access special decoding info.
           @param pHeader   Optional pointer to a TIFF header. If not provided,
                            a standard TIFF header is used.
+          @param pFilter   Optional selection of the Exif metadata to decode,
+                           all if 0. If it defers the makernote, the
+                           makernote is decoded into \em exifData when it is
+                           first accessed, see ExifData::setMakernoteDecoder().
 
           @return Byte order in which the data is encoded, invalidByteOrder if
                   decoding failed.
@@ -295,7 +318,8 @@ namespace Exiv2 {
                   uint32_t           size,
                   uint32_t           root,
                   FindDecoderFct     findDecoderFct,
-                  TiffHeaderBase*    pHeader =0
+                  TiffHeaderBase*    pHeader =0,
+            const ExifFilter*        pFilter =0
         );
         /*!
           @brief Encode TIFF metadata from the metadata containers into a
@@ -306,6 +330,9 @@ namespace Exiv2 {
           3) else, create a new tree and write a new TIFF structure ("intrusive
              writing"). If there is a parsed tree, it is only used to access the
              image data in this case.
+          4) If \em append is set and \em io holds the binary image, the new
+             structure is appended to \em io instead. It refers to the image
+             data where it is and only the IFD offset in the header is updated.
          */
         static WriteMethod encode(
                   BasicIo&           io,
@@ -317,7 +344,8 @@ namespace Exiv2 {
                   uint32_t           root,
                   FindEncoderFct     findEncoderFct,
                   TiffHeaderBase*    pHeader,
-                  OffsetWriter*      pOffsetWriter
+                  OffsetWriter*      pOffsetWriter,
+                  bool               append =false
         );
 
     private:
@@ -330,6 +358,9 @@ namespace Exiv2 {
           @param size      Length of the data buffer.
           @param root      Root tag of the TIFF tree.
           @param pHeader   Pointer to a TIFF header.
+          @param pGroups   Optional groups to read, indexed by IfdId, all
+                           if 0. Sub-IFDs, makernotes and binary arrays of
+                           other groups are not read.
           @return          An auto pointer with the root element of the TIFF
                            composite structure. If \em pData is 0 or \em size
                            is 0, the return value is a 0 pointer.
@@ -338,7 +369,8 @@ namespace Exiv2 {
             const byte*              pData,
                   uint32_t           size,
                   uint32_t           root,
-                  TiffHeaderBase*    pHeader
+                  TiffHeaderBase*    pHeader,
+            const std::vector<bool>* pGroups =0
         );
         /*!
           @brief Find primary groups in the source tree provided and populate
@@ -50,15 +50,15 @@ namespace {
     public:
         //! Constructor, initializes the object with the group and index to look for.
         FindExifdatum2(Exiv2::Internal::IfdId group, int idx)
-            : groupName_(Exiv2::Internal::groupName(group)), idx_(idx) {}
+            : group_(group), idx_(idx) {}
         //! Returns true if group and index match.
         bool operator()(const Exiv2::Exifdatum& md) const
         {
-            return idx_ == md.idx() && 0 == strcmp(md.groupName().c_str(), groupName_);
+            return idx_ == md.idx() && group_ == md.ifdId();
         }
 
     private:
-        const char* groupName_;
+        int group_;
         int idx_;
 
     }; // class FindExifdatum2
@@ -258,19 +258,71 @@ namespace Exiv2 {
         copyObject(object);
     }
 
+    void TiffSizeCacher::visitEntry(TiffEntry* object)
+    {
+        object->cacheSizes(enable_);
+    }
+
+    void TiffSizeCacher::visitDataEntry(TiffDataEntry* object)
+    {
+        object->cacheSizes(enable_);
+    }
+
+    void TiffSizeCacher::visitImageEntry(TiffImageEntry* object)
+    {
+        object->cacheSizes(enable_);
+    }
+
+    void TiffSizeCacher::visitSizeEntry(TiffSizeEntry* object)
+    {
+        object->cacheSizes(enable_);
+    }
+
+    void TiffSizeCacher::visitDirectory(TiffDirectory* object)
+    {
+        object->cacheSizes(enable_);
+    }
+
+    void TiffSizeCacher::visitSubIfd(TiffSubIfd* object)
+    {
+        object->cacheSizes(enable_);
+    }
+
+    void TiffSizeCacher::visitMnEntry(TiffMnEntry* object)
+    {
+        object->cacheSizes(enable_);
+    }
+
+    void TiffSizeCacher::visitIfdMakernote(TiffIfdMakernote* object)
+    {
+        object->cacheSizes(enable_);
+    }
+
+    void TiffSizeCacher::visitBinaryArray(TiffBinaryArray* object)
+    {
+        object->cacheSizes(enable_);
+    }
+
+    void TiffSizeCacher::visitBinaryElement(TiffBinaryElement* object)
+    {
+        object->cacheSizes(enable_);
+    }
+
     TiffDecoder::TiffDecoder(
         ExifData&            exifData,
         IptcData&            iptcData,
         XmpData&             xmpData,
         TiffComponent* const pRoot,
-        FindDecoderFct       findDecoderFct
+        FindDecoderFct       findDecoderFct,
+        const ExifFilter*    pFilter
     )
         : exifData_(exifData),
           iptcData_(iptcData),
           xmpData_(xmpData),
           pRoot_(pRoot),
           findDecoderFct_(findDecoderFct),
-          decodedIptc_(false)
+          decodedIptc_(false),
+          pFilter_(pFilter)
     {
         assert(pRoot != 0);
 
@@ -330,6 +382,7 @@ namespace Exiv2 {
     {
         assert(object != 0);
 
+        if (pFilter_ && !pFilter_->selectsGroup(mnId)) return;
         exifData_["Exif.MakerNote.Offset"] = object->mnOffset();
         switch (object->byteOrder()) {
         case littleEndian:
@@ -513,6 +566,7 @@ namespace Exiv2 {
                         s << " " << uint.at(nStart++);
                 }
 
+                if (pFilter_ && !pFilter_->selects(record.tag, object->group())) continue;
                 v->read(s.str());
                 exifData_[familyGroup + pTag->name_] = *v;
             }
@@ -530,14 +584,19 @@ namespace Exiv2 {
                                                       object->tag(),
                                                       object->group());
         // skip decoding if decoderFct == 0
-        if (decoderFct) {
-            EXV_CALL_MEMBER_FN(*this, decoderFct)(object);
-        }
+        if (!decoderFct) return;
+        // IPTC and XMP are decoded even if the Exif tag which holds them isn't selected
+        if (   pFilter_
+            && !pFilter_->selectsGroup(object->group())
+            && decoderFct != &TiffDecoder::decodeIptc
+            && decoderFct != &TiffDecoder::decodeXmp) return;
+        EXV_CALL_MEMBER_FN(*this, decoderFct)(object);
     } // TiffDecoder::decodeTiffEntry
 
     void TiffDecoder::decodeStdTiffEntry(const TiffEntryBase* object)
     {
         assert(object != 0);
+        if (pFilter_ && !pFilter_->selects(object->tag(), object->group())) return;
         ExifKey key(object->tag(), groupName(object->group()));
         key.setIdx(object->idx());
         exifData_.add(key, object->pValue());
@@ -868,8 +927,7 @@ namespace Exiv2 {
         const Exifdatum* ed = datum;
         if (ed == nullptr) {
             // Non-intrusive writing: find matching tag
-            ExifKey key(object->tag(), groupName(object->group()));
-            pos = exifData_.findKey(key);
+            pos = exifData_.findKey(object->tag(), object->group());
             if (pos != exifData_.end()) {
                 ed = &(*pos);
                 if (object->idx() != pos->idx()) {
@@ -877,7 +935,7 @@ namespace Exiv2 {
                     auto pos2 =
                         std::find_if(exifData_.begin(), exifData_.end(),
                                      FindExifdatum2(object->group(), object->idx()));
-                    if (pos2 != exifData_.end() && pos2->key() == key.key()) {
+                    if (pos2 != exifData_.end() && pos2->tag() == object->tag()) {
                         ed = &(*pos2);
                         pos = pos2; // make sure we delete the correct tag below
                     }
@@ -886,6 +944,7 @@ namespace Exiv2 {
             else {
                 setDirty();
 #ifdef EXIV2_DEBUG_MESSAGES
+                ExifKey key(object->tag(), groupName(object->group()));
                 std::cerr << "DELETING          " << key << ", idx = " << object->idx() << "\n";
 #endif
             }
@@ -1123,7 +1182,7 @@ namespace Exiv2 {
         for (auto i = exifData_.begin();
              i != exifData_.end(); ++i) {
 
-            IfdId group = groupId(i->groupName());
+            auto group = static_cast<IfdId>(i->ifdId());
             // Skip synthesized info tags
             if (group == mnId) {
                 if (i->tag() == 0x0002) {
@@ -1177,17 +1236,19 @@ namespace Exiv2 {
 
     } // TiffEncoder::add
 
-    TiffReader::TiffReader(const byte*    pData,
-                           uint32_t       size,
-                           TiffComponent* pRoot,
-                           TiffRwState    state)
+    TiffReader::TiffReader(const byte*              pData,
+                           uint32_t                 size,
+                           TiffComponent*           pRoot,
+                           TiffRwState              state,
+                           const std::vector<bool>* pGroups)
         : pData_(pData),
           size_(size),
           pLast_(pData + size),
           pRoot_(pRoot),
           origState_(state),
           mnState_(state),
-          postProc_(false)
+          postProc_(false),
+          pGroups_(pGroups)
     {
         pState_ = &origState_;
         assert(pData_);
@@ -1226,6 +1287,12 @@ namespace Exiv2 {
         return pState_->baseOffset();
     }
 
+    bool TiffReader::readGroup(IfdId group) const
+    {
+        return    pGroups_ == nullptr
+               || (group >= 0 && group < static_cast<int>(pGroups_->size()) && (*pGroups_)[group]);
+    }
+
     void TiffReader::readDataEntryBase(TiffDataEntryBase* object)
     {
         assert(object != 0);
@@ -1364,6 +1431,7 @@ namespace Exiv2 {
                 }
 #endif
             }
+            if (tc.get() && !readGroup(tc->group())) tc.reset();
             if (tc.get()) {
                 if (baseOffset() + next > size_) {
 #ifndef SUPPRESS_WARNINGS
@@ -1412,8 +1480,9 @@ namespace Exiv2 {
                     break;
                 }
                 // If there are multiple dirs, group is incremented for each
-                auto td = std::make_unique<TiffDirectory>(object->tag(),
-                                                            static_cast<IfdId>(object->newGroup_ + i));
+                const auto group = static_cast<IfdId>(object->newGroup_ + i);
+                if (!readGroup(group)) continue;
+                auto td = std::make_unique<TiffDirectory>(object->tag(), group);
                 td->setStart(pData_ + baseOffset() + offset);
                 object->addChild(std::move(td));
             }
@@ -1449,6 +1518,12 @@ namespace Exiv2 {
                                                 object->size_,
                                                 byteOrder());
         }
+        // Don't read a makernote which contains no group to read
+        auto mn = dynamic_cast<TiffIfdMakernote*>(object->mn_);
+        if (mn && !readGroup(mn->ifd_.group()) && !readGroup(mnId)) {
+            delete object->mn_;
+            object->mn_ = nullptr;
+        }
         if (object->mn_) object->mn_->setStart(object->pData());
 
     } // TiffReader::visitMnEntry
@@ -1649,6 +1724,11 @@ namespace Exiv2 {
         const ArrayCfg* cfg = object->cfg();
         if (cfg == nullptr)
             return;
+        if (!readGroup(cfg->group_)) {
+            // Skip the elements, and the array itself, which is only decoded as its elements
+            object->setDecoded(true);
+            return;
+        }
 
         const CryptFct cryptFct = cfg->cryptFct_;
         if (cryptFct != nullptr) {
@@ -262,6 +262,50 @@ namespace Exiv2 {
         const PrimaryGroups*  pPrimaryGroups_;
     }; // class TiffCopier
 
+    /*!
+      @brief TIFF composite visitor to enable or disable the size cache of all
+             components of a composite (Visitor pattern). Used by
+             TiffParserWorker to compute the sizes of the components only once
+             while the composite is written.
+     */
+    class TiffSizeCacher : public TiffVisitor {
+    public:
+        //! @name Creators
+        //@{
+        //! Constructor, \em enable is passed to TiffComponent::cacheSizes()
+        explicit TiffSizeCacher(bool enable) : enable_(enable) {}
+        //! Virtual destructor
+        ~TiffSizeCacher() override = default;
+        //@}
+
+        //! @name Manipulators
+        //@{
+        //! Set the size cache of a TIFF entry
+        void visitEntry(TiffEntry* object) override;
+        //! Set the size cache of a TIFF data entry
+        void visitDataEntry(TiffDataEntry* object) override;
+        //! Set the size cache of a TIFF image entry
+        void visitImageEntry(TiffImageEntry* object) override;
+        //! Set the size cache of a TIFF size entry
+        void visitSizeEntry(TiffSizeEntry* object) override;
+        //! Set the size cache of a TIFF directory
+        void visitDirectory(TiffDirectory* object) override;
+        //! Set the size cache of a TIFF sub-IFD
+        void visitSubIfd(TiffSubIfd* object) override;
+        //! Set the size cache of a TIFF makernote
+        void visitMnEntry(TiffMnEntry* object) override;
+        //! Set the size cache of an IFD makernote
+        void visitIfdMakernote(TiffIfdMakernote* object) override;
+        //! Set the size cache of a binary array
+        void visitBinaryArray(TiffBinaryArray* object) override;
+        //! Set the size cache of an element of a binary array
+        void visitBinaryElement(TiffBinaryElement* object) override;
+        //@}
+
+    private:
+        bool enable_;   //!< Enable or disable the cache
+    }; // class TiffSizeCacher
+
     /*!
       @brief TIFF composite visitor to decode metadata from the TIFF tree and
              add it to an Image, which is supplied in the constructor (Visitor
@@ -275,14 +319,16 @@ namespace Exiv2 {
         /*!
           @brief Constructor, taking metadata containers to add the metadata to,
                  the root element of the composite to decode and a FindDecoderFct
-                 function to get the decoder function for each tag.
+                 function to get the decoder function for each tag. If a filter
+                 is provided, only the Exif metadata it selects is decoded.
          */
         TiffDecoder(
             ExifData&            exifData,
             IptcData&            iptcData,
             XmpData&             xmpData,
             TiffComponent* const pRoot,
-            FindDecoderFct       findDecoderFct
+            FindDecoderFct       findDecoderFct,
+            const ExifFilter*    pFilter =0
         );
         //! Virtual destructor
         ~TiffDecoder() override = default;
@@ -350,6 +396,7 @@ namespace Exiv2 {
         const FindDecoderFct findDecoderFct_; //!< Ptr to the function to find special decoding functions
         std::string make_;           //!< Camera make, determined from the tags to decode
         bool decodedIptc_;           //!< Indicates if IPTC has been decoded yet
+        const ExifFilter* pFilter_;  //!< Exif metadata to decode, all if 0
 
     }; // class TiffDecoder
 
@@ -617,11 +664,16 @@ namespace Exiv2 {
           @param pRoot     Root element of the TIFF composite.
           @param state     State object for creation function, byte order and
                            base offset.
+          @param pGroups   Optional list of the groups to read, indexed by
+                           IfdId, see TiffCreator::selectGroups(). Sub-IFDs,
+                           makernotes and binary arrays of other groups are
+                           not read. If 0, all groups are read.
          */
-        TiffReader(const byte*          pData,
-                   uint32_t             size,
-                   TiffComponent*       pRoot,
-                   TiffRwState          state);
+        TiffReader(const byte*              pData,
+                   uint32_t                 size,
+                   TiffComponent*           pRoot,
+                   TiffRwState              state,
+                   const std::vector<bool>* pGroups =0);
 
         //! Virtual destructor
         ~TiffReader() override = default;
@@ -688,6 +740,8 @@ namespace Exiv2 {
         ByteOrder byteOrder() const;
         //! Return the base offset. See class TiffRwState for details
         uint32_t baseOffset() const;
+        //! Return true if the components of \em group are to be read
+        bool readGroup(IfdId group) const;
         //@}
 
     private:
@@ -707,6 +761,7 @@ namespace Exiv2 {
         IdxSeq               idxSeq_;     //!< Sequences for group, used for the entry's idx
         PostList             postList_;   //!< List of components with deferred reading
         bool                 postProc_;   //!< True in postProcessList()
+        const std::vector<bool>* pGroups_; //!< Groups to read, all if 0
     }; // class TiffReader
 
 }}                                      // namespace Internal, Exiv2
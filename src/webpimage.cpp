@@ -154,17 +154,146 @@ namespace Exiv2 {
 
     void WebPImage::writeMetadata()
     {
+        enforceExifUnfiltered();
         if (io_->open() != 0) {
             throw Error(kerDataSourceOpenFailed, io_->path(), strError());
         }
         IoCloser closer(*io_);
-        auto tempIo = std::make_unique<MemIo>();
+        if (writeMetadataInPlace()) {
+            writeMethod_ = wmNonIntrusive;
+            return;
+        }
+        io_->seekOrThrow(0, BasicIo::beg, kerInputDataReadFailed);
+        auto tempIo = io_->temporary();
 
         doWriteMetadata(*tempIo); // may throw
         io_->close();
         io_->transfer(*tempIo); // may throw
+        writeMethod_ = wmIntrusive;
     } // WebPImage::writeMetadata
 
+    bool WebPImage::writeMetadataInPlace()
+    {
+        if (dynamic_cast<FileIo*>(io_.get()) == nullptr || !isWebPType(*io_, true))
+            return false;
+
+        byte data[WEBP_TAG_SIZE * 3];
+        io_->readOrThrow(data, WEBP_TAG_SIZE * 3, Exiv2::kerCorruptedMetadata);
+        const uint32_t filesize = Safe::add(Exiv2::getULong(data + WEBP_TAG_SIZE, littleEndian), 8U);
+        enforce(filesize <= io_->size(), Exiv2::kerCorruptedMetadata);
+
+        // Offset of the payload and payload of the chunks to update
+        long vp8xPos = -1;
+        long exifPos = -1;
+        long xmpPos = -1;
+        int iccCount = 0;
+        byte vp8xFlags = 0;
+        DataBuf rawExif;
+        DataBuf rawXmp;
+        DataBuf iccData;
+
+        DataBuf chunkId(WEBP_TAG_SIZE + 1);
+        chunkId.write_uint8(WEBP_TAG_SIZE, '\0');
+        byte size_buff[WEBP_TAG_SIZE];
+        while (!io_->eof() && static_cast<uint64_t>(io_->tell()) < filesize) {
+            io_->readOrThrow(chunkId.data(), WEBP_TAG_SIZE, Exiv2::kerCorruptedMetadata);
+            io_->readOrThrow(size_buff, WEBP_TAG_SIZE, Exiv2::kerCorruptedMetadata);
+            const uint32_t size = Exiv2::getULong(size_buff, littleEndian);
+            const long pos = io_->tell();
+            enforce(size <= filesize - static_cast<uint64_t>(pos), Exiv2::kerCorruptedMetadata);
+
+            // Reject the chunks which doWriteMetadata() rejects
+            if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_VP8X) || equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_VP8)) {
+                enforce(size >= 10, Exiv2::kerCorruptedMetadata);
+            } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_VP8L)) {
+                enforce(size >= 5, Exiv2::kerCorruptedMetadata);
+            } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_ANMF)) {
+                enforce(size >= 12, Exiv2::kerCorruptedMetadata);
+            }
+
+            DataBuf payload;
+            if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_VP8X) || equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_EXIF) ||
+                equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_XMP) || equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_ICCP)) {
+                payload.alloc(size);
+                io_->readOrThrow(payload.data(), size, Exiv2::kerCorruptedMetadata);
+            } else {
+                io_->seekOrThrow(size, BasicIo::cur, Exiv2::kerCorruptedMetadata);
+            }
+            if (io_->tell() % 2)
+                io_->seek(+1, BasicIo::cur);  // skip pad
+
+            if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_VP8X)) {
+                if (vp8xPos != -1)
+                    return false;
+                vp8xPos = pos;
+                vp8xFlags = payload.read_uint8(0);
+            } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_EXIF)) {
+                if (exifPos != -1)
+                    return false;
+                exifPos = pos;
+                rawExif = std::move(payload);
+            } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_XMP)) {
+                if (xmpPos != -1)
+                    return false;
+                xmpPos = pos;
+                rawXmp = std::move(payload);
+            } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_ICCP)) {
+                ++iccCount;
+                iccData = std::move(payload);
+            }
+        }
+        if (vp8xPos == -1 || iccCount > 1)
+            return false;
+
+        Internal::InPlaceUpdate update;
+
+        Blob blob;
+        if (exifData_.count() > 0) {
+            ExifParser::encode(blob, littleEndian, exifData_);
+        }
+        if ((exifPos != -1) != !blob.empty())
+            return false;
+        if (exifPos != -1) {
+            if (blob.size() > static_cast<size_t>(rawExif.size()))
+                return false;
+            blob.resize(rawExif.size(), 0);
+            update.add(exifPos, rawExif.c_data(), &blob[0], blob.size());
+        }
+
+        if (xmpData_.count() > 0 && !writeXmpFromPacket()) {
+            XmpParser::encode(xmpPacket_, xmpData_,
+                              XmpParser::useCompactFormat |
+                              XmpParser::omitAllFormatting);
+        }
+        if ((xmpPos != -1) != !xmpPacket_.empty())
+            return false;
+        if (xmpPos != -1) {
+            std::string xmpPacket(xmpPacket_);
+            if (!Internal::padXmpPacket(xmpPacket, rawXmp.size()))
+                return false;
+            update.add(xmpPos, rawXmp.c_data(), reinterpret_cast<const byte*>(xmpPacket.data()), xmpPacket.size());
+        }
+
+        if ((iccCount == 1) != iccProfileDefined())
+            return false;
+        if (iccCount == 1 && (iccData.size() != iccProfile_.size() ||
+                              iccData.cmpBytes(0, iccProfile_.c_data(), iccProfile_.size()) != 0)) {
+            return false;
+        }
+
+        // Keep the feature flags consistent, as doWriteMetadata() does
+        auto flags = static_cast<byte>(vp8xFlags & ~(WEBP_VP8X_ICC_BIT | WEBP_VP8X_XMP_BIT | WEBP_VP8X_EXIF_BIT));
+        if (iccCount == 1)
+            flags |= WEBP_VP8X_ICC_BIT;
+        if (xmpPos != -1)
+            flags |= WEBP_VP8X_XMP_BIT;
+        if (exifPos != -1)
+            flags |= WEBP_VP8X_EXIF_BIT;
+        update.add(vp8xPos, &vp8xFlags, &flags, 1);
+
+        return update.apply(*io_);
+    } // WebPImage::writeMetadataInPlace
+
 
     void WebPImage::doWriteMetadata(BasicIo& outIo)
     {
@@ -355,6 +484,7 @@ namespace Exiv2 {
         }
 
         io_->seek(12, BasicIo::beg);
+        const size_t imgSize = io_->size();
         while (!io_->eof() && static_cast<uint64_t>(io_->tell()) < filesize) {
             io_->readOrThrow(chunkId.data(), 4, Exiv2::kerCorruptedMetadata);
             io_->readOrThrow(size_buff, 4, Exiv2::kerCorruptedMetadata);
@@ -365,12 +495,12 @@ namespace Exiv2 {
             enforce(size_u32 <= static_cast<size_t>(std::numeric_limits<unsigned int>::max()),
                     Exiv2::kerCorruptedMetadata);
             const long size = static_cast<long>(size_u32);
-
-            DataBuf payload(size);
-            io_->readOrThrow(payload.data(), size, Exiv2::kerCorruptedMetadata);
-            if ( io_->tell() % 2 ) io_->seek(+1,BasicIo::cur); // skip pad
+            const long pos = io_->tell();
+            enforce(size_u32 <= imgSize - pos, Exiv2::kerCorruptedMetadata);
 
             if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_VP8X)) {
+                DataBuf payload(size);
+                io_->readOrThrow(payload.data(), size, Exiv2::kerCorruptedMetadata);
                 enforce(size >= 1, Exiv2::kerCorruptedMetadata);
                 if (has_icc){
                     const uint8_t x = payload.read_uint8(0);
@@ -419,18 +549,21 @@ namespace Exiv2 {
                 }
             } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_ICCP)) {
                 // Skip it altogether handle it prior to here :)
+                io_->seek(size, BasicIo::cur);
             } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_EXIF)) {
                 // Skip and add new data afterwards
+                io_->seek(size, BasicIo::cur);
             } else if (equalsWebPTag(chunkId, WEBP_CHUNK_HEADER_XMP)) {
                 // Skip and add new data afterwards
+                io_->seek(size, BasicIo::cur);
             } else {
                 if (outIo.write(chunkId.c_data(), WEBP_TAG_SIZE) != WEBP_TAG_SIZE)
                     throw Error(kerImageWriteFailed);
                 if (outIo.write(size_buff, WEBP_TAG_SIZE) != WEBP_TAG_SIZE)
                     throw Error(kerImageWriteFailed);
-                if (outIo.write(payload.c_data(), payload.size()) != payload.size())
-                    throw Error(kerImageWriteFailed);
+                outIo.copyFrom(*io_, pos, size);
             }
+            if ( io_->tell() % 2 ) io_->seek(+1,BasicIo::cur); // skip pad
 
             // Encoder required to pad odd sized data with a null byte
             if (outIo.tell() % 2) {
@@ -554,6 +687,7 @@ namespace Exiv2 {
             throw Error(kerNotAJpeg);
         }
         clearMetadata();
+        exifFiltered_ = !exifFilter_.empty();
 
         byte data[12];
         DataBuf chunkId(5);
@@ -743,7 +877,8 @@ namespace Exiv2 {
                     XmpData  xmpData;
                     ByteOrder bo = ExifParser::decode(exifData_,
                                                       payload.c_data(pos),
-                                                      payload.size() - pos);
+                                                      payload.size() - pos,
+                                                      &exifFilter_);
                     setByteOrder(bo);
                 }
                 else
@@ -29,7 +29,14 @@
 #include <iostream>
 #include <algorithm>
 #include <cassert>
+#include <cctype>
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 // Adobe XMP Toolkit
 #ifdef   EXV_HAVE_XMP_TOOLKIT
@@ -48,7 +55,8 @@
 // libexpat to do a basic validation check on an XML document. This is to
 // reduce the chance of hitting a bug in the (third-party) xmpsdk
 // library. For example, it is easy to a trigger a stack overflow in xmpsdk
-// with a deeply nested tree.
+// with a deeply nested tree. The XmpPacketDecoder class derived from it
+// decodes the common XMP packets in the same pass.
 namespace {
     using namespace Exiv2;
 
@@ -75,43 +83,20 @@ namespace {
 
         const XML_Parser parser_;
 
-    public:
-        // Runs an XML parser on `buf`. Throws an exception if the XML is invalid.
-        static void check(const char* buf, size_t buflen) {
-            XMLValidator validator;
-            validator.check_internal(buf, buflen);
-        }
-
-    private:
-        // Private constructor, because this class is only constructed by
-        // the (static) check method.
+    protected:
+        // Protected constructor, because this class is only constructed as
+        // the base of a class which handles the parsed document.
         XMLValidator() : parser_(XML_ParserCreateNS(0, '@')) {
             if (!parser_) {
                 throw Error(kerXMPToolkitError, "Could not create expat parser");
             }
         }
 
-        ~XMLValidator() {
+        virtual ~XMLValidator() {
             XML_ParserFree(parser_);
         }
 
-        void setError(const char* msg) {
-            const XML_Size errlinenum = XML_GetCurrentLineNumber(parser_);
-            const XML_Size errcolnum = XML_GetCurrentColumnNumber(parser_);
-#ifndef SUPPRESS_WARNINGS
-            EXV_INFO << "Invalid XML at line " << errlinenum
-                     << ", column " << errcolnum
-                     << ": " << msg << "\n";
-#endif
-            // If this is the first error, then save it.
-            if (!haserror_) {
-                haserror_ = true;
-                errmsg_ = msg;
-                errlinenum_ = errlinenum;
-                errcolnum_ = errcolnum;
-            }
-        }
-
+        // Runs an XML parser on `buf`. Throws an exception if the XML is invalid.
         void check_internal(const char* buf, size_t buflen) {
             if (buflen > static_cast<size_t>(std::numeric_limits<int>::max())) {
                 throw Error(kerXMPToolkitError, "Buffer length is greater than INT_MAX");
@@ -121,6 +106,9 @@ namespace {
             XML_SetElementHandler(parser_, startElement_cb, endElement_cb);
             XML_SetNamespaceDeclHandler(parser_, startNamespace_cb, endNamespace_cb);
             XML_SetStartDoctypeDeclHandler(parser_, startDTD_cb);
+            XML_SetCharacterDataHandler(parser_, characterData_cb);
+            XML_SetProcessingInstructionHandler(parser_, processingInstruction_cb);
+            XML_SetXmlDeclHandler(parser_, xmlDecl_cb);
 
             const XML_Status result = XML_Parse(parser_, buf, static_cast<int>(buflen), true);
             if (result == XML_STATUS_ERROR) {
@@ -132,26 +120,56 @@ namespace {
             }
         }
 
-        void startElement(const XML_Char*, const XML_Char**) noexcept {
+        // The events of the parsed document, passed on to the derived class
+        // after they have been checked. Expat names are "URI@localname".
+        virtual void onStartElement(const XML_Char* name, const XML_Char** attrs) noexcept = 0;
+        virtual void onEndElement() noexcept = 0;
+        virtual void onStartNamespace(const XML_Char* prefix, const XML_Char* uri) noexcept = 0;
+        virtual void onCharacterData(const XML_Char* s, int len) noexcept = 0;
+        virtual void onProcessingInstruction(const XML_Char* target) noexcept = 0;
+        virtual void onXmlDecl(const XML_Char* encoding) noexcept = 0;
+
+    private:
+        void setError(const char* msg) {
+            const XML_Size errlinenum = XML_GetCurrentLineNumber(parser_);
+            const XML_Size errcolnum = XML_GetCurrentColumnNumber(parser_);
+#ifndef SUPPRESS_WARNINGS
+            EXV_INFO << "Invalid XML at line " << errlinenum
+                     << ", column " << errcolnum
+                     << ": " << msg << "\n";
+#endif
+            // If this is the first error, then save it.
+            if (!haserror_) {
+                haserror_ = true;
+                errmsg_ = msg;
+                errlinenum_ = errlinenum;
+                errcolnum_ = errcolnum;
+            }
+        }
+
+        void startElement(const XML_Char* name, const XML_Char** attrs) noexcept {
             if (element_depth_ > max_recursion_limit_) {
                 setError("Too deeply nested");
             }
             ++element_depth_;
+            onStartElement(name, attrs);
         }
 
         void endElement(const XML_Char*) noexcept {
             if (element_depth_ > 0) {
                 --element_depth_;
+                onEndElement();
             } else {
                 setError("Negative depth");
             }
         }
 
-        void startNamespace(const XML_Char*, const XML_Char*) noexcept {
+        void startNamespace(const XML_Char* prefix, const XML_Char* uri) noexcept {
             if (namespace_depth_ > max_recursion_limit_) {
                 setError("Too deeply nested");
             }
             ++namespace_depth_;
+            onStartNamespace(prefix, uri);
         }
 
         void endNamespace(const XML_Char*) noexcept {
@@ -202,7 +220,586 @@ namespace {
             static_cast<XMLValidator*>(userData)->startDTD(
                 doctypeName, sysid, pubid, has_internal_subset);
         }
+
+        static void XMLCALL characterData_cb(void* userData, const XML_Char* s, int len) noexcept {
+            static_cast<XMLValidator*>(userData)->onCharacterData(s, len);
+        }
+
+        static void XMLCALL processingInstruction_cb(
+            void* userData, const XML_Char* target, const XML_Char* /*data*/
+        ) noexcept {
+            static_cast<XMLValidator*>(userData)->onProcessingInstruction(target);
+        }
+
+        static void XMLCALL xmlDecl_cb(
+            void* userData, const XML_Char* /*version*/, const XML_Char* encoding, int /*standalone*/
+        ) noexcept {
+            static_cast<XMLValidator*>(userData)->onXmlDecl(encoding);
+        }
     };
+
+    /*!
+      @brief Decode an XMP packet directly to XmpData in the pass which
+             validates it. Only the RDF forms commonly written by XMP
+             producers are decoded: simple properties as attributes or
+             elements, rdf:Bag, rdf:Seq and rdf:Alt arrays, language
+             alternatives, and structs written as nested rdf:Description,
+             with rdf:parseType="Resource" or with field attributes.
+             Anything else, e.g., qualifiers, rdf:value, namespace
+             declarations which the XMP toolkit doesn't know yet and the
+             properties which the toolkit touches up after parsing, leaves
+             the packet to the XMP toolkit.
+     */
+    class XmpPacketDecoder : public XMLValidator {
+    public:
+        /*!
+          @brief Validate \em xmpPacket and decode it to \em xmpData.
+
+          @return false, without changing \em xmpData, if the XMP toolkit
+                  needs to decode the packet.
+          @throw XMP_Error if the XML is invalid.
+         */
+        static bool decode(XmpData& xmpData, const std::string& xmpPacket);
+
+    private:
+        //! A property, struct field or array item of the packet
+        struct Node {
+            //! The kinds of nodes
+            enum Kind { simple, structure, array };
+
+            Kind kind_ = simple;                //!< Kind of the node
+            TypeId arrayType_ = invalidTypeId;  //!< xmpBag, xmpSeq or xmpAlt for an array
+            std::string name_;                  //!< Qualified name, empty for an array item
+            std::string value_;                 //!< Value of a simple node
+            bool hasLang_ = false;              //!< Whether an array item has an xml:lang attribute
+            std::string lang_;                  //!< Normalized xml:lang of an array item
+            std::vector<Node> children_;        //!< Fields of a struct or items of an array
+        };
+
+        //! A namespace declared in the packet
+        struct Namespace {
+            std::string uri_;                   //!< Namespace URI
+            std::string prefix_;                //!< Prefix, without the colon
+            int schema_ = -1;                   //!< Index of the schema in schemas_, -1 if none
+        };
+
+        //! The top level properties of a namespace, in the order of the XMP toolkit
+        struct Schema {
+            std::string ns_;                    //!< Namespace URI
+            std::string prefix_;                //!< Prefix, without the colon
+            std::vector<Node> properties_;      //!< Properties
+        };
+
+        //! The elements of the document which open a level of the decoder
+        enum class Frame {
+            xmpmeta,      //!< x:xmpmeta or x:xapmeta
+            rdf,          //!< rdf:RDF
+            description,  //!< Top level rdf:Description
+            property,     //!< Property, field or item, with a text value or one child element
+            resource,     //!< Struct property with rdf:parseType="Resource"
+            empty,        //!< Struct property with the fields as attributes and no content
+            node,         //!< rdf:Description of a struct property
+            array         //!< rdf:Bag, rdf:Seq or rdf:Alt of an array property
+        };
+
+        // Notifications of the XMLValidator
+        void onStartElement(const XML_Char* name, const XML_Char** attrs) noexcept override;
+        void onEndElement() noexcept override;
+        void onStartNamespace(const XML_Char* prefix, const XML_Char* uri) noexcept override;
+        void onCharacterData(const XML_Char* s, int len) noexcept override;
+        void onProcessingInstruction(const XML_Char* target) noexcept override;
+        void onXmlDecl(const XML_Char* encoding) noexcept override;
+
+        //! Start the property, field or array item element \em name
+        void startProperty(const XML_Char* name, const XML_Char** attrs);
+        //! Start the child element \em name of a property element
+        void startValue(const XML_Char* name, const XML_Char** attrs);
+        //! Add the attributes of an rdf:Description as fields of the current node
+        bool addFields(const XML_Char** attrs);
+        //! Add a completed property, field or item to its parent
+        void finishNode();
+        //! Check the items of a completed array
+        void checkArray(const Node& node);
+        //! Return the namespace of an Expat name and set \em qname to "prefix:localname"
+        Namespace* qualify(const XML_Char* name, std::string& qname);
+        //! Return true if the XMP toolkit would touch up a top level property after parsing
+        bool touchedUp() const;
+        //! Add \em node and its children to \em xmpData
+        static void add(XmpData& xmpData, const std::string& prefix, const std::string& path, const Node& node);
+        //! Return true if the array \em node is a language alternative
+        static bool isLangAlt(const Node& node);
+
+        // DATA
+        bool toolkit_ = false;                  //!< True if the XMP toolkit needs to decode the packet
+        bool rdfSeen_ = false;                  //!< True once the rdf:RDF element is started
+        std::vector<Namespace> namespaces_;     //!< Namespaces declared in the packet
+        std::vector<Schema> schemas_;           //!< Decoded properties
+        std::unordered_set<std::string> topLevelNames_;  //!< Qualified names of the top level properties
+        int schema_ = -1;                       //!< Index of the schema of the current top level property
+        std::vector<Frame> frames_;             //!< Open levels of the document
+        std::vector<Node> nodes_;               //!< Open properties, fields and items
+        std::string text_;                      //!< Character data of the current property
+    };
+
+    //! Namespace URI of the x:xmpmeta element
+    constexpr char xmpMetaNs[] = "adobe:ns:meta/";
+
+    //! Split an Expat name "URI@localname" into namespace URI and local name
+    std::pair<std::string_view, std::string_view> splitName(const XML_Char* name)
+    {
+        std::string_view n(name);
+        const auto pos = n.rfind('@');
+        if (pos == std::string_view::npos) return {std::string_view(), n};
+        return {n.substr(0, pos), n.substr(pos + 1)};
+    }
+
+    //! Return true if \em name is the Expat name of the RDF term \em term
+    bool isRdf(const XML_Char* name, std::string_view term)
+    {
+        const auto n = splitName(name);
+        return n.first == kXMP_NS_RDF && n.second == term;
+    }
+
+    //! Return true if \em s only contains XML whitespace
+    bool isWhitespace(std::string_view s)
+    {
+        return s.find_first_not_of(" \t\n\r") == std::string_view::npos;
+    }
+
+    /*!
+      @brief Return true if the XMP toolkit replaces characters of \em xmpPacket
+             before parsing it: ASCII DEL characters and numeric escapes
+             "&#xHH;" other than those of tab, LF and CR.
+     */
+    bool hasReplacedChars(const std::string& xmpPacket)
+    {
+        if (xmpPacket.find('\x7f') != std::string::npos) return true;
+        for (auto pos = xmpPacket.find("&#x"); pos != std::string::npos; pos = xmpPacket.find("&#x", pos + 3)) {
+            // The toolkit only looks at up to two hex digits
+            auto end = pos + 3;
+            while (end < xmpPacket.size() && end < pos + 5 && std::isxdigit(static_cast<unsigned char>(xmpPacket[end]))) {
+                ++end;
+            }
+            if (end == pos + 3 || end == xmpPacket.size() || xmpPacket[end] != ';') continue;
+            const auto value = std::stoi(xmpPacket.substr(pos + 3, end - pos - 3), nullptr, 16);
+            if (value != '\t' && value != '\n' && value != '\r') return true;
+        }
+        return false;
+    }
+
+    //! Normalize an xml:lang value like the XMP toolkit: lowercase, except for a two letter second subtag
+    void normalizeLang(std::string& lang)
+    {
+        std::transform(lang.begin(), lang.end(), lang.begin(), [](char c) { return c >= 'A' && c <= 'Z' ? c + 0x20 : c; });
+        const auto first = lang.find('-');
+        if (first == std::string::npos) return;
+        const auto second = lang.find('-', first + 1);
+        if ((second == std::string::npos ? lang.size() : second) - first != 3) return;
+        for (auto i = first + 1; i < first + 3; ++i) {
+            if (lang[i] >= 'a' && lang[i] <= 'z') lang[i] -= 0x20;
+        }
+    }
+
+    bool XmpPacketDecoder::decode(XmpData& xmpData, const std::string& xmpPacket)
+    {
+        XmpPacketDecoder decoder;
+        // The XMP toolkit converts UTF-16 and UTF-32 packets itself
+        const auto first = static_cast<byte>(xmpPacket[0]);
+        decoder.toolkit_ = first == 0 || first == 0xfe || first == 0xff || hasReplacedChars(xmpPacket);
+        decoder.check_internal(xmpPacket.data(), xmpPacket.size());
+        if (decoder.toolkit_ || decoder.touchedUp()) return false;
+
+        for (auto&& schema : decoder.schemas_) {
+            // Register unknown namespaces with Exiv2, the prefix is that of the XMP toolkit
+            if (XmpProperties::prefix(schema.ns_).empty()) {
+                XmpProperties::registerNs(schema.ns_, schema.prefix_);
+            }
+            const std::string prefix = XmpProperties::prefix(schema.ns_);
+            for (auto&& property : schema.properties_) {
+                if (prefix.empty()) {
+                    throw Error(kerNoPrefixForNamespace, property.name_, schema.ns_);
+                }
+                add(xmpData, prefix, property.name_.substr(schema.prefix_.size() + 1), property);
+            }
+        }
+        return true;
+    }
+
+    void XmpPacketDecoder::onStartElement(const XML_Char* name, const XML_Char** attrs) noexcept
+    {
+        if (toolkit_) return;
+        const Frame parent = frames_.empty() ? Frame::xmpmeta : frames_.back();
+        switch (parent) {
+        case Frame::xmpmeta: {
+            const auto n = splitName(name);
+            if (frames_.empty() && n.first == xmpMetaNs && (n.second == "xmpmeta" || n.second == "xapmeta")) {
+                frames_.push_back(Frame::xmpmeta);
+            } else if (isRdf(name, "RDF") && !rdfSeen_ && attrs[0] == nullptr) {
+                rdfSeen_ = true;
+                frames_.push_back(Frame::rdf);
+            } else {
+                toolkit_ = true;
+            }
+            break;
+        }
+        case Frame::rdf:
+            // A top level rdf:Description, its attributes are simple properties
+            if (!isRdf(name, "Description")) {
+                toolkit_ = true;
+                return;
+            }
+            for (auto attr = attrs; *attr != nullptr && !toolkit_; attr += 2) {
+                if (isRdf(attr[0], "about")) {
+                    // A named tree would get an xmpMM:InstanceID
+                    toolkit_ = *attr[1] != '\0';
+                    continue;
+                }
+                Node node;
+                Namespace* ns = qualify(attr[0], node.name_);
+                if (ns == nullptr || !topLevelNames_.insert(node.name_).second) {
+                    toolkit_ = true;
+                    return;
+                }
+                node.value_ = attr[1];
+                if (ns->schema_ < 0) {
+                    ns->schema_ = static_cast<int>(schemas_.size());
+                    schemas_.push_back({ns->uri_, ns->prefix_, {}});
+                }
+                schemas_[ns->schema_].properties_.push_back(std::move(node));
+            }
+            frames_.push_back(Frame::description);
+            break;
+        case Frame::description:
+        case Frame::resource:
+        case Frame::node:
+        case Frame::array:
+            startProperty(name, attrs);
+            break;
+        case Frame::property:
+            startValue(name, attrs);
+            break;
+        case Frame::empty:
+            toolkit_ = true;
+            break;
+        }
+    }
+
+    void XmpPacketDecoder::startProperty(const XML_Char* name, const XML_Char** attrs)
+    {
+        const Frame parent = frames_.back();
+        Node node;
+        if (parent == Frame::array) {
+            if (!isRdf(name, "li")) {
+                toolkit_ = true;
+                return;
+            }
+        } else {
+            Namespace* ns = qualify(name, node.name_);
+            if (ns == nullptr) {
+                toolkit_ = true;
+                return;
+            }
+            if (parent == Frame::description) {
+                // The toolkit drops old iX:changes properties
+                if (node.name_ == "iX:changes" || !topLevelNames_.insert(node.name_).second) {
+                    toolkit_ = true;
+                    return;
+                }
+                if (ns->schema_ < 0) {
+                    ns->schema_ = static_cast<int>(schemas_.size());
+                    schemas_.push_back({ns->uri_, ns->prefix_, {}});
+                }
+                schema_ = ns->schema_;
+            } else {
+                for (auto&& field : nodes_.back().children_) {
+                    if (field.name_ == node.name_) {
+                        toolkit_ = true;
+                        return;
+                    }
+                }
+            }
+        }
+
+        Frame frame = Frame::property;
+        if (attrs[0] != nullptr && attrs[2] == nullptr && isRdf(attrs[0], "parseType")) {
+            if (std::strcmp(attrs[1], "Resource") != 0) {
+                toolkit_ = true;
+                return;
+            }
+            node.kind_ = Node::structure;
+            frame = Frame::resource;
+        } else if (attrs[0] != nullptr && attrs[2] == nullptr
+                   && std::strcmp(attrs[0], kXMP_NS_XML "@lang") == 0) {
+            // Only the items of a language alternative may have an xml:lang
+            if (parent != Frame::array || nodes_.back().arrayType_ != xmpAlt) {
+                toolkit_ = true;
+                return;
+            }
+            node.hasLang_ = true;
+            node.lang_ = attrs[1];
+            normalizeLang(node.lang_);
+        } else if (attrs[0] != nullptr) {
+            // An empty struct, the attributes are its fields
+            node.kind_ = Node::structure;
+            nodes_.push_back(std::move(node));
+            if (!addFields(attrs)) return;
+            frames_.push_back(Frame::empty);
+            return;
+        }
+        nodes_.push_back(std::move(node));
+        frames_.push_back(frame);
+        text_.clear();
+    }
+
+    void XmpPacketDecoder::startValue(const XML_Char* name, const XML_Char** attrs)
+    {
+        // A property element has either text or a single child element
+        Node& node = nodes_.back();
+        if (node.kind_ != Node::simple || node.hasLang_ || !isWhitespace(text_)) {
+            toolkit_ = true;
+            return;
+        }
+        if (isRdf(name, "Description")) {
+            node.kind_ = Node::structure;
+            if (!addFields(attrs)) return;
+            frames_.push_back(Frame::node);
+            return;
+        }
+        if (attrs[0] != nullptr) {
+            toolkit_ = true;
+            return;
+        }
+        if (isRdf(name, "Bag")) {
+            node.arrayType_ = xmpBag;
+        } else if (isRdf(name, "Seq")) {
+            node.arrayType_ = xmpSeq;
+        } else if (isRdf(name, "Alt")) {
+            node.arrayType_ = xmpAlt;
+        } else {
+            toolkit_ = true;
+            return;
+        }
+        node.kind_ = Node::array;
+        frames_.push_back(Frame::array);
+    }
+
+    bool XmpPacketDecoder::addFields(const XML_Char** attrs)
+    {
+        Node& node = nodes_.back();
+        for (auto attr = attrs; *attr != nullptr; attr += 2) {
+            Node field;
+            if (qualify(attr[0], field.name_) == nullptr) {
+                toolkit_ = true;
+                return false;
+            }
+            field.value_ = attr[1];
+            node.children_.push_back(std::move(field));
+        }
+        return true;
+    }
+
+    void XmpPacketDecoder::onEndElement() noexcept
+    {
+        if (toolkit_) return;
+        const Frame frame = frames_.back();
+        frames_.pop_back();
+        switch (frame) {
+        case Frame::property:
+            if (nodes_.back().kind_ == Node::simple) {
+                nodes_.back().value_ = std::move(text_);
+                text_.clear();
+            }
+            finishNode();
+            break;
+        case Frame::resource:
+        case Frame::empty:
+            finishNode();
+            break;
+        case Frame::array:
+            checkArray(nodes_.back());
+            break;
+        default:
+            break;
+        }
+    }
+
+    void XmpPacketDecoder::finishNode()
+    {
+        Node node = std::move(nodes_.back());
+        nodes_.pop_back();
+        if (frames_.back() == Frame::description) {
+            schemas_[schema_].properties_.push_back(std::move(node));
+        } else {
+            nodes_.back().children_.push_back(std::move(node));
+        }
+    }
+
+    void XmpPacketDecoder::checkArray(const Node& node)
+    {
+        // Either all items have a distinct xml:lang or none has one
+        LangAltValue::ValueType langs;
+        for (auto&& item : node.children_) {
+            if (   item.hasLang_ != node.children_.front().hasLang_
+                || (item.hasLang_ && !langs.emplace(item.lang_, std::string()).second)) {
+                toolkit_ = true;
+                return;
+            }
+        }
+    }
+
+    void XmpPacketDecoder::onStartNamespace(const XML_Char* prefix, const XML_Char* uri) noexcept
+    {
+        if (toolkit_) return;
+        // The toolkit registers the namespaces of a packet and maps an old Dublin Core URI
+        if (prefix == nullptr || uri == nullptr || std::strcmp(uri, "http://purl.org/dc/1.1/") == 0) {
+            toolkit_ = true;
+            return;
+        }
+        for (auto&& ns : namespaces_) {
+            if (ns.uri_ == uri || ns.prefix_ == prefix) {
+                toolkit_ = ns.uri_ != uri || ns.prefix_ != prefix;
+                return;
+            }
+        }
+        try {
+            std::string registeredPrefix, registeredNs;
+            toolkit_ =  !SXMPMeta::GetNamespacePrefix(uri, &registeredPrefix)
+                     || registeredPrefix != std::string(prefix) + ":"
+                     || !SXMPMeta::GetNamespaceURI(prefix, &registeredNs)
+                     || registeredNs != uri;
+        }
+        catch (const XMP_Error&) {
+            toolkit_ = true;
+        }
+        if (!toolkit_) namespaces_.push_back({uri, prefix});
+    }
+
+    void XmpPacketDecoder::onCharacterData(const XML_Char* s, int len) noexcept
+    {
+        if (toolkit_ || frames_.empty()) return;
+        const std::string_view data(s, len);
+        if (frames_.back() == Frame::property && nodes_.back().kind_ == Node::simple) {
+            text_.append(data);
+        } else if (frames_.back() == Frame::empty || !isWhitespace(data)) {
+            toolkit_ = true;
+        }
+    }
+
+    void XmpPacketDecoder::onProcessingInstruction(const XML_Char* target) noexcept
+    {
+        // The toolkit keeps xpacket instructions in the XML tree
+        if (!frames_.empty() && std::strcmp(target, "xpacket") == 0) toolkit_ = true;
+    }
+
+    void XmpPacketDecoder::onXmlDecl(const XML_Char* encoding) noexcept
+    {
+        // The toolkit reads 8-bit packets as UTF-8 with Latin-1 fallback
+        if (encoding == nullptr) return;
+        std::string enc(encoding);
+        std::transform(enc.begin(), enc.end(), enc.begin(), [](char c) { return c >= 'a' && c <= 'z' ? c - 0x20 : c; });
+        if (enc != "UTF-8") toolkit_ = true;
+    }
+
+    XmpPacketDecoder::Namespace* XmpPacketDecoder::qualify(const XML_Char* name, std::string& qname)
+    {
+        const auto n = splitName(name);
+        if (n.first == kXMP_NS_RDF) return nullptr;
+        for (auto&& ns : namespaces_) {
+            if (ns.uri_ == n.first) {
+                qname.reserve(ns.prefix_.size() + 1 + n.second.size());
+                qname.assign(ns.prefix_).append(1, ':').append(n.second);
+                return &ns;
+            }
+        }
+        return nullptr;
+    }
+
+    bool XmpPacketDecoder::touchedUp() const
+    {
+        // The prefixes of the names are those of the XMP toolkit, see onStartNamespace()
+        static const char* const dcArrays[] = {
+            "dc:contributor", "dc:creator", "dc:date", "dc:description", "dc:language", "dc:publisher",
+            "dc:relation", "dc:rights", "dc:subject", "dc:title", "dc:type",
+        };
+        static const char* const langAlts[] = {
+            "dc:description", "dc:rights", "dc:title", "xmpRights:UsageTerms", "exif:UserComment",
+        };
+        for (auto&& schema : schemas_) {
+            for (auto&& property : schema.properties_) {
+                const std::string& name = property.name_;
+                // Aliases are moved to their base properties
+                const std::string localName = name.substr(schema.prefix_.size() + 1);
+                if (SXMPMeta::ResolveAlias(schema.ns_.c_str(), localName.c_str(), nullptr, nullptr, nullptr)) {
+                    return true;
+                }
+                if (   name == "exif:GPSTimeStamp" || name == "xmpDM:copyright"
+                    || (name == "exif:UserComment" && property.kind_ != Node::array)
+                    || (name == "dc:subject" && property.kind_ == Node::array && property.arrayType_ != xmpBag)) {
+                    return true;
+                }
+                if (   property.kind_ == Node::simple
+                    && std::find(std::begin(dcArrays), std::end(dcArrays), name) != std::end(dcArrays)) {
+                    return true;
+                }
+                if (   property.kind_ == Node::array && !isLangAlt(property)
+                    && std::find(std::begin(langAlts), std::end(langAlts), name) != std::end(langAlts)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    bool XmpPacketDecoder::isLangAlt(const Node& node)
+    {
+        return node.arrayType_ == xmpAlt && !node.children_.empty() && node.children_.front().hasLang_;
+    }
+
+    void XmpPacketDecoder::add(XmpData& xmpData, const std::string& prefix, const std::string& path, const Node& node)
+    {
+        const XmpKey key(prefix, path);
+        if (node.kind_ == Node::simple) {
+            XmpTextValue val;
+            val.read(node.value_);
+            xmpData.add(key, &val);
+            return;
+        }
+        if (isLangAlt(node)) {
+            LangAltValue val;
+            for (auto&& item : node.children_) {
+                val.value_[item.lang_] = item.value_;
+            }
+            xmpData.add(key, &val);
+            return;
+        }
+        const bool simpleArray = node.kind_ == Node::array
+            && std::all_of(node.children_.begin(), node.children_.end(),
+                           [](const Node& item) { return item.kind_ == Node::simple; });
+        if (simpleArray) {
+            XmpArrayValue val(node.arrayType_);
+            for (auto&& item : node.children_) {
+                val.read(item.value_);
+            }
+            xmpData.add(key, &val);
+            return;
+        }
+        // A struct or an array with composite items, followed by its fields or items
+        XmpTextValue val;
+        if (node.kind_ == Node::structure) {
+            val.setXmpStruct();
+        } else {
+            val.setXmpArrayType(XmpValue::xmpArrayType(node.arrayType_));
+        }
+        xmpData.add(key, &val);
+        for (size_t i = 0; i < node.children_.size(); ++i) {
+            const Node& child = node.children_[i];
+            if (node.kind_ == Node::structure) {
+                add(xmpData, prefix, path + "/" + child.name_, child);
+            } else {
+                add(xmpData, prefix, path + "[" + toString(i + 1) + "]", child);
+            }
+        }
+    }
 }  // namespace
 #endif // EXV_HAVE_XMP_TOOLKIT
 
@@ -256,6 +853,83 @@ namespace {
     //! Make an XMP key from a schema namespace and property path
     Exiv2::XmpKey::UniquePtr makeXmpKey(const std::string& schemaNs,
                                       const std::string& propPath);
+
+    /*!
+      @brief Serialize XmpData to an XMP packet without building an XMP
+             toolkit tree. The packet is the same as that of
+             SXMPMeta::SerializeToBuffer() for the tree which
+             XmpParser::encode() would set up. Metadata which needs the
+             toolkit, e.g., keys with qualifier steps, duplicate keys,
+             aliases and values which are not valid UTF-8, is left to it.
+     */
+    class XmpPacketEncoder {
+    public:
+        /*!
+          @brief Encode \em xmpData to \em xmpPacket.
+
+          @return false, without changing \em xmpPacket, if the XMP toolkit
+                  needs to encode the metadata.
+         */
+        static bool encode(std::string& xmpPacket, const Exiv2::XmpData& xmpData,
+                           XMP_OptionBits options, uint32_t padding);
+
+    private:
+        //! A property, struct field or array item, like an XMP_Node of the toolkit
+        struct Node {
+            std::string name_;                  //!< Qualified name, "[]" for an array item
+            std::string value_;                 //!< Value of a simple node
+            XMP_OptionBits options_ = 0;        //!< Toolkit options of the node
+            std::string lang_;                  //!< xml:lang qualifier, if options_ has kXMP_PropHasLang
+            std::vector<size_t> children_;      //!< Indexes of the fields or items in nodes_
+        };
+
+        //! The top level properties of a namespace
+        struct Schema {
+            std::string ns_;                    //!< Namespace URI
+            std::string prefix_;                //!< Prefix, with the colon
+            std::vector<size_t> properties_;    //!< Indexes of the properties in nodes_
+        };
+
+        //! Add an Xmpdatum to the tree, return false if the toolkit needs to do it
+        bool add(const Exiv2::Xmpdatum& xmpdatum);
+        //! Create the node for \em path in schema \em ns, return its index or -1
+        long addNode(const std::string& ns, const std::string& prefix, const std::string& path,
+                     XMP_OptionBits options);
+        //! Return true if the prefix of the qualified name \em name is known to the toolkit
+        bool isKnownPrefix(const std::string& name);
+
+        //! Write the namespace declarations for \em node and its descendants
+        void declareUsedNamespaces(const Node& node, std::string& usedNs);
+        //! Write a namespace declaration unless it is in \em usedNs
+        void declareOneNamespace(const std::string& prefix, const std::string& ns, std::string& usedNs);
+        //! Write a property element of the canonical format
+        void serializePrettyProperty(const Node& node, int level);
+        //! Write the rdf:Description of a schema in the canonical format
+        void serializePrettySchema(const Schema& schema);
+        //! Write the simple unqualified fields of \em children as attributes
+        bool serializeCompactAttrProps(const std::vector<size_t>& children, int level);
+        //! Write the other fields of \em children as property elements of the compact format
+        void serializeCompactElemProps(const std::vector<size_t>& children, int level);
+        //! Write the rdf:Description of all schemas in the compact format
+        void serializeCompactSchemas();
+        //! Write the opening or closing rdf:Bag, rdf:Seq or rdf:Alt tag of an array
+        void emitArrayTag(const Node& node, int level, bool isStartTag);
+        //! Append \em value, escaped for an element or an attribute
+        void appendValue(const std::string& value, bool forAttribute);
+        //! Append \em level indentations
+        void indent(int level);
+
+        // DATA
+        std::vector<Node> nodes_;               //!< All nodes of the tree
+        std::vector<Schema> schemas_;           //!< Schemas in the order of their first property
+        std::unordered_map<std::string, size_t> paths_;       //!< Index of the node for "URI path"
+        std::unordered_map<std::string, std::string> prefixes_;  //!< Toolkit URI of the prefixes used
+        //! Namespace URI and toolkit prefix of the Exiv2 groups used
+        std::unordered_map<std::string, std::pair<std::string, std::string>> groups_;
+        std::string out_;                       //!< Packet being written
+        const char* newline_ = "\n";            //!< Newline of the format
+        const char* indent_ = "   ";            //!< Indentation of the format
+    };
 #endif // EXV_HAVE_XMP_TOOLKIT
 
     //! Helper class used to serialize critical sections
@@ -716,6 +1390,15 @@ namespace Exiv2 {
         try {
             initialize();
             AutoLock autoLock(xmpLockFct_, pLockData_);
+            // encode() registers all custom namespaces each time, don't change a registration
+            // which other threads may be using when it is already in place
+            std::string registeredPrefix, registeredNs;
+            if (   SXMPMeta::GetNamespacePrefix(ns.c_str(), &registeredPrefix)
+                && registeredPrefix == prefix + ":"
+                && SXMPMeta::GetNamespaceURI(prefix.c_str(), &registeredNs)
+                && registeredNs == ns) {
+                return;
+            }
             SXMPMeta::DeleteNamespace(ns.c_str());
 #ifdef EXV_ADOBE_XMPSDK
             SXMPMeta::RegisterNamespace(ns.c_str(), prefix.c_str(),NULL);
@@ -763,7 +1446,9 @@ namespace Exiv2 {
             return 2;
         }
 
-        XMLValidator::check(xmpPacket.data(), xmpPacket.size());
+        // Most packets are decoded in the pass which validates them, the
+        // XMP toolkit parses the rest
+        if (XmpPacketDecoder::decode(xmpData, xmpPacket)) return 0;
         SXMPMeta meta(xmpPacket.data(), static_cast<XMP_StringLen>(xmpPacket.size()));
         SXMPIterator iter(meta);
         std::string schemaNs, propPath, propValue;
@@ -918,6 +1603,11 @@ namespace Exiv2 {
 #endif
             registerNs(i.first, i.second.prefix_);
         }
+        // Most metadata is serialized directly, the XMP toolkit does the rest
+        if (XmpPacketEncoder::encode(xmpPacket, xmpData,
+                                     xmpFormatOptionBits(static_cast<XmpFormatFlags>(formatFlags)), padding)) {
+            return 0;
+        }
         SXMPMeta meta;
         for (auto&& i : xmpData) {
             const std::string ns = XmpProperties::ns(i.groupName());
@@ -1147,6 +1837,566 @@ namespace {
         }
         return std::make_unique<Exiv2::XmpKey>(prefix, property);
     } // makeXmpKey
+
+    //! Return true if \em name is an ASCII XML name without a colon
+    bool isSimpleXmlName(std::string_view name)
+    {
+        if (name.empty()) return false;
+        const auto isStartChar = [](char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+        };
+        if (!isStartChar(name[0])) return false;
+        return std::all_of(name.begin() + 1, name.end(), [&](char c) {
+            return isStartChar(c) || (c >= '0' && c <= '9') || c == '-' || c == '.';
+        });
+    }
+
+    //! Return true if \em s is well-formed UTF-8
+    bool isUtf8(const std::string& s)
+    {
+        for (size_t i = 0; i < s.size();) {
+            const auto c = static_cast<unsigned char>(s[i]);
+            size_t len = 1;
+            uint32_t cp = c;
+            if      (c < 0x80)           len = 1;
+            else if ((c & 0xe0) == 0xc0) { len = 2; cp = c & 0x1f; }
+            else if ((c & 0xf0) == 0xe0) { len = 3; cp = c & 0x0f; }
+            else if ((c & 0xf8) == 0xf0) { len = 4; cp = c & 0x07; }
+            else return false;
+            if (i + len > s.size()) return false;
+            for (size_t j = 1; j < len; ++j) {
+                const auto cc = static_cast<unsigned char>(s[i + j]);
+                if ((cc & 0xc0) != 0x80) return false;
+                cp = (cp << 6) | (cc & 0x3f);
+            }
+            static const uint32_t minCp[] = {0, 0, 0x80, 0x800, 0x10000};
+            if (cp < minCp[len] || cp > 0x10ffff || (cp >= 0xd800 && cp <= 0xdfff)) return false;
+            i += len;
+        }
+        return true;
+    }
+
+    /*!
+      @brief Set a node value like the XMP toolkit: the value ends at a NUL
+             character and ASCII control characters other than tab, LF and
+             CR become spaces. Return false if the value is not valid UTF-8.
+     */
+    bool setNodeValue(std::string& nodeValue, const std::string& value)
+    {
+        nodeValue.assign(value.c_str());
+        for (auto&& c : nodeValue) {
+            if ((c >= 0 && c < 0x20 && c != '\t' && c != '\n' && c != '\r') || c == 0x7f) c = ' ';
+        }
+        return isUtf8(nodeValue);
+    }
+
+    bool XmpPacketEncoder::encode(std::string& xmpPacket, const Exiv2::XmpData& xmpData,
+                                  XMP_OptionBits options, uint32_t padding)
+    {
+        XmpPacketEncoder encoder;
+        for (auto&& xmpdatum : xmpData) {
+            if (!encoder.add(xmpdatum)) return false;
+        }
+
+        // Check the options and set up the padding like SXMPMeta::SerializeToBuffer()
+        if (options & kXMP_ExactPacketLength) {
+            if (options & (kXMP_OmitPacketWrapper | kXMP_IncludeThumbnailPad)) return false;
+        } else if (options & kXMP_ReadOnlyPacket) {
+            if (options & (kXMP_OmitPacketWrapper | kXMP_IncludeThumbnailPad)) return false;
+            padding = 0;
+        } else if (options & kXMP_OmitPacketWrapper) {
+            if (options & kXMP_IncludeThumbnailPad) return false;
+            padding = 0;
+        } else {
+            if (padding == 0) padding = 2048;
+            if (options & kXMP_IncludeThumbnailPad) {
+                const auto thumbnails = encoder.paths_.find(std::string(kXMP_NS_XMP) + " Thumbnails");
+                if (thumbnails == encoder.paths_.end()) padding += 10000;
+            }
+        }
+        if (options & kXMP_OmitAllFormatting) {
+            encoder.newline_ = " ";
+            encoder.indent_ = "";
+        } else if (options & kXMP_UseCompactFormat) {
+            encoder.indent_ = " ";
+        }
+
+        XMP_VersionInfo versionInfo;
+        SXMPMeta::GetVersionInfo(&versionInfo);
+
+        // Reserve for the values, about 40 bytes of markup per node and the padding
+        size_t size = 512 + padding + 64 * encoder.schemas_.size();
+        for (auto&& node : encoder.nodes_) {
+            size += 2 * node.name_.size() + node.value_.size() + 40;
+        }
+        std::string& out = encoder.out_;
+        out.reserve(size + size / 4);
+
+        if (!(options & kXMP_OmitPacketWrapper)) {
+            out += "<?xpacket begin=\"\xef\xbb\xbf\" id=\"W5M0MpCehiHzreSzNTczkc9d\"?>";
+            out += encoder.newline_;
+        }
+        out += "<x:xmpmeta xmlns:x=\"adobe:ns:meta/\" x:xmptk=\"";
+        out += versionInfo.message;
+        out += "\">";
+        out += encoder.newline_;
+        encoder.indent(1);
+        out += "<rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\">";
+        out += encoder.newline_;
+        if (options & kXMP_UseCompactFormat) {
+            encoder.serializeCompactSchemas();
+        } else if (encoder.schemas_.empty()) {
+            encoder.indent(2);
+            out += "<rdf:Description rdf:about=\"\"/>";
+            out += encoder.newline_;
+        } else {
+            for (auto&& schema : encoder.schemas_) {
+                encoder.serializePrettySchema(schema);
+            }
+        }
+        encoder.indent(1);
+        out += "</rdf:RDF>";
+        out += encoder.newline_;
+        out += "</x:xmpmeta>";
+        out += encoder.newline_;
+
+        std::string tail;
+        if (!(options & kXMP_OmitPacketWrapper)) {
+            tail = options & kXMP_ReadOnlyPacket ? "<?xpacket end=\"r\"?>" : "<?xpacket end=\"w\"?>";
+        }
+        if (options & kXMP_ExactPacketLength) {
+            const size_t minSize = out.size() + tail.size();
+            if (minSize > padding) return false;
+            padding -= static_cast<uint32_t>(minSize);
+        }
+        // Lines of 100 spaces, the last newline written last
+        const size_t newlineLen = std::strlen(encoder.newline_);
+        if (padding < newlineLen) {
+            out.append(padding, ' ');
+        } else {
+            padding -= static_cast<uint32_t>(newlineLen);
+            while (padding >= 100 + newlineLen) {
+                out.append(100, ' ');
+                out += encoder.newline_;
+                padding -= static_cast<uint32_t>(100 + newlineLen);
+            }
+            out.append(padding, ' ');
+            out += encoder.newline_;
+        }
+        out += tail;
+
+        xmpPacket = std::move(out);
+        return true;
+    }
+
+    bool XmpPacketEncoder::add(const Exiv2::Xmpdatum& xmpdatum)
+    {
+        // The toolkit names the properties with its own prefix for the namespace
+        auto group = groups_.find(xmpdatum.groupName());
+        if (group == groups_.end()) {
+            std::string ns = Exiv2::XmpProperties::ns(xmpdatum.groupName());
+            std::string prefix;
+            if (!SXMPMeta::GetNamespacePrefix(ns.c_str(), &prefix)) return false;
+            group = groups_.emplace(xmpdatum.groupName(), std::make_pair(std::move(ns), std::move(prefix))).first;
+        }
+        const std::string& ns = group->second.first;
+        const std::string& prefix = group->second.second;
+        const std::string path = xmpdatum.tagName();
+
+        if (xmpdatum.typeId() == Exiv2::langAlt) {
+            const auto la = dynamic_cast<const Exiv2::LangAltValue*>(&xmpdatum.value());
+            if (la == nullptr) return false;
+            // Languages without a value are left out, and so is an array without items
+            long array = -1;
+            for (auto&& k : la->value_) {
+                if (k.second.empty()) continue;
+                if (array < 0) {
+                    array = addNode(ns, prefix, path, kXMP_PropValueIsArray | kXMP_PropArrayIsOrdered
+                                                          | kXMP_PropArrayIsAlternate);
+                    if (array < 0) return false;
+                }
+                Node item;
+                item.name_ = "[]";
+                item.options_ = kXMP_PropHasQualifiers | kXMP_PropHasLang;
+                if (!setNodeValue(item.value_, k.second) || !setNodeValue(item.lang_, k.first)) return false;
+                normalizeLang(item.lang_);
+                nodes_[array].children_.push_back(nodes_.size());
+                nodes_.push_back(std::move(item));
+            }
+            return true;
+        }
+
+        const auto val = dynamic_cast<const Exiv2::XmpValue*>(&xmpdatum.value());
+        if (val == nullptr) return false;
+        XMP_OptionBits options = xmpArrayOptionBits(val->xmpArrayType()) | xmpArrayOptionBits(val->xmpStruct());
+        if (options & kXMP_PropArrayIsAlternate) options |= kXMP_PropArrayIsOrdered;
+        if ((options & kXMP_PropValueIsStruct) && (options & kXMP_PropValueIsArray)) return false;
+
+        const auto typeId = xmpdatum.typeId();
+        if (typeId == Exiv2::xmpBag || typeId == Exiv2::xmpSeq || typeId == Exiv2::xmpAlt) {
+            if (!(options & kXMP_PropValueIsArray)) return false;
+            const long array = addNode(ns, prefix, path, options);
+            if (array < 0) return false;
+            for (long idx = 0; idx < xmpdatum.count(); ++idx) {
+                Node item;
+                item.name_ = "[]";
+                if (!setNodeValue(item.value_, xmpdatum.toString(idx))) return false;
+                nodes_[array].children_.push_back(nodes_.size());
+                nodes_.push_back(std::move(item));
+            }
+            return true;
+        }
+        if (typeId == Exiv2::xmpText) {
+            if (xmpdatum.count() != 0 && (options & kXMP_PropCompositeMask)) return false;
+            const long node = addNode(ns, prefix, path, options);
+            if (node < 0) return false;
+            return xmpdatum.count() == 0 || setNodeValue(nodes_[node].value_, xmpdatum.toString(0));
+        }
+        return false;
+    }
+
+    long XmpPacketEncoder::addNode(const std::string& ns, const std::string& prefix, const std::string& path,
+                                   XMP_OptionBits options)
+    {
+        std::string key = ns + " " + path;
+        if (paths_.find(key) != paths_.end()) return -1;
+
+        Node node;
+        node.options_ = options;
+        const auto pos = path.find_last_of("/[");
+        if (pos == std::string::npos) {
+            // A top level property, which must not be an alias
+            if (!isSimpleXmlName(path)) return -1;
+            node.name_ = prefix + path;
+            if (SXMPMeta::ResolveAlias(ns.c_str(), node.name_.c_str(), nullptr, nullptr, nullptr)) return -1;
+            auto schema = std::find_if(schemas_.begin(), schemas_.end(),
+                                       [&](const Schema& s) { return s.ns_ == ns; });
+            if (schema == schemas_.end()) {
+                schemas_.push_back({ns, prefix, {}});
+                schema = schemas_.end() - 1;
+            }
+            schema->properties_.push_back(nodes_.size());
+        } else {
+            // A struct field or array item of a node which is already there
+            const auto parent = paths_.find(ns + " " + path.substr(0, pos));
+            if (parent == paths_.end()) return -1;
+            const Node& parentNode = nodes_[parent->second];
+            if (path[pos] == '/') {
+                node.name_ = path.substr(pos + 1);
+                if (!(parentNode.options_ & kXMP_PropValueIsStruct) || !isKnownPrefix(node.name_)) return -1;
+                for (auto&& field : parentNode.children_) {
+                    if (nodes_[field].name_ == node.name_) return -1;
+                }
+            } else {
+                // Only the next item of an array
+                const std::string index = toString(parentNode.children_.size() + 1);
+                if (   !(parentNode.options_ & kXMP_PropValueIsArray)
+                    || path.compare(pos + 1, std::string::npos, index + "]") != 0) {
+                    return -1;
+                }
+                node.name_ = "[]";
+            }
+            nodes_[parent->second].children_.push_back(nodes_.size());
+        }
+        paths_.emplace(std::move(key), nodes_.size());
+        nodes_.push_back(std::move(node));
+        return static_cast<long>(nodes_.size() - 1);
+    }
+
+    bool XmpPacketEncoder::isKnownPrefix(const std::string& name)
+    {
+        const auto colon = name.find(':');
+        if (   colon == std::string::npos
+            || !isSimpleXmlName(std::string_view(name).substr(0, colon))
+            || !isSimpleXmlName(std::string_view(name).substr(colon + 1))) {
+            return false;
+        }
+        const std::string prefix = name.substr(0, colon + 1);
+        if (prefixes_.find(prefix) != prefixes_.end()) return true;
+        std::string ns;
+        if (!SXMPMeta::GetNamespaceURI(name.substr(0, colon).c_str(), &ns)) return false;
+        prefixes_.emplace(prefix, ns);
+        return true;
+    }
+
+    void XmpPacketEncoder::declareUsedNamespaces(const Node& node, std::string& usedNs)
+    {
+        if (node.options_ & kXMP_PropValueIsStruct) {
+            for (auto&& field : node.children_) {
+                const std::string& name = nodes_[field].name_;
+                const std::string prefix = name.substr(0, name.find(':') + 1);
+                declareOneNamespace(prefix, prefixes_[prefix], usedNs);
+            }
+        }
+        for (auto&& child : node.children_) {
+            declareUsedNamespaces(nodes_[child], usedNs);
+        }
+    }
+
+    void XmpPacketEncoder::declareOneNamespace(const std::string& prefix, const std::string& ns, std::string& usedNs)
+    {
+        // Like the toolkit, look for the prefix anywhere in the list
+        if (usedNs.find(prefix) != std::string::npos) return;
+        out_ += newline_;
+        indent(4);
+        out_ += "xmlns:";
+        out_.append(prefix, 0, prefix.size() - 1);
+        out_ += "=\"";
+        out_ += ns;
+        out_ += '"';
+        usedNs += prefix;
+    }
+
+    void XmpPacketEncoder::serializePrettyProperty(const Node& node, int level)
+    {
+        const std::string& elemName = node.name_[0] == '[' ? std::string("rdf:li") : node.name_;
+        indent(level);
+        out_ += '<';
+        out_ += elemName;
+        if (node.options_ & kXMP_PropHasLang) {
+            out_ += " xml:lang=\"";
+            appendValue(node.lang_, true);
+            out_ += '"';
+        }
+        bool emitEndTag = true;
+        bool indentEndTag = true;
+        if (!(node.options_ & kXMP_PropCompositeMask)) {
+            if (node.value_.empty()) {
+                out_ += "/>";
+                out_ += newline_;
+                emitEndTag = false;
+            } else {
+                out_ += '>';
+                appendValue(node.value_, false);
+                indentEndTag = false;
+            }
+        } else if (node.options_ & kXMP_PropValueIsArray) {
+            out_ += '>';
+            out_ += newline_;
+            emitArrayTag(node, level + 1, true);
+            for (auto&& child : node.children_) {
+                serializePrettyProperty(nodes_[child], level + 2);
+            }
+            emitArrayTag(node, level + 1, false);
+        } else if (node.children_.empty()) {
+            out_ += " rdf:parseType=\"Resource\"/>";
+            out_ += newline_;
+            emitEndTag = false;
+        } else {
+            out_ += " rdf:parseType=\"Resource\">";
+            out_ += newline_;
+            for (auto&& child : node.children_) {
+                serializePrettyProperty(nodes_[child], level + 1);
+            }
+        }
+        if (emitEndTag) {
+            if (indentEndTag) indent(level);
+            out_ += "</";
+            out_ += elemName;
+            out_ += '>';
+            out_ += newline_;
+        }
+    }
+
+    void XmpPacketEncoder::serializePrettySchema(const Schema& schema)
+    {
+        indent(2);
+        out_ += "<rdf:Description rdf:about=\"\"";
+        std::string usedNs = "xml:rdf:";
+        declareOneNamespace(schema.prefix_, schema.ns_, usedNs);
+        for (auto&& property : schema.properties_) {
+            declareUsedNamespaces(nodes_[property], usedNs);
+        }
+        out_ += ">";
+        out_ += newline_;
+        for (auto&& property : schema.properties_) {
+            serializePrettyProperty(nodes_[property], 3);
+        }
+        indent(2);
+        out_ += "</rdf:Description>";
+        out_ += newline_;
+    }
+
+    //! Return true if a node can be written as an attribute
+    bool canBeAttrProp(const std::string& name, XMP_OptionBits options)
+    {
+        return name[0] != '[' && !(options & (kXMP_PropHasQualifiers | kXMP_PropCompositeMask));
+    }
+
+    bool XmpPacketEncoder::serializeCompactAttrProps(const std::vector<size_t>& children, int level)
+    {
+        bool allAreAttrs = true;
+        for (auto&& child : children) {
+            const Node& node = nodes_[child];
+            if (!canBeAttrProp(node.name_, node.options_)) {
+                allAreAttrs = false;
+                continue;
+            }
+            out_ += newline_;
+            indent(level);
+            out_ += node.name_;
+            out_ += "=\"";
+            appendValue(node.value_, true);
+            out_ += '"';
+        }
+        return allAreAttrs;
+    }
+
+    void XmpPacketEncoder::serializeCompactElemProps(const std::vector<size_t>& children, int level)
+    {
+        for (auto&& child : children) {
+            const Node& node = nodes_[child];
+            if (canBeAttrProp(node.name_, node.options_)) continue;
+
+            const std::string& elemName = node.name_[0] == '[' ? std::string("rdf:li") : node.name_;
+            indent(level);
+            out_ += '<';
+            out_ += elemName;
+            if (node.options_ & kXMP_PropHasLang) {
+                out_ += " xml:lang=\"";
+                appendValue(node.lang_, true);
+                out_ += '"';
+            }
+            bool emitEndTag = true;
+            bool indentEndTag = true;
+            if (!(node.options_ & kXMP_PropCompositeMask)) {
+                if (node.value_.empty()) {
+                    out_ += "/>";
+                    out_ += newline_;
+                    emitEndTag = false;
+                } else {
+                    out_ += '>';
+                    appendValue(node.value_, false);
+                    indentEndTag = false;
+                }
+            } else if (node.options_ & kXMP_PropValueIsArray) {
+                out_ += '>';
+                out_ += newline_;
+                emitArrayTag(node, level + 1, true);
+                serializeCompactElemProps(node.children_, level + 2);
+                emitArrayTag(node, level + 1, false);
+            } else {
+                bool hasAttrFields = false;
+                bool hasElemFields = false;
+                for (auto&& field : node.children_) {
+                    if (canBeAttrProp(nodes_[field].name_, nodes_[field].options_)) {
+                        hasAttrFields = true;
+                    } else {
+                        hasElemFields = true;
+                    }
+                }
+                if (node.children_.empty()) {
+                    out_ += " rdf:parseType=\"Resource\"/>";
+                    out_ += newline_;
+                    emitEndTag = false;
+                } else if (!hasElemFields) {
+                    serializeCompactAttrProps(node.children_, level + 1);
+                    out_ += "/>";
+                    out_ += newline_;
+                    emitEndTag = false;
+                } else if (!hasAttrFields) {
+                    out_ += " rdf:parseType=\"Resource\">";
+                    out_ += newline_;
+                    serializeCompactElemProps(node.children_, level + 1);
+                } else {
+                    // A mix of attributes and elements, use an inner rdf:Description
+                    out_ += '>';
+                    out_ += newline_;
+                    indent(level + 1);
+                    out_ += "<rdf:Description";
+                    serializeCompactAttrProps(node.children_, level + 2);
+                    out_ += ">";
+                    out_ += newline_;
+                    serializeCompactElemProps(node.children_, level + 1);
+                    indent(level + 1);
+                    out_ += "</rdf:Description>";
+                    out_ += newline_;
+                }
+            }
+            if (emitEndTag) {
+                if (indentEndTag) indent(level);
+                out_ += "</";
+                out_ += elemName;
+                out_ += '>';
+                out_ += newline_;
+            }
+        }
+    }
+
+    void XmpPacketEncoder::serializeCompactSchemas()
+    {
+        indent(2);
+        out_ += "<rdf:Description rdf:about=\"\"";
+        std::string usedNs = "xml:rdf:";
+        for (auto&& schema : schemas_) {
+            declareOneNamespace(schema.prefix_, schema.ns_, usedNs);
+            for (auto&& property : schema.properties_) {
+                declareUsedNamespaces(nodes_[property], usedNs);
+            }
+        }
+        bool allAreAttrs = true;
+        for (auto&& schema : schemas_) {
+            allAreAttrs &= serializeCompactAttrProps(schema.properties_, 3);
+        }
+        if (allAreAttrs) {
+            out_ += "/>";
+            out_ += newline_;
+            return;
+        }
+        out_ += ">";
+        out_ += newline_;
+        for (auto&& schema : schemas_) {
+            serializeCompactElemProps(schema.properties_, 3);
+        }
+        indent(2);
+        out_ += "</rdf:Description>";
+        out_ += newline_;
+    }
+
+    void XmpPacketEncoder::emitArrayTag(const Node& node, int level, bool isStartTag)
+    {
+        if (!isStartTag && node.children_.empty()) return;
+        indent(level);
+        out_ += isStartTag ? "<rdf:" : "</rdf:";
+        if (node.options_ & kXMP_PropArrayIsAlternate) {
+            out_ += "Alt";
+        } else if (node.options_ & kXMP_PropArrayIsOrdered) {
+            out_ += "Seq";
+        } else {
+            out_ += "Bag";
+        }
+        if (isStartTag && node.children_.empty()) out_ += '/';
+        out_ += '>';
+        out_ += newline_;
+    }
+
+    void XmpPacketEncoder::appendValue(const std::string& value, bool forAttribute)
+    {
+        for (auto&& c : value) {
+            switch (c) {
+            case '\t': out_ += "&#x9;"; break;
+            case '\n': out_ += "&#xA;"; break;
+            case '\r': out_ += "&#xD;"; break;
+            case '<':  out_ += "&lt;"; break;
+            case '>':  out_ += "&gt;"; break;
+            case '&':  out_ += "&amp;"; break;
+            case '"':
+                if (forAttribute) {
+                    out_ += "&quot;";
+                    break;
+                }
+                // fallthrough
+            default:
+                out_ += c;
+                break;
+            }
+        }
+    }
+
+    void XmpPacketEncoder::indent(int level)
+    {
+        for (; level > 0; --level) out_ += indent_;
+    }
 #endif // EXV_HAVE_XMP_TOOLKIT
 
 }  // namespace
@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+
+#include <exiv2/error.hpp>
+#include <exiv2/exif.hpp>
+#include <exiv2/value.hpp>
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace Exiv2;
+
+namespace
+{
+    void addValue(ExifData& exifData, const char* key, uint16_t value)
+    {
+        UShortValue v;
+        v.value_.push_back(value);
+        exifData.add(ExifKey(key), &v);
+    }
+}  // namespace
+
+TEST(ExifData, findsTheFirstOfSeveralMetadataWithTheSameKey)
+{
+    ExifData exifData;
+    addValue(exifData, "Exif.Image.Orientation", 1);
+    addValue(exifData, "Exif.Photo.ISOSpeedRatings", 100);
+    addValue(exifData, "Exif.Image.Orientation", 2);
+
+    auto pos = exifData.findKey(ExifKey("Exif.Image.Orientation"));
+    ASSERT_EQ(exifData.begin(), pos);
+
+    exifData.erase(pos);
+    pos = exifData.findKey(ExifKey("Exif.Image.Orientation"));
+    ASSERT_NE(exifData.end(), pos);
+    ASSERT_EQ(2, pos->toInt64());
+
+    exifData.erase(pos);
+    ASSERT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Orientation")));
+    ASSERT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Photo.ISOSpeedRatings")));
+}
+
+TEST(ExifData, findsMetadataWhoseKeyWasChangedThroughAnIterator)
+{
+    ExifData exifData;
+    addValue(exifData, "Exif.Image.Orientation", 1);
+    addValue(exifData, "Exif.Photo.ISOSpeedRatings", 100);
+    ASSERT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Orientation")));
+
+    *exifData.begin() = Exifdatum(ExifKey("Exif.Photo.Flash"));
+
+    const ExifData& constData = exifData;
+    ASSERT_EQ(constData.begin(), constData.findKey(ExifKey("Exif.Photo.Flash")));
+    ASSERT_EQ(exifData.begin(), exifData.findKey(ExifKey("Exif.Photo.Flash")));
+    ASSERT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Orientation")));
+}
+
+TEST(ExifData, tracksKeysChangedThroughAnIteratorInEachContainer)
+{
+    ExifData exifData;
+    addValue(exifData, "Exif.Image.Orientation", 1);
+    addValue(exifData, "Exif.Photo.ISOSpeedRatings", 100);
+
+    ExifData copy(exifData);
+    ASSERT_EQ(copy.begin(), copy.findKey(ExifKey("Exif.Image.Orientation")));
+    *copy.begin() = Exifdatum(ExifKey("Exif.Photo.Flash"));
+    ASSERT_EQ(copy.begin(), copy.findKey(ExifKey("Exif.Photo.Flash")));
+    ASSERT_EQ(copy.end(), copy.findKey(ExifKey("Exif.Image.Orientation")));
+    ASSERT_EQ(exifData.begin(), exifData.findKey(ExifKey("Exif.Image.Orientation")));
+
+    // The elements of a moved container still report to it
+    ExifData moved(std::move(exifData));
+    ASSERT_EQ(moved.begin(), moved.findKey(ExifKey("Exif.Image.Orientation")));
+    *std::next(moved.begin()) = Exifdatum(ExifKey("Exif.Photo.Flash"));
+    ASSERT_EQ(std::next(moved.begin()), moved.findKey(ExifKey("Exif.Photo.Flash")));
+    ASSERT_EQ(moved.end(), moved.findKey(ExifKey("Exif.Photo.ISOSpeedRatings")));
+
+    // A copy of an element doesn't belong to any container
+    Exifdatum datum = *moved.begin();
+    datum = Exifdatum(ExifKey("Exif.Image.Make"));
+    ASSERT_EQ(moved.begin(), moved.findKey(ExifKey("Exif.Image.Orientation")));
+
+    // A container which was moved from tracks its new elements
+    exifData.clear();
+    addValue(exifData, "Exif.Image.Orientation", 1);
+    ASSERT_EQ(exifData.begin(), exifData.findKey(ExifKey("Exif.Image.Orientation")));
+    *exifData.begin() = Exifdatum(ExifKey("Exif.Photo.Flash"));
+    ASSERT_EQ(exifData.begin(), exifData.findKey(ExifKey("Exif.Photo.Flash")));
+}
+
+TEST(ExifData, keepsTheIndexAcrossCopiesAndSorting)
+{
+    ExifData exifData;
+    exifData["Exif.Photo.ISOSpeedRatings"] = uint16_t(100);
+    exifData["Exif.Image.Orientation"] = uint16_t(1);
+    exifData["Exif.Image.Orientation"] = uint16_t(3);
+    ASSERT_EQ(2, exifData.count());
+
+    ExifData copy(exifData);
+    copy.sortByKey();
+    ASSERT_EQ(copy.begin(), copy.findKey(ExifKey("Exif.Image.Orientation")));
+    ASSERT_EQ(std::next(copy.begin()), copy.findKey(ExifKey("Exif.Photo.ISOSpeedRatings")));
+
+    ExifData moved(std::move(copy));
+    ASSERT_EQ(3, moved.findKey(ExifKey("Exif.Image.Orientation"))->toInt64());
+    ASSERT_EQ(exifData.begin(), exifData.findKey(ExifKey("Exif.Photo.ISOSpeedRatings")));
+
+    exifData.clear();
+    ASSERT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Orientation")));
+}
+
+TEST(ExifData, sortsByKeyAndByTagKeepingTheOrderOfDuplicates)
+{
+    ExifData exifData;
+    addValue(exifData, "Exif.Photo.ISOSpeedRatings", 100);
+    addValue(exifData, "Exif.Image.Orientation", 1);
+    addValue(exifData, "Exif.Photo.Flash", 0);
+    addValue(exifData, "Exif.Image.Orientation", 2);
+
+    exifData.sortByKey();
+    std::vector<std::string> keys;
+    for (auto&& md : exifData) {
+        keys.push_back(md.key() + "=" + md.toString());
+    }
+    const std::vector<std::string> byKey{"Exif.Image.Orientation=1", "Exif.Image.Orientation=2",
+                                         "Exif.Photo.Flash=0", "Exif.Photo.ISOSpeedRatings=100"};
+    ASSERT_EQ(byKey, keys);
+
+    exifData.sortByTag();
+    std::vector<uint16_t> tags;
+    for (auto&& md : exifData) {
+        tags.push_back(md.tag());
+    }
+    const std::vector<uint16_t> byTag{0x0112, 0x0112, 0x8827, 0x9209};
+    ASSERT_EQ(byTag, tags);
+    ASSERT_EQ(1, exifData.findKey(ExifKey("Exif.Image.Orientation"))->toInt64());
+}
+
+TEST(ExifData, findsMetadataByTagAndIfd)
+{
+    ExifData exifData;
+    addValue(exifData, "Exif.Image.Orientation", 1);
+    addValue(exifData, "Exif.Thumbnail.Orientation", 2);
+
+    const ExifKey key("Exif.Thumbnail.Orientation");
+    ASSERT_EQ(exifData.findKey(key), exifData.findKey(key.tag(), key.ifdId()));
+    ASSERT_EQ(2, exifData.findKey(key.tag(), key.ifdId())->toInt64());
+
+    const ExifData& constData = exifData;
+    ASSERT_EQ(constData.end(), constData.findKey(0x0001, key.ifdId()));
+    ASSERT_EQ(std::next(constData.begin()), constData.findKey(key.tag(), key.ifdId()));
+}
+
+TEST(ExifFilter, selectsGroupsAndTags)
+{
+    ExifFilter filter;
+    ASSERT_TRUE(filter.empty());
+    ASSERT_TRUE(filter.selects(0x0112, ExifKey("Exif.Image.Orientation").ifdId()));
+
+    filter.addGroup("Thumbnail").addKey("Exif.Image.Orientation");
+    ASSERT_FALSE(filter.empty());
+    const ExifKey orientation("Exif.Image.Orientation");
+    const ExifKey make("Exif.Image.Make");
+    const ExifKey compression("Exif.Thumbnail.Compression");
+    const ExifKey fNumber("Exif.Photo.FNumber");
+    ASSERT_TRUE(filter.selects(orientation.tag(), orientation.ifdId()));
+    ASSERT_FALSE(filter.selects(make.tag(), make.ifdId()));
+    ASSERT_TRUE(filter.selects(compression.tag(), compression.ifdId()));
+    ASSERT_TRUE(filter.selectsGroup(make.ifdId()));
+    ASSERT_TRUE(filter.selectsGroup(compression.ifdId()));
+    ASSERT_FALSE(filter.selectsGroup(fNumber.ifdId()));
+
+    ASSERT_THROW(filter.addGroup("NoSuchGroup"), Error);
+}
+
+TEST(ExifData, decodesADeferredMakernoteWhereTheRawMakernoteIs)
+{
+    ExifData exifData;
+    exifData["Exif.Photo.ExposureTime"] = "1/100";
+    exifData["Exif.Photo.MakerNote"] = "0 1 2 3";
+    exifData["Exif.Photo.UserComment"] = "comment";
+    int calls = 0;
+    exifData.setMakernoteDecoder([&calls](ExifData& makernote) {
+        ++calls;
+        makernote["Exif.Nikon3.Version"] = "0210";
+        makernote["Exif.Nikon3.ISOSpeed"] = uint16_t(200);
+    });
+    ASSERT_TRUE(exifData.makernotePending());
+    ASSERT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Photo.UserComment")));
+    ASSERT_EQ(0, calls);
+
+    ASSERT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Nikon3.ISOSpeed")));
+    ASSERT_EQ(1, calls);
+    ASSERT_FALSE(exifData.makernotePending());
+    ASSERT_EQ(5, exifData.count());
+    const char* keys[] = {"Exif.Photo.ExposureTime", "Exif.Photo.MakerNote", "Exif.Nikon3.Version",
+                          "Exif.Nikon3.ISOSpeed", "Exif.Photo.UserComment"};
+    auto md = exifData.begin();
+    for (auto&& key : keys) {
+        ASSERT_EQ(key, md->key());
+        ++md;
+    }
+    ASSERT_EQ(1, calls);
+}
+
+TEST(ExifData, decodesADeferredMakernoteWhenItIsIterated)
+{
+    ExifData exifData;
+    exifData.setMakernoteDecoder([](ExifData& makernote) { makernote["Exif.Canon.ModelID"] = uint32_t(1); });
+    const ExifData copy = exifData;
+    ASSERT_TRUE(copy.makernotePending());
+    ASSERT_NE(copy.begin(), copy.end());
+    ASSERT_FALSE(copy.makernotePending());
+    ASSERT_TRUE(exifData.makernotePending());
+
+    exifData.clear();
+    ASSERT_FALSE(exifData.makernotePending());
+    ASSERT_TRUE(exifData.empty());
+}
+
+TEST(ExifData, keepsTheMetadataDecodedBeforeADeferredMakernoteFails)
+{
+    ExifData exifData;
+    exifData["Exif.Photo.MakerNote"] = "0 1 2 3";
+    exifData.setMakernoteDecoder([](ExifData& makernote) {
+        makernote["Exif.Canon.ModelID"] = uint32_t(1);
+        throw Error(kerCorruptedMetadata);
+    });
+    ASSERT_NO_THROW(ASSERT_EQ(2, exifData.count()));
+    ASSERT_FALSE(exifData.makernotePending());
+    ASSERT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Canon.ModelID")));
+}
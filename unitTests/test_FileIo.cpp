@@ -20,7 +20,14 @@
 
 #include "basicio.hpp"
 #include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <thread>
+#include <vector>
+
 using namespace Exiv2;
+namespace fs = std::filesystem;
 
 namespace
 {
@@ -108,3 +115,296 @@ TEST(AFileIO, canSeekBeyondEOF)
     ASSERT_FALSE(file.error());
     ASSERT_FALSE(file.eof());
 }
+
+TEST(AFileIO, readsTheSameBytesWithAndWithoutReadAheadBuffer)
+{
+    const size_t oldSize = setReadBufferSize(0);
+    FileIo unbuffered(imagePath);
+    unbuffered.open();
+    setReadBufferSize(7);
+    FileIo buffered(imagePath);
+    buffered.open();
+    setReadBufferSize(oldSize);
+
+    byte expected[20];
+    byte actual[20];
+    ASSERT_EQ(20, unbuffered.read(expected, 20));
+    actual[0] = static_cast<byte>(buffered.getb());
+    ASSERT_EQ(5, buffered.read(actual + 1, 5));
+    ASSERT_EQ(6, buffered.tell());
+    ASSERT_EQ(14, buffered.read(actual + 6, 14));
+    ASSERT_EQ(0, std::memcmp(expected, actual, 20));
+
+    ASSERT_EQ(0, buffered.seek(-10, BasicIo::cur));
+    ASSERT_EQ(10, buffered.tell());
+    ASSERT_EQ(expected[10], buffered.getb());
+}
+
+TEST(AFileIO, setsEofOnlyWhenAReadCannotBeSatisfied)
+{
+    const size_t oldSize = setReadBufferSize(7);
+    FileIo file(imagePath);
+    file.open();
+    setReadBufferSize(oldSize);
+
+    ASSERT_EQ(0, file.seek(-3, BasicIo::end));
+    byte buf[4];
+    ASSERT_EQ(2, file.read(buf, 2));
+    ASSERT_FALSE(file.eof());
+    ASSERT_NE(EOF, file.getb());
+    ASSERT_FALSE(file.eof());
+    ASSERT_EQ(EOF, file.getb());
+    ASSERT_TRUE(file.eof());
+
+    ASSERT_EQ(0, file.seek(0, BasicIo::beg));
+    ASSERT_FALSE(file.eof());
+}
+
+TEST(AFileIO, seeksToTheNextByteWithAValue)
+{
+    const size_t oldSize = setReadBufferSize(7);
+    FileIo file(imagePath);
+    file.open();
+    setReadBufferSize(oldSize);
+
+    // DSC_3079.jpg starts with the SOI marker followed by APP0
+    ASSERT_EQ(0, file.seekToByte(0xff));
+    ASSERT_EQ(0, file.tell());
+    ASSERT_EQ(0xff, file.getb());
+    ASSERT_EQ(0, file.seekToByte(0xe0));
+    ASSERT_EQ(3, file.tell());
+    ASSERT_EQ(0xe0, file.getb());
+
+    // Nul bytes are common, but not after the last one of the file
+    ASSERT_EQ(0, file.seek(-1, BasicIo::end));
+    ASSERT_NE(0, file.seekToByte(0x00));
+    ASSERT_TRUE(file.eof());
+    ASSERT_EQ(static_cast<long>(file.size()), file.tell());
+}
+
+TEST(AFileIO, readsAtAnOffsetWithoutMovingThePosition)
+{
+    FileIo file(imagePath);
+    file.open();
+    byte expected[16];
+    ASSERT_EQ(0, file.seek(1000, BasicIo::beg));
+    ASSERT_EQ(16, file.read(expected, 16));
+    ASSERT_EQ(0, file.seek(10, BasicIo::beg));
+    ASSERT_NE(EOF, file.getb());
+
+    byte actual[16];
+    ASSERT_EQ(16, file.readAt(1000, actual, 16));
+    ASSERT_EQ(0, std::memcmp(expected, actual, 16));
+    ASSERT_EQ(11, file.tell());
+
+    // Short read at the end of the file
+    ASSERT_EQ(6, file.readAt(static_cast<int64_t>(file.size()) - 6, actual, 16));
+    ASSERT_FALSE(file.eof());
+}
+
+TEST(AFileIO, canBeReadAtOffsetsFromSeveralThreads)
+{
+    FileIo file(imagePath);
+    file.open();
+    const DataBuf expected = file.read(static_cast<long>(file.size()));
+
+    std::vector<std::thread> threads;
+    std::vector<int> results(4, -1);
+    for (size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&, t] {
+            const long chunk = expected.size() / static_cast<long>(results.size());
+            DataBuf buf(chunk);
+            for (int i = 0; i < 50; ++i) {
+                if (file.readAt(t * chunk, buf.data(), chunk) != chunk) return;
+            }
+            results[t] = expected.cmpBytes(t * chunk, buf.c_data(), chunk);
+        });
+    }
+    for (auto&& thread : threads) thread.join();
+    for (auto&& result : results) ASSERT_EQ(0, result);
+}
+
+TEST(AMmapIO, readsTheSameBytesAsFileIo)
+{
+    FileIo file(imagePath);
+    MmapIo mapped(imagePath);
+    ASSERT_EQ(0, file.open());
+    ASSERT_EQ(0, mapped.open());
+    ASSERT_EQ(file.size(), mapped.size());
+
+    DataBuf expected = file.read(static_cast<long>(file.size()));
+    DataBuf actual = mapped.read(static_cast<long>(mapped.size()));
+    ASSERT_EQ(expected.size(), actual.size());
+    ASSERT_EQ(0, actual.cmpBytes(0, expected.c_data(), expected.size()));
+    ASSERT_EQ(EOF, mapped.getb());
+    ASSERT_TRUE(mapped.eof());
+}
+
+TEST(AMmapIO, lendsDataFromTheMapping)
+{
+    MmapIo file(imagePath);
+    ASSERT_EQ(0, file.open());
+
+    const byte* base = file.mmap();
+    ASSERT_EQ(0, file.seek(100, BasicIo::beg));
+    ASSERT_EQ(base + 100, file.readView(50));
+    ASSERT_EQ(150, file.tell());
+    ASSERT_EQ(nullptr, file.readView(static_cast<long>(file.size())));
+    ASSERT_EQ(150, file.tell());
+}
+
+TEST(AMmapIO, canSeekBeyondEOF)
+{
+    MmapIo file(imagePath);
+    file.open();
+
+    ASSERT_EQ(0, file.seek(200000, BasicIo::beg));
+    ASSERT_FALSE(file.error());
+    ASSERT_FALSE(file.eof());
+    ASSERT_EQ(EOF, file.getb());
+    ASSERT_TRUE(file.eof());
+}
+
+TEST(AMmapIO, doesNotWriteToTheMappedFile)
+{
+    MmapIo file(imagePath);
+    file.open();
+
+    const byte data[] = {0x00};
+    ASSERT_EQ(0, file.write(data, 1));
+    ASSERT_EQ(EOF, file.putb(0x00));
+}
+
+TEST(AFileIO, returnsAMemIoAsTemporaryForSmallFiles)
+{
+    FileIo file(imagePath);
+    auto tmp = file.temporary();
+    ASSERT_NE(nullptr, dynamic_cast<MemIo*>(tmp.get()));
+}
+
+TEST(AFileIO, transfersATemporaryFileForLargeFiles)
+{
+    const fs::path path = fs::temp_directory_path() / "exiv2-test-temporary.jpg";
+    fs::copy_file(imagePath, path, fs::copy_options::overwrite_existing);
+    const size_t oldSize = setWriteBufferSize(0);
+
+    FileIo file(path.string());
+    std::string tmpPath;
+    {
+        auto tmp = file.temporary();
+        ASSERT_NE(nullptr, dynamic_cast<FileIo*>(tmp.get()));
+        ASSERT_TRUE(tmp->isopen());
+        tmpPath = tmp->path();
+        ASSERT_TRUE(fs::exists(tmpPath));
+
+        const byte data[] = {0x01, 0x02, 0x03};
+        ASSERT_EQ(3, tmp->write(data, 3));
+        file.transfer(*tmp);
+    }
+    setWriteBufferSize(oldSize);
+
+    ASSERT_FALSE(fs::exists(tmpPath));
+    ASSERT_EQ(3u, fs::file_size(path));
+    fs::remove(path);
+}
+
+TEST(AFileIO, transfersATemporaryFileToTheTargetOfASymbolicLink)
+{
+    const fs::path path = fs::temp_directory_path() / "exiv2-test-temporary-target.jpg";
+    const fs::path link = fs::temp_directory_path() / "exiv2-test-temporary-link.jpg";
+    fs::copy_file(imagePath, path, fs::copy_options::overwrite_existing);
+    fs::remove(link);
+    fs::create_symlink(path, link);
+    const size_t oldSize = setWriteBufferSize(0);
+
+    FileIo file(link.string());
+    {
+        auto tmp = file.temporary();
+        ASSERT_NE(nullptr, dynamic_cast<FileIo*>(tmp.get()));
+        ASSERT_EQ(0u, tmp->path().find(fs::canonical(path).string()));
+
+        const byte data[] = {0x01, 0x02, 0x03};
+        ASSERT_EQ(3, tmp->write(data, 3));
+        file.transfer(*tmp);
+    }
+    setWriteBufferSize(oldSize);
+
+    ASSERT_TRUE(fs::is_symlink(link));
+    ASSERT_EQ(3u, fs::file_size(path));
+    fs::remove(link);
+    fs::remove(path);
+}
+
+TEST(AFileIO, removesAnUntransferredTemporaryFile)
+{
+    const size_t oldSize = setWriteBufferSize(0);
+    FileIo file(imagePath);
+    std::string tmpPath;
+    {
+        auto tmp = file.temporary();
+        tmpPath = tmp->path();
+        ASSERT_TRUE(fs::exists(tmpPath));
+    }
+    setWriteBufferSize(oldSize);
+    ASSERT_FALSE(fs::exists(tmpPath));
+}
+
+TEST(AFileIO, transfersAMemIoOfSeveralChunks)
+{
+    const fs::path path = fs::temp_directory_path() / "exiv2-test-transfer-memio.jpg";
+    std::vector<byte> data(9 * 1024 * 1024 + 5);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<byte>(i % 253);
+    MemIo src;
+    ASSERT_EQ(static_cast<long>(data.size()), src.write(data.data(), static_cast<long>(data.size())));
+
+    FileIo file(path.string());
+    file.transfer(src);
+
+    ASSERT_EQ(data.size(), fs::file_size(path));
+    ASSERT_EQ(0, file.open());
+    std::vector<byte> out(data.size());
+    ASSERT_EQ(static_cast<long>(out.size()), file.read(out.data(), static_cast<long>(out.size())));
+    ASSERT_EQ(data, out);
+    file.close();
+    fs::remove(path);
+}
+
+TEST(AFileIO, copyFromAnotherFileCopiesTheRange)
+{
+    const fs::path path = fs::temp_directory_path() / "exiv2-test-copyfrom.jpg";
+    FileIo src(imagePath);
+    ASSERT_EQ(0, src.open());
+    FileIo dst(path.string());
+    ASSERT_EQ(0, dst.open("w+b"));
+
+    const byte data[] = {0x01, 0x02};
+    ASSERT_EQ(2, dst.write(data, 2));
+    dst.copyFrom(src, 100, 5000);
+    ASSERT_EQ(5100, src.tell());
+    ASSERT_EQ(5002, dst.tell());
+    ASSERT_EQ(5002u, dst.size());
+
+    DataBuf expected(5000);
+    ASSERT_EQ(0, src.seek(100, BasicIo::beg));
+    ASSERT_EQ(5000, src.read(expected.data(), 5000));
+    DataBuf copied(5000);
+    ASSERT_EQ(0, dst.seek(2, BasicIo::beg));
+    ASSERT_EQ(5000, dst.read(copied.data(), 5000));
+    ASSERT_EQ(0, expected.cmpBytes(0, copied.c_data(), 5000));
+
+    dst.close();
+    fs::remove(path);
+}
+
+TEST(AFileIO, copyFromThrowsIfNotEnoughBytesAreAvailable)
+{
+    const fs::path path = fs::temp_directory_path() / "exiv2-test-copyfrom-short.jpg";
+    FileIo src(imagePath);
+    ASSERT_EQ(0, src.open());
+    FileIo dst(path.string());
+    ASSERT_EQ(0, dst.open("w+b"));
+    ASSERT_THROW(dst.copyFrom(src, static_cast<int64_t>(src.size()) - 10, 20), Error);
+
+    dst.close();
+    fs::remove(path);
+}
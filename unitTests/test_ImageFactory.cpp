@@ -140,6 +140,19 @@ TEST(TheImageFactory, loadInstancesDifferentImageTypes)
     EXPECT_NO_THROW(ImageFactory::open(imagePath, false));
 }
 
+TEST(TheImageFactory, determinesTheTypeFromTheFileHeaderInMemory)
+{
+    fs::path testData(TESTDATA_PATH);
+    for (auto&& name : {"DSC_3079.jpg", "exiv2-bug1108.exv", "exiv2-canon-powershot-s40.crw", "exiv2-bug1044.tif",
+                        "exiv2-photoshop.psd", "imagemagick.pgf", "Reagan.jp2", "BlueSquare.xmp"}) {
+        const std::string imagePath = (testData / name).string();
+        FileIo fileIo(imagePath);
+        ASSERT_EQ(0, fileIo.open());
+        const DataBuf header = fileIo.read(1024);
+        EXPECT_EQ(ImageFactory::getType(imagePath), ImageFactory::getType(header.c_data(), header.size()));
+    }
+}
+
 TEST(TheImageFactory, getsExpectedModesForJp2Images)
 {
     EXPECT_EQ(amNone, ImageFactory::checkMode(ImageType::jp2, mdNone));
@@ -393,3 +406,235 @@ TEST(TheImageFactory, getsExpectedModesForNoneValue)
 }
 
 /// \todo check why JpegBase is taking ImageType in the constructor
+
+TEST(TheImageFactory, readsTheSameMetadataThroughMmapIo)
+{
+    const std::string testData(TESTDATA_PATH);
+    for (auto&& name : {"/DSC_3079.jpg", "/exiv2-bug922.png", "/exiv2-bug922.tif"}) {
+        const std::string path(testData + name);
+        auto fileImage = ImageFactory::open(path);
+        auto mmapImage = ImageFactory::open(std::make_unique<MmapIo>(path));
+        ASSERT_TRUE(mmapImage);
+        fileImage->readMetadata();
+        mmapImage->readMetadata();
+
+        ASSERT_EQ(fileImage->exifData().count(), mmapImage->exifData().count());
+        ASSERT_EQ(fileImage->iptcData().count(), mmapImage->iptcData().count());
+        ASSERT_EQ(fileImage->xmpPacket(), mmapImage->xmpPacket());
+        ASSERT_EQ(fileImage->comment(), mmapImage->comment());
+        ASSERT_EQ(fileImage->pixelWidth(), mmapImage->pixelWidth());
+        ASSERT_EQ(fileImage->pixelHeight(), mmapImage->pixelHeight());
+    }
+}
+
+TEST(TheImageFactory, updatesMetadataInPlaceWhenItFits)
+{
+    const fs::path source = fs::path(TESTDATA_PATH) / "DSC_3079.jpg";
+    const fs::path path = fs::temp_directory_path() / "exiv2-test-inplace.jpg";
+    fs::copy_file(source, path, fs::copy_options::overwrite_existing);
+    const auto size = fs::file_size(path);
+
+    {
+        auto image = ImageFactory::open(path.string());
+        image->readMetadata();
+        auto pos = image->xmpData().findKey(XmpKey("Xmp.dc.subject"));
+        ASSERT_NE(image->xmpData().end(), pos);
+        image->xmpData().erase(pos);
+        image->writeMetadata();
+        ASSERT_EQ(wmNonIntrusive, image->writeMethod());
+    }
+    ASSERT_EQ(size, fs::file_size(path));
+
+    {
+        auto image = ImageFactory::open(path.string());
+        image->readMetadata();
+        ASSERT_EQ(image->xmpData().end(), image->xmpData().findKey(XmpKey("Xmp.dc.subject")));
+        // No comment segment to update
+        image->setComment("A comment which needs a new segment");
+        image->writeMetadata();
+        ASSERT_EQ(wmIntrusive, image->writeMethod());
+    }
+
+    auto image = ImageFactory::open(path.string());
+    image->readMetadata();
+    ASSERT_EQ("A comment which needs a new segment", image->comment());
+    fs::remove(path);
+}
+
+TEST(TheImageFactory, appendsTiffMetadataWhichDoesNotFitInPlace)
+{
+    const fs::path source = fs::path(TESTDATA_PATH) / "test.tiff";
+    const fs::path path = fs::temp_directory_path() / "exiv2-test-append.tiff";
+    fs::copy_file(source, path, fs::copy_options::overwrite_existing);
+    const auto size = fs::file_size(path);
+    const std::string description(1000, 'x');
+    std::string stripOffsets;
+
+    {
+        auto image = ImageFactory::open(path.string());
+        image->readMetadata();
+        stripOffsets = image->exifData()["Exif.Image.StripOffsets"].toString();
+        image->exifData()["Exif.Image.ImageDescription"] = description;
+        image->setAppendMetadata(true);
+        image->writeMetadata();
+        ASSERT_EQ(wmAppend, image->writeMethod());
+    }
+    // Only the metadata is written, the image data stays where it is
+    ASSERT_GT(fs::file_size(path), size);
+    ASSERT_LT(fs::file_size(path), size + 0x4000);
+
+    auto image = ImageFactory::open(path.string());
+    image->readMetadata();
+    ASSERT_EQ(description, image->exifData()["Exif.Image.ImageDescription"].toString());
+    ASSERT_EQ(stripOffsets, image->exifData()["Exif.Image.StripOffsets"].toString());
+    fs::remove(path);
+}
+
+TEST(AnImage, readsOnlyTheExifMetadataSelectedByItsFilter)
+{
+    const fs::path source = fs::path(TESTDATA_PATH) / "exiv2-nikon-d70.jpg";
+    auto image = ImageFactory::open(source.string());
+    image->readMetadata();
+    const ExifData all = image->exifData();
+    ASSERT_NE(all.end(), all.findKey(ExifKey("Exif.Nikon3.ISOSettings")));
+
+    ExifFilter filter;
+    filter.addGroup("Thumbnail").addKey("Exif.Image.Orientation").addKey("Exif.NikonLd2.LensIDNumber");
+    image->setExifFilter(filter);
+    image->readMetadata();
+    const ExifData& exifData = image->exifData();
+    for (auto&& md : exifData) {
+        ASSERT_TRUE(filter.selects(md.tag(), md.ifdId())) << md.key();
+        auto pos = all.findKey(ExifKey(md.key()));
+        ASSERT_NE(all.end(), pos) << md.key();
+        ASSERT_EQ(pos->toString(), md.toString());
+    }
+    ASSERT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Orientation")));
+    ASSERT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Thumbnail.JPEGInterchangeFormat")));
+    ASSERT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.NikonLd2.LensIDNumber")));
+    ASSERT_EQ(exifData.end(), exifData.findKey(ExifKey("Exif.Nikon3.ISOSettings")));
+}
+
+TEST(AnImage, refusesToWriteExifMetadataReadWithAFilter)
+{
+    const fs::path source = fs::path(TESTDATA_PATH) / "exiv2-nikon-d70.jpg";
+    const fs::path path = fs::temp_directory_path() / "exiv2-test-filtered.jpg";
+    fs::copy_file(source, path, fs::copy_options::overwrite_existing);
+    const auto size = fs::file_size(path);
+
+    auto image = ImageFactory::open(path.string());
+    ExifFilter filter;
+    filter.addGroup("Thumbnail");
+    image->setExifFilter(filter);
+    image->readMetadata();
+    try {
+        image->writeMetadata();
+        FAIL() << "writeMetadata() didn't throw after a filtered read";
+    } catch (const Error& e) {
+        ASSERT_EQ(kerImageWriteFailed, e.code());
+    }
+    ASSERT_EQ(size, fs::file_size(path));
+
+    // The Exif data which replaces the filtered one can be written
+    image->setExifData(ExifData(image->exifData()));
+    ASSERT_NO_THROW(image->writeMetadata());
+    fs::remove(path);
+}
+
+TEST(AnImage, decodesADeferredMakernoteLikeAnImmediateOne)
+{
+    const fs::path source = fs::path(TESTDATA_PATH) / "exiv2-nikon-d70.jpg";
+    auto image = ImageFactory::open(source.string());
+    image->readMetadata();
+    const ExifData all = image->exifData();
+    ASSERT_FALSE(all.makernotePending());
+
+    ExifFilter filter;
+    filter.deferMakernote();
+    image->setExifFilter(filter);
+    image->readMetadata();
+    ExifData& exifData = image->exifData();
+    ASSERT_TRUE(exifData.makernotePending());
+    ASSERT_NE(exifData.end(), exifData.findKey(ExifKey("Exif.Image.Make")));
+    ASSERT_TRUE(exifData.makernotePending());
+
+    auto iso = exifData.findKey(ExifKey("Exif.Nikon3.ISOSettings"));
+    ASSERT_FALSE(exifData.makernotePending());
+    ASSERT_NE(exifData.end(), iso);
+    ASSERT_EQ(all.findKey(ExifKey("Exif.Nikon3.ISOSettings"))->toString(), iso->toString());
+    ASSERT_EQ(all.count(), exifData.count());
+    auto md = exifData.begin();
+    for (auto&& expected : all) {
+        ASSERT_EQ(expected.key(), md->key());
+        ASSERT_EQ(expected.toString(), md->toString());
+        ++md;
+    }
+}
+
+TEST(AnImage, writesADeferredMakernoteLikeAnImmediateOne)
+{
+    for (auto&& name : {"exiv2-nikon-d70.jpg", "exiv2-canon-eos-20d.jpg"}) {
+        const fs::path source = fs::path(TESTDATA_PATH) / name;
+        const fs::path paths[] = {fs::temp_directory_path() / "exiv2-test-immediate.jpg",
+                                  fs::temp_directory_path() / "exiv2-test-deferred.jpg"};
+        for (int defer = 0; defer < 2; ++defer) {
+            fs::copy_file(source, paths[defer], fs::copy_options::overwrite_existing);
+            auto image = ImageFactory::open(paths[defer].string());
+            ExifFilter filter;
+            filter.deferMakernote(defer == 1);
+            image->setExifFilter(filter);
+            image->readMetadata();
+            ASSERT_EQ(defer == 1, image->exifData().makernotePending()) << name;
+            // Too large to fit in place, so that the makernote is written anew
+            image->exifData()["Exif.Image.Artist"] = std::string(0x2000, 'a');
+            image->writeMetadata();
+            ASSERT_EQ(wmIntrusive, image->writeMethod()) << name;
+        }
+        const DataBuf immediate = readFile(paths[0].string());
+        const DataBuf deferred = readFile(paths[1].string());
+        ASSERT_EQ(immediate.size(), deferred.size()) << name;
+        ASSERT_EQ(0, immediate.cmpBytes(0, deferred.c_data(), deferred.size())) << name;
+        fs::remove(paths[0]);
+        fs::remove(paths[1]);
+    }
+}
+
+TEST(AnImage, decodesAMakernoteAfterTheImageDataRightAway)
+{
+    const fs::path source = fs::path(TESTDATA_PATH) / "exiv2-bug1044.tif";
+    const fs::path path = fs::temp_directory_path() / "exiv2-test-makernote-at-end.tif";
+    fs::copy_file(source, path, fs::copy_options::overwrite_existing);
+    {
+        // Append a Nikon makernote, which puts the IFDs after the image data
+        auto nikon = ImageFactory::open((fs::path(TESTDATA_PATH) / "exiv2-nikon-d70.jpg").string());
+        nikon->readMetadata();
+        auto image = ImageFactory::open(path.string());
+        image->readMetadata();
+        for (auto&& md : nikon->exifData()) {
+            if (md.groupName() != "Thumbnail") image->exifData().add(md);
+        }
+        image->setAppendMetadata(true);
+        image->writeMetadata();
+        ASSERT_EQ(wmAppend, image->writeMethod());
+    }
+
+    auto image = ImageFactory::open(path.string());
+    image->readMetadata();
+    const ExifData all = image->exifData();
+    ASSERT_NE(all.end(), all.findKey(ExifKey("Exif.Nikon3.ISOSettings")));
+
+    ExifFilter filter;
+    filter.deferMakernote();
+    image->setExifFilter(filter);
+    image->readMetadata();
+    const ExifData& exifData = image->exifData();
+    ASSERT_FALSE(exifData.makernotePending());
+    ASSERT_EQ(all.count(), exifData.count());
+    auto md = exifData.begin();
+    for (auto&& expected : all) {
+        ASSERT_EQ(expected.key(), md->key());
+        ASSERT_EQ(expected.toString(), md->toString());
+        ++md;
+    }
+    fs::remove(path);
+}
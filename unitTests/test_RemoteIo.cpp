@@ -0,0 +1,228 @@
+// ***************************************************************** -*- C++ -*-
+/*
+ * Copyright (C) 2004-2021 Exiv2 authors
+ * This program is part of the Exiv2 distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, 5th Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <exiv2/basicio.hpp>
+#include "remoteio_int.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Exiv2;
+
+namespace {
+    constexpr size_t blockSize = 1024;
+
+    //! RemoteIo which serves a file from memory and records the requests for it
+    class FakeRemoteIo : public RemoteIo {
+    public:
+        //! Options of the fake server
+        struct Server {
+            bool ignoresRanges = false;  //!< Return the whole file for each request
+            bool knowsLength = true;     //!< Return the length of the file
+            bool concurrent = false;     //!< Let RemoteIo send read-ahead requests concurrently
+            int delayMs = 0;             //!< Time to answer a request
+        };
+
+        FakeRemoteIo(std::string data, Server server)
+        {
+            p_ = new FakeImpl(std::move(data), server);
+        }
+
+        //! Return the number of requests for data
+        size_t requests() const
+        {
+            std::lock_guard<std::mutex> lock(impl().mutex_);
+            return impl().requests_;
+        }
+        //! Return the number of requests which have not been answered yet
+        int inFlight() const { return impl().inFlight_; }
+        //! Return the largest number of requests which were sent at the same time
+        int maxInFlight() const { return impl().maxInFlight_; }
+        //! Return the bytes of the blocks in memory
+        size_t cached() const { return impl().cached_; }
+
+    private:
+        class FakeImpl : public Impl {
+        public:
+            FakeImpl(std::string data, Server server)
+                : Impl("http://example.com/image.jpg", blockSize), data_(std::move(data)), server_(server)
+            {
+            }
+
+            long getFileLength() override
+            {
+                return server_.knowsLength ? static_cast<long>(data_.size()) : -1;
+            }
+
+            void getDataByRange(long lowBlock, long highBlock, std::string& response) override
+            {
+                const int inFlight = ++inFlight_;
+                int max = maxInFlight_;
+                while (inFlight > max && !maxInFlight_.compare_exchange_weak(max, inFlight)) {
+                }
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    ++requests_;
+                }
+                if (server_.delayMs > 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(server_.delayMs));
+                }
+                if (server_.ignoresRanges || lowBlock < 0) {
+                    response = data_;
+                } else {
+                    const size_t start = static_cast<size_t>(lowBlock) * blockSize;
+                    response = data_.substr(start, static_cast<size_t>(highBlock - lowBlock + 1) * blockSize);
+                }
+                --inFlight_;
+            }
+
+            void writeRemote(const byte* /*data*/, size_t /*size*/, long /*from*/, long /*to*/) override {}
+
+            bool canFetchConcurrently() const override { return server_.concurrent; }
+
+            std::string data_;
+            Server server_;
+            mutable std::mutex mutex_;
+            size_t requests_ = 0;
+            std::atomic<int> inFlight_{0};
+            std::atomic<int> maxInFlight_{0};
+        };
+
+        const FakeImpl& impl() const { return *static_cast<const FakeImpl*>(p_); }
+    };
+
+    //! Return a file of \em blocks blocks, each byte a function of its position
+    std::string makeFile(size_t blocks)
+    {
+        std::string data(blocks * blockSize, '\0');
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<char>((i / blockSize + i) % 251);
+        }
+        return data;
+    }
+
+    //! Read the byte at \em offset of \em io
+    int byteAt(BasicIo& io, size_t offset)
+    {
+        io.seek(static_cast<int64_t>(offset), BasicIo::beg);
+        byte b = 0;
+        if (io.read(&b, 1) != 1) return -1;
+        return b;
+    }
+
+    //! Set the cache size of RemoteIo for the lifetime of an instance
+    class CacheSize {
+    public:
+        explicit CacheSize(size_t size) : old_(setRemoteCacheSize(size)) {}
+        ~CacheSize() { setRemoteCacheSize(old_); }
+
+    private:
+        size_t old_;
+    };
+}  // namespace
+
+TEST(ARemoteIO, evictsTheLeastRecentlyUsedBlocksAndFetchesThemAgain)
+{
+    const CacheSize cacheSize(4 * blockSize);
+    const std::string data = makeFile(32);
+    FakeRemoteIo io(data, FakeRemoteIo::Server());
+    ASSERT_EQ(0, io.open());
+
+    // Blocks which are not next to each other aren't read ahead
+    for (size_t block : {1, 3, 5, 7, 9}) {
+        ASSERT_EQ(static_cast<byte>(data[block * blockSize]), byteAt(io, block * blockSize));
+    }
+    ASSERT_EQ(5u, io.requests());
+    ASSERT_LE(io.cached(), 4 * blockSize);
+
+    // The most recently used block is still cached, the first one is fetched again
+    ASSERT_EQ(static_cast<byte>(data[9 * blockSize + 1]), byteAt(io, 9 * blockSize + 1));
+    ASSERT_EQ(5u, io.requests());
+    ASSERT_EQ(static_cast<byte>(data[blockSize + 1]), byteAt(io, blockSize + 1));
+    ASSERT_EQ(6u, io.requests());
+    ASSERT_LE(io.cached(), 4 * blockSize);
+}
+
+TEST(ARemoteIO, boundsTheCacheForAServerWhichIgnoresRanges)
+{
+    const CacheSize cacheSize(4 * blockSize);
+    const std::string data = makeFile(32);
+    FakeRemoteIo::Server server;
+    server.ignoresRanges = true;
+    FakeRemoteIo io(data, server);
+    ASSERT_EQ(0, io.open());
+
+    ASSERT_EQ(static_cast<byte>(data[5 * blockSize]), byteAt(io, 5 * blockSize));
+    ASSERT_EQ(1u, io.requests());
+    ASSERT_LE(io.cached(), 4 * blockSize);
+
+    // The block which was read is kept, the others are fetched again
+    ASSERT_EQ(static_cast<byte>(data[5 * blockSize + 7]), byteAt(io, 5 * blockSize + 7));
+    ASSERT_EQ(1u, io.requests());
+    ASSERT_EQ(static_cast<byte>(data[20 * blockSize]), byteAt(io, 20 * blockSize));
+    ASSERT_EQ(2u, io.requests());
+    ASSERT_LE(io.cached(), 4 * blockSize);
+}
+
+TEST(ARemoteIO, boundsTheCacheForAFileOfUnknownLength)
+{
+    const CacheSize cacheSize(4 * blockSize);
+    const std::string data = makeFile(32);
+    FakeRemoteIo::Server server;
+    server.knowsLength = false;
+    FakeRemoteIo io(data, server);
+    ASSERT_EQ(0, io.open());
+    ASSERT_EQ(data.size(), io.size());
+    ASSERT_LE(io.cached(), 4 * blockSize);
+
+    ASSERT_EQ(static_cast<byte>(data[0]), byteAt(io, 0));
+    ASSERT_EQ(static_cast<byte>(data[30 * blockSize]), byteAt(io, 30 * blockSize));
+}
+
+TEST(ARemoteIO, finishesItsReadAheadBeforeAReadReturns)
+{
+    const std::string data = makeFile(64);
+    FakeRemoteIo::Server server;
+    server.concurrent = true;
+    server.delayMs = 20;
+    FakeRemoteIo io(data, server);
+    ASSERT_EQ(0, io.open());
+
+    std::vector<byte> buf(blockSize);
+    for (size_t block = 0; block < 3; ++block) {
+        ASSERT_EQ(static_cast<long>(blockSize), io.read(buf.data(), static_cast<long>(blockSize)));
+        ASSERT_EQ(0, std::memcmp(data.data() + block * blockSize, buf.data(), blockSize));
+        ASSERT_EQ(0, io.inFlight());
+    }
+    // The read-ahead requests were sent along with the first one
+    ASSERT_GT(io.maxInFlight(), 1);
+
+    ASSERT_EQ(0, io.close());
+    const size_t requests = io.requests();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5 * server.delayMs));
+    ASSERT_EQ(requests, io.requests());
+    ASSERT_EQ(0, io.inFlight());
+}
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+
+#include <exiv2/exiv2.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace Exiv2;
+
+#ifdef EXV_HAVE_XMP_TOOLKIT
+namespace
+{
+    std::string packet(const std::string& description)
+    {
+        return "<?xpacket begin=\"\xef\xbb\xbf\" id=\"W5M0MpCehiHzreSzNTczkc9d\"?>\n"
+               "<x:xmpmeta xmlns:x=\"adobe:ns:meta/\">\n"
+               "<rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\">\n"
+               "<rdf:Description rdf:about=\"\""
+               " xmlns:dc=\"http://purl.org/dc/elements/1.1/\""
+               " xmlns:xmp=\"http://ns.adobe.com/xap/1.0/\""
+               " xmlns:exif=\"http://ns.adobe.com/exif/1.0/\""
+               " xmlns:tiff=\"http://ns.adobe.com/tiff/1.0/\""
+               " xmlns:xmpMM=\"http://ns.adobe.com/xap/1.0/mm/\""
+               " xmlns:stEvt=\"http://ns.adobe.com/xap/1.0/sType/ResourceEvent#\""
+               + description + "</rdf:Description>\n</rdf:RDF>\n</x:xmpmeta>\n<?xpacket end=\"w\"?>";
+    }
+
+    // Decode the packet and describe each property as "key|type name|value"
+    std::vector<std::string> decode(const std::string& xmpPacket)
+    {
+        XmpData xmpData;
+        EXPECT_EQ(0, XmpParser::decode(xmpData, xmpPacket));
+        std::vector<std::string> properties;
+        for (auto&& md : xmpData) {
+            properties.push_back(md.key() + "|" + md.typeName() + "|" + md.toString());
+        }
+        return properties;
+    }
+}  // namespace
+
+TEST(XmpParser, decodesSimplePropertiesInSchemaOrder)
+{
+    const std::vector<std::string> expected{
+        "Xmp.xmp.Rating|XmpText|3",
+        "Xmp.xmp.Label|XmpText|",
+        "Xmp.xmp.Nickname|XmpText|  a & b\n",
+        "Xmp.tiff.Make|XmpText|Canon",
+    };
+    ASSERT_EQ(expected, decode(packet(" xmp:Rating=\"3\" tiff:Make=\"Canon\">"
+                                      "<xmp:Label/><xmp:Nickname>  a &amp; b\n</xmp:Nickname>")));
+}
+
+TEST(XmpParser, decodesArraysAndLanguageAlternatives)
+{
+    const std::vector<std::string> expected{
+        "Xmp.dc.subject|XmpBag|a, c",
+        "Xmp.dc.title|LangAlt|lang=\"x-default\" Hi, lang=\"zh-hant-tw\" x, lang=\"de-CH-1996\" Gr\xc3\xbc" "ezi, "
+        "lang=\"en-US\" Hello",
+        "Xmp.xmp.Identifier|XmpBag|",
+    };
+    ASSERT_EQ(expected, decode(packet(">"
+                                      "<dc:subject><rdf:Bag><rdf:li>a</rdf:li><rdf:li/><rdf:li>c</rdf:li></rdf:Bag></dc:subject>"
+                                      "<dc:title><rdf:Alt>"
+                                      "<rdf:li xml:lang=\"EN-us\">Hello</rdf:li>"
+                                      "<rdf:li xml:lang=\"x-default\">Hi</rdf:li>"
+                                      "<rdf:li xml:lang=\"de-ch-1996\">Gr\xc3\xbc" "ezi</rdf:li>"
+                                      "<rdf:li xml:lang=\"zh-Hant-TW\">x</rdf:li>"
+                                      "</rdf:Alt></dc:title>"
+                                      "<xmp:Identifier><rdf:Bag/></xmp:Identifier>")));
+}
+
+TEST(XmpParser, decodesStructsInAllForms)
+{
+    const std::vector<std::string> expected{
+        "Xmp.exif.Flash|XmpText|type=\"Struct\"",
+        "Xmp.exif.Flash/exif:Fired|XmpText|True",
+        "Xmp.exif.Flash/exif:Mode|XmpText|2",
+        "Xmp.xmpMM.History|XmpText|type=\"Seq\"",
+        "Xmp.xmpMM.History[1]|XmpText|type=\"Struct\"",
+        "Xmp.xmpMM.History[1]/stEvt:action|XmpText|saved",
+        "Xmp.xmpMM.History[2]|XmpText|type=\"Struct\"",
+        "Xmp.xmpMM.History[2]/stEvt:action|XmpText|x",
+        "Xmp.xmpMM.History[3]|XmpText|type=\"Struct\"",
+        "Xmp.xmpMM.History[3]/stEvt:action|XmpText|y",
+        "Xmp.xmpMM.History[3]/stEvt:when|XmpText|2020",
+    };
+    ASSERT_EQ(expected, decode(packet(">"
+                                      "<exif:Flash exif:Fired=\"True\" exif:Mode=\"2\"/>"
+                                      "<xmpMM:History><rdf:Seq>"
+                                      "<rdf:li stEvt:action=\"saved\"/>"
+                                      "<rdf:li rdf:parseType=\"Resource\"><stEvt:action>x</stEvt:action></rdf:li>"
+                                      "<rdf:li><rdf:Description stEvt:action=\"y\"><stEvt:when>2020</stEvt:when>"
+                                      "</rdf:Description></rdf:li>"
+                                      "</rdf:Seq></xmpMM:History>")));
+}
+
+TEST(XmpParser, leavesOtherFormsToTheXmpToolkit)
+{
+    // Qualifiers
+    const std::vector<std::string> qualifier{
+        "Xmp.xmp.Label|XmpText|x",
+        "Xmp.xmp.Label/?xml:lang|XmpText|en",
+    };
+    ASSERT_EQ(qualifier, decode(packet("><xmp:Label xml:lang=\"en\">x</xmp:Label>")));
+    // Properties which the toolkit normalizes
+    const std::vector<std::string> creator{"Xmp.dc.creator|XmpSeq|me"};
+    ASSERT_EQ(creator, decode(packet(" dc:creator=\"me\">")));
+    // Characters which the toolkit replaces
+    const std::vector<std::string> label{"Xmp.xmp.Label|XmpText|a b"};
+    ASSERT_EQ(label, decode(packet(" xmp:Label=\"a&#xA9;b\">")));
+    // Namespaces which the toolkit doesn't know yet
+    const std::vector<std::string> unknown{"Xmp.xmpParserTest.Bar|XmpText|1"};
+    ASSERT_EQ(unknown, decode(packet(" xmlns:xmpParserTest=\"http://example.com/xmpParserTest/\""
+                                     " xmpParserTest:Bar=\"1\">")));
+}
+
+TEST(XmpParser, encodesLikeTheXmpToolkit)
+{
+    XmpData xmpData;
+    xmpData["Xmp.dc.title"] = "lang=x-default Hi";
+    xmpData["Xmp.dc.subject"] = "a";
+    xmpData["Xmp.dc.subject"] = "b";
+    xmpData["Xmp.xmp.Rating"] = "3";
+    xmpData["Xmp.xmp.Label"] = "a<b & \"c\"";
+    XmpTextValue flash;
+    flash.setXmpStruct();
+    xmpData.add(XmpKey("Xmp.exif.Flash"), &flash);
+    xmpData["Xmp.exif.Flash/exif:Fired"] = "True";
+    xmpData["Xmp.exif.Flash/exif:Mode"] = "2";
+
+    std::string xmpPacket;
+    ASSERT_EQ(0, XmpParser::encode(xmpPacket, xmpData, XmpParser::omitPacketWrapper | XmpParser::useCompactFormat));
+    // Skip the x:xmpmeta start tag, which has the version of the toolkit
+    ASSERT_EQ(0, xmpPacket.find("<x:xmpmeta xmlns:x=\"adobe:ns:meta/\" x:xmptk=\""));
+    const std::string expected =
+        " <rdf:RDF xmlns:rdf=\"http://www.w3.org/1999/02/22-rdf-syntax-ns#\">\n"
+        "  <rdf:Description rdf:about=\"\"\n"
+        "    xmlns:dc=\"http://purl.org/dc/elements/1.1/\"\n"
+        "    xmlns:xmp=\"http://ns.adobe.com/xap/1.0/\"\n"
+        "    xmlns:exif=\"http://ns.adobe.com/exif/1.0/\"\n"
+        "   xmp:Rating=\"3\"\n"
+        "   xmp:Label=\"a&lt;b &amp; &quot;c&quot;\">\n"
+        "   <dc:title>\n"
+        "    <rdf:Alt>\n"
+        "     <rdf:li xml:lang=\"x-default\">Hi</rdf:li>\n"
+        "    </rdf:Alt>\n"
+        "   </dc:title>\n"
+        "   <dc:subject>\n"
+        "    <rdf:Bag>\n"
+        "     <rdf:li>a</rdf:li>\n"
+        "     <rdf:li>b</rdf:li>\n"
+        "    </rdf:Bag>\n"
+        "   </dc:subject>\n"
+        "   <exif:Flash\n"
+        "    exif:Fired=\"True\"\n"
+        "    exif:Mode=\"2\"/>\n"
+        "  </rdf:Description>\n"
+        " </rdf:RDF>\n"
+        "</x:xmpmeta>\n";
+    ASSERT_EQ(expected, xmpPacket.substr(xmpPacket.find('\n') + 1));
+
+    // The canonical format with the packet wrapper and padding
+    ASSERT_EQ(0, XmpParser::encode(xmpPacket, xmpData, 0));
+    ASSERT_EQ(0, xmpPacket.find("<?xpacket begin=\"\xef\xbb\xbf\" id=\"W5M0MpCehiHzreSzNTczkc9d\"?>\n"));
+    ASSERT_NE(std::string::npos, xmpPacket.find("\n         <exif:Flash rdf:parseType=\"Resource\">\n"));
+    // 2048 bytes of padding in lines of 100 spaces
+    std::string padding;
+    for (int i = 0; i < 20; ++i) padding += std::string(100, ' ') + "\n";
+    padding += std::string(27, ' ') + "\n";
+    ASSERT_EQ("</x:xmpmeta>\n" + padding + "<?xpacket end=\"w\"?>", xmpPacket.substr(xmpPacket.size() - 2048 - 32));
+}
+
+TEST(XmpParser, encodesWhatItDecodes)
+{
+    const std::string description =
+        " xmp:Rating=\"3\" tiff:Make=\"Canon\">"
+        "<dc:subject><rdf:Bag><rdf:li>a</rdf:li><rdf:li/><rdf:li>c</rdf:li></rdf:Bag></dc:subject>"
+        "<dc:title><rdf:Alt><rdf:li xml:lang=\"x-default\">Hi</rdf:li></rdf:Alt></dc:title>"
+        "<xmpMM:History><rdf:Seq>"
+        "<rdf:li stEvt:action=\"saved\"/>"
+        "<rdf:li rdf:parseType=\"Resource\"><stEvt:action>x</stEvt:action></rdf:li>"
+        "</rdf:Seq></xmpMM:History>"
+        // A qualifier, which the XMP toolkit encodes
+        "<xmp:Label xml:lang=\"en\">x</xmp:Label>";
+    const std::vector<std::string> expected = decode(packet(description));
+    for (auto&& formatFlags : {0, XmpParser::useCompactFormat | XmpParser::omitPacketWrapper,
+                               XmpParser::useCompactFormat | XmpParser::omitAllFormatting}) {
+        XmpData xmpData;
+        ASSERT_EQ(0, XmpParser::decode(xmpData, packet(description)));
+        std::string xmpPacket;
+        ASSERT_EQ(0, XmpParser::encode(xmpPacket, xmpData, static_cast<uint16_t>(formatFlags)));
+        ASSERT_EQ(expected, decode(xmpPacket));
+    }
+}
+
+TEST(XmpParser, rejectsInvalidPackets)
+{
+    XmpData xmpData;
+    ASSERT_EQ(3, XmpParser::decode(xmpData, packet(" xmp:Rating=\"1\"><xmp:Label>")));
+    ASSERT_EQ(3, XmpParser::decode(xmpData, packet(" xmp:Rating=\"1\" xmp:Rating=\"2\">")));
+    ASSERT_EQ(0, xmpData.count());
+}
+#endif
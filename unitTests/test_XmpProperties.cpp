@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <exiv2/error.hpp>
+#include <exiv2/properties.hpp>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace Exiv2;
+
+TEST(XmpProperties, findsTheFirstPropertyWithAName)
+{
+    for (auto&& prefix : {"dc", "xmp", "exif", "tiff", "crs", "iptcExt", "MPRI", "lr"}) {
+        const XmpPropertyInfo* pl = XmpProperties::propertyList(prefix);
+        ASSERT_NE(nullptr, pl);
+        for (const XmpPropertyInfo* pi = pl; pi->name_ != nullptr; ++pi) {
+            const XmpPropertyInfo* first = pl;
+            while (std::strcmp(first->name_, pi->name_) != 0) ++first;
+            ASSERT_EQ(first, XmpProperties::propertyInfo(XmpKey(prefix, pi->name_))) << prefix << ":" << pi->name_;
+        }
+        ASSERT_EQ(nullptr, XmpProperties::propertyInfo(XmpKey(prefix, "NoSuchProperty")));
+    }
+    // The innermost element of a nested property
+    ASSERT_STREQ("Regions", XmpProperties::propertyInfo(XmpKey("Xmp.MP.RegionInfo/MPRI:Regions"))->name_);
+}
+
+TEST(XmpProperties, looksUpBuiltInAndRegisteredNamespaces)
+{
+    ASSERT_EQ("http://purl.org/dc/elements/1.1/", XmpProperties::ns("dc"));
+    ASSERT_EQ("dc", XmpProperties::prefix("http://purl.org/dc/elements/1.1/"));
+    ASSERT_EQ("dc", XmpProperties::prefix("http://purl.org/dc/elements/1.1"));
+    ASSERT_EQ("", XmpProperties::prefix("http://example.com/notRegistered/"));
+    ASSERT_THROW(XmpProperties::ns("notRegistered"), Error);
+
+    // A registered namespace replaces a built-in one with the same prefix
+    XmpProperties::registerNs("http://example.com/dc/", "dc");
+    ASSERT_EQ("http://example.com/dc/", XmpProperties::ns("dc"));
+    ASSERT_EQ(nullptr, XmpProperties::propertyList("dc"));
+    ASSERT_EQ("dc", XmpProperties::prefix("http://example.com/dc/"));
+    XmpProperties::unregisterNs();
+    ASSERT_EQ("http://purl.org/dc/elements/1.1/", XmpProperties::ns("dc"));
+    ASSERT_NE(nullptr, XmpProperties::propertyList("dc"));
+}
+
+TEST(XmpProperties, canBeReadWhileNamespacesAreRegistered)
+{
+    std::atomic<bool> failed(false);
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            for (int i = 0; i < 2000; ++i) {
+                if (   XmpProperties::ns("xmp") != "http://ns.adobe.com/xap/1.0/"
+                    || XmpProperties::propertyType(XmpKey("Xmp.dc.subject")) != xmpBag) {
+                    failed = true;
+                }
+            }
+        });
+    }
+    for (int i = 0; i < 200; ++i) {
+        XmpProperties::registerNs("http://example.com/xmpPropertiesTest/", "xmpPropertiesTest");
+        XmpProperties::unregisterNs("http://example.com/xmpPropertiesTest/");
+    }
+    for (auto&& reader : readers) {
+        reader.join();
+    }
+    ASSERT_FALSE(failed);
+}
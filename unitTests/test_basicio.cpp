@@ -21,7 +21,10 @@
 #include <exiv2/basicio.hpp>
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
+#include <cstring>
+#include <vector>
 
 using namespace Exiv2;
 
@@ -166,3 +169,161 @@ TEST(MemIo, readMoreBytesThanAvailableReturnsAvailableBytes)
     MemIo io(buf1.data(), static_cast<long>(buf1.size()));
     ASSERT_EQ(10, io.read(buf2.data(), 15));
 }
+
+TEST(MemIo, readViewReturnsPointerIntoBufferAndAdvancesPosition)
+{
+    std::array<byte, 10> buf;
+    buf.fill(1);
+
+    MemIo io(buf.data(), static_cast<long>(buf.size()));
+    ASSERT_EQ(0, io.seek(2, BasicIo::beg));
+    ASSERT_EQ(buf.data() + 2, io.readView(5));
+    ASSERT_EQ(7, io.tell());
+    ASSERT_FALSE(io.eof());
+}
+
+TEST(MemIo, readViewMoreBytesThanAvailableReturnsNullAndDoesNotMove)
+{
+    std::array<byte, 10> buf;
+    buf.fill(1);
+
+    MemIo io(buf.data(), static_cast<long>(buf.size()));
+    ASSERT_EQ(0, io.seek(5, BasicIo::beg));
+    ASSERT_EQ(nullptr, io.readView(6));
+    ASSERT_EQ(5, io.tell());
+}
+
+TEST(MemIo, readViewOrThrowThrowsIfNotEnoughBytesAreAvailable)
+{
+    std::array<byte, 10> buf;
+    buf.fill(1);
+
+    MemIo io(buf.data(), static_cast<long>(buf.size()));
+    DataBuf storage;
+    ASSERT_THROW(io.readViewOrThrow(11, storage, kerFailedToReadImageData), Error);
+}
+
+TEST(MemIo, copyFromAppendsTheRangeAndPositionsTheSource)
+{
+    std::array<byte, 10> buf;
+    for (size_t i = 0; i < buf.size(); ++i) buf[i] = static_cast<byte>(i);
+
+    MemIo src(buf.data(), static_cast<long>(buf.size()));
+    MemIo dst;
+    ASSERT_EQ(1, dst.write(buf.data(), 1));
+    dst.copyFrom(src, 3, 4);
+    ASSERT_EQ(7, src.tell());
+    ASSERT_EQ(5, dst.tell());
+    ASSERT_EQ(5u, dst.size());
+    ASSERT_EQ(0, std::memcmp(dst.mmap() + 1, buf.data() + 3, 4));
+}
+
+TEST(MemIo, copyFromThrowsIfNotEnoughBytesAreAvailable)
+{
+    std::array<byte, 10> buf;
+    buf.fill(1);
+
+    MemIo src(buf.data(), static_cast<long>(buf.size()));
+    MemIo dst;
+    ASSERT_THROW(dst.copyFrom(src, 5, 6), Error);
+    ASSERT_EQ(0u, dst.size());
+}
+
+TEST(MemIo, seekToByteStopsAtTheByteWithoutConsumingIt)
+{
+    const std::array<byte, 6> buf = {0x00, 0x01, 0xff, 0x02, 0xff, 0x03};
+
+    MemIo io(buf.data(), static_cast<long>(buf.size()));
+    ASSERT_EQ(0, io.seekToByte(0xff));
+    ASSERT_EQ(2, io.tell());
+    ASSERT_EQ(0, io.seekToByte(0xff));
+    ASSERT_EQ(2, io.tell());
+    ASSERT_EQ(0xff, io.getb());
+    ASSERT_EQ(0, io.seekToByte(0xff));
+    ASSERT_EQ(4, io.tell());
+}
+
+TEST(MemIo, seekToByteNotFoundMovesToTheEndAndSetsEof)
+{
+    const std::array<byte, 4> buf = {0x00, 0x01, 0x02, 0x03};
+
+    MemIo io(buf.data(), static_cast<long>(buf.size()));
+    ASSERT_NE(0, io.seekToByte(0xff));
+    ASSERT_EQ(4, io.tell());
+    ASSERT_TRUE(io.eof());
+}
+
+TEST(MemIo, readAtDoesNotMoveThePosition)
+{
+    const std::array<byte, 6> buf = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05};
+    std::array<byte, 4> out;
+
+    MemIo io(buf.data(), static_cast<long>(buf.size()));
+    ASSERT_EQ(0, io.seek(1, BasicIo::beg));
+    ASSERT_EQ(3, io.readAt(3, out.data(), 4));
+    ASSERT_EQ(0x03, out[0]);
+    ASSERT_EQ(0x05, out[2]);
+    ASSERT_EQ(0, io.readAt(6, out.data(), 4));
+    ASSERT_EQ(1, io.tell());
+}
+
+TEST(MemIo, readsBackDataWrittenBeyondTheFirstChunk)
+{
+    // 10 MB written in pieces that do not line up with the 4 MB chunks
+    std::vector<byte> data(10 * 1024 * 1024 + 17);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<byte>(i % 251);
+
+    MemIo io;
+    for (size_t pos = 0; pos < data.size(); pos += 100000) {
+        const long count = static_cast<long>(std::min<size_t>(100000, data.size() - pos));
+        ASSERT_EQ(count, io.write(&data[pos], count));
+    }
+    ASSERT_EQ(data.size(), io.size());
+
+    std::vector<byte> out(data.size());
+    ASSERT_EQ(0, io.seek(0, BasicIo::beg));
+    ASSERT_EQ(static_cast<long>(out.size()), io.read(out.data(), static_cast<long>(out.size())));
+    ASSERT_EQ(data, out);
+
+    const long boundary = 8 * 1024 * 1024;
+    ASSERT_EQ(16, io.readAt(boundary - 8, out.data(), 16));
+    ASSERT_EQ(0, std::memcmp(out.data(), &data[boundary - 8], 16));
+    ASSERT_EQ(0, io.seek(boundary - 1, BasicIo::beg));
+    ASSERT_EQ(data[boundary - 1], io.getb());
+    ASSERT_EQ(data[boundary], io.getb());
+    ASSERT_EQ(0, io.seek(boundary - 2, BasicIo::beg));
+    ASSERT_EQ(0, io.seekToByte(data[boundary + 1]));
+    ASSERT_EQ(boundary + 1, io.tell());
+
+    // a view across chunks is read instead, mmap() needs the data in one piece
+    ASSERT_EQ(0, io.seek(boundary - 8, BasicIo::beg));
+    ASSERT_EQ(nullptr, io.readView(16));
+    ASSERT_EQ(boundary - 8, io.tell());
+    ASSERT_EQ(0, std::memcmp(io.mmap(), data.data(), data.size()));
+}
+
+TEST(MemIo, keepsAViewValidAcrossAViewOfTwoChunksAndMmap)
+{
+    std::vector<byte> data(10 * 1024 * 1024);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<byte>(i % 251);
+
+    MemIo io;
+    for (size_t pos = 0; pos < data.size(); pos += 100000) {
+        const long count = static_cast<long>(std::min<size_t>(100000, data.size() - pos));
+        ASSERT_EQ(count, io.write(&data[pos], count));
+    }
+
+    const long boundary = 8 * 1024 * 1024;
+    ASSERT_EQ(0, io.seek(boundary - 24, BasicIo::beg));
+    const byte* first = io.readView(16);
+    ASSERT_NE(nullptr, first);
+
+    DataBuf storage;
+    const byte* second = io.readViewOrThrow(16, storage, kerFailedToReadImageData);
+    ASSERT_EQ(storage.c_data(), second);
+    ASSERT_EQ(boundary + 8, io.tell());
+    ASSERT_EQ(0, std::memcmp(second, &data[boundary - 8], 16));
+
+    ASSERT_EQ(0, std::memcmp(io.mmap(), data.data(), data.size()));
+    ASSERT_EQ(0, std::memcmp(first, &data[boundary - 24], 16));
+}
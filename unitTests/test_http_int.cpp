@@ -0,0 +1,135 @@
+// ***************************************************************** -*- C++ -*-
+/*
+ * Copyright (C) 2004-2021 Exiv2 authors
+ * This program is part of the Exiv2 distribution.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, 5th Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <gtest/gtest.h>
+#include <http_int.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace Exiv2::Internal;
+
+namespace {
+    const std::string resource = "0123456789abcdefghijklmnopqrstuvwxyz";
+    const std::vector<std::pair<uint64_t, uint64_t>> ranges = {{2, 5}, {10, 12}, {30, 35}};
+}  // namespace
+
+TEST(dechunk, decodesACompleteBody)
+{
+    const std::string data = "HEAD\r\n\r\n4\r\nWiki\r\n7\r\npedia i\r\n0\r\n\r\n";
+    std::string body;
+    ASSERT_TRUE(dechunk(data, 8, body));
+    ASSERT_EQ("Wikipedia i", body);
+}
+
+TEST(dechunk, acceptsATrailerAfterTheLastChunk)
+{
+    const std::string data = "5\r\nhello\r\n0\r\nExpires: never\r\nX-Check: 1\r\n\r\n";
+    std::string body;
+    ASSERT_TRUE(dechunk(data, 0, body));
+    ASSERT_EQ("hello", body);
+
+    // the trailer is not complete yet
+    ASSERT_FALSE(dechunk(data.substr(0, data.size() - 2), 0, body));
+}
+
+TEST(dechunk, returnsFalseForATruncatedChunk)
+{
+    std::string body;
+    ASSERT_FALSE(dechunk("a\r\n0123", 0, body));
+    ASSERT_FALSE(dechunk("a\r\n0123456789", 0, body));
+    ASSERT_FALSE(dechunk("a\r\n0123456789\r", 0, body));
+    ASSERT_FALSE(dechunk("5\r\nhello\r\n", 0, body));
+}
+
+TEST(dechunk, rejectsAChunkSizeLargerThanTheData)
+{
+    std::string body;
+    ASSERT_FALSE(dechunk("ffffffffffffffff\r\nabc\r\n0\r\n\r\n", 0, body));
+    ASSERT_FALSE(dechunk("fffffffffffffffe\r\n\r\n0\r\n\r\n", 0, body));
+    ASSERT_TRUE(body.empty());
+}
+
+TEST(dechunk, rejectsAMalformedChunkSize)
+{
+    std::string body;
+    ASSERT_FALSE(dechunk("xyz\r\n\r\n", 0, body));
+}
+
+TEST(parseContentRange, readsTheFirstAndLastByte)
+{
+    uint64_t first = 0;
+    uint64_t last = 0;
+    ASSERT_TRUE(parseContentRange("bytes 100-199/1000", first, last));
+    ASSERT_EQ(100u, first);
+    ASSERT_EQ(199u, last);
+
+    ASSERT_FALSE(parseContentRange("bytes */1000", first, last));
+    ASSERT_FALSE(parseContentRange("bytes 200-100/1000", first, last));
+    ASSERT_FALSE(parseContentRange("", first, last));
+}
+
+TEST(extractRanges, copiesTheRangesOutOfTheWholeResourceForStatus200)
+{
+    std::vector<std::string> parts;
+    extractRanges(200, "image/jpeg", "", resource, ranges, parts);
+    ASSERT_EQ(3u, parts.size());
+    ASSERT_EQ("2345", parts[0]);
+    ASSERT_EQ("abc", parts[1]);
+    ASSERT_EQ("uvwxyz", parts[2]);
+}
+
+TEST(extractRanges, splitsTheRangesOfAMergedSingleRange)
+{
+    std::vector<std::string> parts;
+    extractRanges(206, "image/jpeg", "bytes 2-12/36", resource.substr(2, 11), ranges, parts);
+    ASSERT_EQ(3u, parts.size());
+    ASSERT_EQ("2345", parts[0]);
+    ASSERT_EQ("abc", parts[1]);
+    ASSERT_TRUE(parts[2].empty());
+}
+
+TEST(extractRanges, splitsAMultipartBody)
+{
+    const std::string body =
+        "\r\n--XYZ\r\nContent-Type: image/jpeg\r\nContent-Range: bytes 2-5/36\r\n\r\n2345"
+        "\r\n--XYZ\r\nContent-Type: image/jpeg\r\nContent-Range: bytes 30-35/36\r\n\r\nuvwxyz"
+        "\r\n--XYZ--\r\n";
+    std::vector<std::string> parts;
+    extractRanges(206, "multipart/byteranges; boundary=\"XYZ\"", "", body, ranges, parts);
+    ASSERT_EQ(3u, parts.size());
+    ASSERT_EQ("2345", parts[0]);
+    ASSERT_TRUE(parts[1].empty());
+    ASSERT_EQ("uvwxyz", parts[2]);
+}
+
+TEST(extractRanges, keepsThePartsOfAMultipartBodyWithoutTheClosingBoundary)
+{
+    const std::string body =
+        "--XYZ\r\nContent-Range: bytes 2-5/36\r\n\r\n2345"
+        "\r\n--XYZ\r\nContent-Range: bytes 10-12/36\r\n\r\nab";
+    std::vector<std::string> parts;
+    extractRanges(206, "multipart/byteranges; boundary=XYZ", "", body, ranges, parts);
+    ASSERT_EQ(3u, parts.size());
+    ASSERT_EQ("2345", parts[0]);
+    ASSERT_EQ("ab", parts[1]);
+    ASSERT_TRUE(parts[2].empty());
+}
@@ -66,3 +66,26 @@ TEST(binaryToString, nonZeroStart)
     // start @ index 3, read until end
     checkBinaryToString(makeSlice(buf, 3, sizeof(buf)), "...e..a");
 }
+
+TEST(padXmpPacket, insertsWhitespaceBeforeTheTrailer)
+{
+    std::string packet("<?xpacket begin=\"\"?><x:xmpmeta/><?xpacket end=\"w\"?>");
+    const size_t size = packet.size() + 5;
+    ASSERT_TRUE(padXmpPacket(packet, size));
+    ASSERT_EQ(size, packet.size());
+    ASSERT_EQ("<?xpacket begin=\"\"?><x:xmpmeta/>     <?xpacket end=\"w\"?>", packet);
+}
+
+TEST(padXmpPacket, appendsWhitespaceWithoutTrailer)
+{
+    std::string packet("<x:xmpmeta/>");
+    ASSERT_TRUE(padXmpPacket(packet, 14));
+    ASSERT_EQ("<x:xmpmeta/>  ", packet);
+}
+
+TEST(padXmpPacket, failsIfThePacketIsTooLarge)
+{
+    std::string packet("<x:xmpmeta/>");
+    ASSERT_FALSE(padXmpPacket(packet, 4));
+    ASSERT_EQ("<x:xmpmeta/>", packet);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <exiv2/tags.hpp>
+#include "tags_int.hpp"
+
+#include <cstring>
+
+using namespace Exiv2;
+using namespace Exiv2::Internal;
+
+TEST(TagsInt, groupLookupsFindEveryGroup)
+{
+    for (const GroupInfo* gi = ExifTags::groupList(); gi->ifdId_ != lastId; ++gi) {
+        const auto ifdId = static_cast<IfdId>(gi->ifdId_);
+        ASSERT_EQ(ifdId, groupId(gi->groupName_));
+        ASSERT_STREQ(gi->groupName_, groupName(ifdId));
+        ASSERT_STREQ(gi->ifdName_, ifdName(ifdId));
+    }
+    ASSERT_EQ(ifdIdNotSet, groupId("NoSuchGroup"));
+}
+
+TEST(TagsInt, tagLookupsReturnTheFirstMatchOfTheTagList)
+{
+    for (const GroupInfo* gi = ExifTags::groupList(); gi->ifdId_ != lastId; ++gi) {
+        if (gi->tagList_ == nullptr)
+            continue;
+        const auto ifdId = static_cast<IfdId>(gi->ifdId_);
+        const TagInfo* list = tagList(ifdId);
+        int end = 0;
+        while (list[end].tag_ != 0xffff)
+            ++end;
+        for (int i = 0; i < end; ++i) {
+            int first = 0;
+            while (list[first].tag_ != list[i].tag_)
+                ++first;
+            ASSERT_EQ(&list[first], tagInfo(list[i].tag_, ifdId)) << gi->groupName_ << " " << list[i].name_;
+            first = 0;
+            while (std::strcmp(list[first].name_, list[i].name_) != 0)
+                ++first;
+            ASSERT_EQ(&list[first], tagInfo(list[i].name_, ifdId)) << gi->groupName_ << " " << list[i].name_;
+        }
+        ASSERT_EQ(&list[end], tagInfo(0xffff, ifdId));
+        ASSERT_EQ(nullptr, tagInfo("NoSuchTag", ifdId));
+    }
+}
+
+namespace
+{
+    constexpr TagDetails lensTypes[] = {
+        {40, "40"}, {3, "3a"}, {38, "38"}, {37, "37"}, {36, "36"}, {35, "35"}, {34, "34"}, {33, "33"},
+        {32, "32"}, {31, "31"}, {30, "30"}, {29, "29"}, {28, "28"}, {27, "27"}, {26, "26"}, {25, "25"},
+        {24, "24"}, {23, "23"}, {22, "22"}, {21, "21"}, {20, "20"}, {19, "19"}, {18, "18"}, {17, "17"},
+        {16, "16"}, {15, "15"}, {14, "14"}, {13, "13"}, {12, "12"}, {11, "11"}, {10, "10"}, {3, "3b"},
+        {-1, "n/a"}, {3, "3c"},
+    };
+}  // namespace
+
+TEST(TagsInt, findTagDetailsReturnsTheFirstMatchOfTheTable)
+{
+    for (auto&& td : lensTypes) {
+        ASSERT_EQ(find(lensTypes, td.val_), (findTagDetails<EXV_COUNTOF(lensTypes), lensTypes>(td.val_)));
+    }
+    ASSERT_EQ(nullptr, (findTagDetails<EXV_COUNTOF(lensTypes), lensTypes>(39)));
+    ASSERT_EQ(nullptr, (findTagDetails<EXV_COUNTOF(lensTypes), lensTypes>(41)));
+    ASSERT_EQ(nullptr, (findTagDetails<EXV_COUNTOF(lensTypes), lensTypes>(-2)));
+
+    auto range = findTagDetailsRange<EXV_COUNTOF(lensTypes), lensTypes>(3);
+    ASSERT_EQ(3, range.second - range.first);
+    ASSERT_STREQ("3a", range.first[0]->label_);
+    ASSERT_STREQ("3b", range.first[1]->label_);
+    ASSERT_STREQ("3c", range.first[2]->label_);
+}
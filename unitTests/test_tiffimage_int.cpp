@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include "tiffcomposite_int.hpp"
+#include "tiffimage_int.hpp"
+
+#include <vector>
+
+using namespace Exiv2;
+using namespace Exiv2::Internal;
+
+namespace
+{
+    std::vector<std::pair<uint32_t, IfdId>> pathOf(uint32_t extendedTag, IfdId group, uint32_t root)
+    {
+        TiffPath tiffPath;
+        TiffCreator::getPath(tiffPath, extendedTag, group, root);
+        std::vector<std::pair<uint32_t, IfdId>> path;
+        for (; !tiffPath.empty(); tiffPath.pop()) {
+            path.emplace_back(tiffPath.top().extendedTag(), tiffPath.top().group());
+        }
+        return path;
+    }
+}  // namespace
+
+TEST(TiffCreator, getPathReturnsThePathFromTheRoot)
+{
+    using Path = std::vector<std::pair<uint32_t, IfdId>>;
+    ASSERT_EQ(Path({{Tag::root, ifdIdNotSet}, {0x8769, ifd0Id}, {0x9000, exifId}}),
+              pathOf(0x9000, exifId, Tag::root));
+    ASSERT_EQ(Path({{Tag::root, ifdIdNotSet}, {0x8769, ifd0Id}, {0x927c, exifId}, {0x0001, canonId},
+                    {0x0002, canonCsId}}),
+              pathOf(0x0002, canonCsId, Tag::root));
+    ASSERT_EQ(Path({{Tag::root, ifdIdNotSet}}), pathOf(Tag::root, ifdIdNotSet, Tag::root));
+}
+
+TEST(TiffCreator, createUsesTheFirstMatchingEntry)
+{
+    // Specific entries
+    ASSERT_NE(nullptr, dynamic_cast<TiffSubIfd*>(TiffCreator::create(0x8769, ifd0Id).get()));
+    ASSERT_NE(nullptr, dynamic_cast<TiffMnEntry*>(TiffCreator::create(0x927c, exifId).get()));
+    // Entries for all tags of a group
+    ASSERT_NE(nullptr, dynamic_cast<TiffEntry*>(TiffCreator::create(0x9000, exifId).get()));
+    ASSERT_NE(nullptr, dynamic_cast<TiffBinaryElement*>(TiffCreator::create(0x0002, canonCsId).get()));
+    // The root directory
+    auto root = TiffCreator::create(Tag::root, ifdIdNotSet);
+    ASSERT_NE(nullptr, dynamic_cast<TiffDirectory*>(root.get()));
+    ASSERT_EQ(ifd0Id, root->group());
+}
+
+TEST(TiffArena, componentsCanOutliveTheirScope)
+{
+    std::vector<TiffComponent::UniquePtr> components;
+    {
+        TiffArena::Scope scope;
+        TiffArena::Scope nested;
+        for (uint16_t tag = 0; tag < 5000; ++tag) {
+            components.push_back(TiffCreator::create(tag, exifId));
+        }
+        // Every other component is deleted while the arena is installed
+        for (size_t i = 0; i < components.size(); i += 2) {
+            components[i].reset();
+        }
+    }
+    for (size_t i = 1; i < components.size(); i += 2) {
+        ASSERT_EQ(i, components[i]->tag());
+        ASSERT_EQ(exifId, components[i]->group());
+    }
+    components.clear();
+    // Without an arena, components are allocated from the heap
+    auto tc = TiffCreator::create(0x9000, exifId);
+    ASSERT_EQ(0x9000, tc->tag());
+}
@@ -117,7 +117,7 @@ ExpatAdapter::~ExpatAdapter()
 // =================================================================================================
 
 #if XMP_DebugBuild
-	static XMP_VarString sExpatMessage;
+	static thread_local XMP_VarString sExpatMessage;
 #endif
 
 static const char * kOneSpace = " ";
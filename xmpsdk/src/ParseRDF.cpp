@@ -386,6 +386,7 @@ AddChildNode ( XMP_Node * xmpParent, const XML_Node & xmlNode, const XMP_StringP
 		xmpParent = schemaNode;
 		
 		// If this is an alias set the isAlias flag in the node and the hasAliases flag in the tree.
+		XMP_AutoReadLock registryLock ( sRegistryLock );
 		if ( sRegisteredAliasMap->find ( xmlNode.name ) != sRegisteredAliasMap->end() ) {
 			childOptions |= kXMP_PropIsAlias;
 			schemaNode->parent->options |= kXMP_PropHasAliases;
@@ -125,21 +125,16 @@ WXMPMeta_DecrementRefCount_1 ( XMPMetaRef xmpRef )
 // These are DLL-entry wrappers for class-static functions. They all follow a simple pattern:
 //
 //		try
-//			acquire toolbox lock
 //			validate parameters
 //			call through to the implementation
-//			retain toolbox lock if necessary
 //		catch anything and return an appropriate XMP_Error object
 //		return null (no error if we get to here)
 //
-// The toolbox lock is acquired through a local wrapper object that automatically unlocks when the
-// try-block is exited. The lock must be retained if the function is returning a string result. The
-// output string is owned by the toolkit, the client must copy the string then release the lock.
-// The lock used here is the overall toolkit lock. For simplicity at this time the lock is a simple
-// mutual exclusion lock, we do not allow multiple concurrent readers.
-//
-// The one exception to this model is UnlockToolkit. It does not acquire the toolkit lock since this
-// is the function the client calls to release the lock after copying an output string!
+// There is no longer an overall toolkit lock. The namespace and alias registry has a reader-writer
+// lock of its own, which the implementation takes around each use of the registry (see
+// sRegistryLock). An output string is owned by the toolkit and kept in a per-thread buffer, the
+// client must copy the string before its next call. The client glue still calls UnlockToolkit
+// after copying the string, it does nothing.
 //
 // =================================================================================================
 
@@ -378,20 +373,14 @@ WXMPMeta_RegisterStandardAliases_1 ( XMP_StringPtr schemaNS,
 //
 //		validate parameters
 //		try
-//			acquire object lock
 //			call through to the implementation
-//			retain object lock if necessary
 //		catch anything and return an appropriate XMP_Error object
 //		return null (no error if we get to here)
 //
-// The object lock is acquired through a local wrapper object that automatically unlocks when the
-// try-block is exited. The lock must be retained if the function is returning a string result. The
-// output string is owned by the object, the client must copy the string then release the lock. The
-// lock used here is the per-object lock. For simplicity at this time the lock is a simple mutual
-// exclusion lock, we do not allow multiple concurrent readers.
-//
-// The one exception to this model is UnlockObject. It does not acquire the object lock since this
-// is the function the client calls to release the lock after copying an output string!
+// No lock is acquired, an object must not be used by several threads at the same time. Different
+// objects can be used concurrently. The output string is owned by the object, the client must copy
+// the string before it changes the object. The client glue still calls UnlockObject after copying
+// the string, it does nothing.
 //
 // =================================================================================================
 
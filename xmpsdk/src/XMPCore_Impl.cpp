@@ -55,82 +55,30 @@ XMP_StringMap *	sNamespacePrefixToURIMap = 0;
 
 XMP_AliasMap *	sRegisteredAliasMap = 0;	// Needed by XMPIterator.
 
-XMP_VarString *	sOutputNS  = 0;
-XMP_VarString *	sOutputStr = 0;
-XMP_VarString * sExceptionMessage = 0;
+// ! The output strings are per thread, a string returned by a wrapper stays valid until the same
+// ! thread makes the next call into the toolkit.
+static thread_local XMP_VarString sOutputNSStorage, sOutputStrStorage, sExceptionMessageStorage;
+thread_local XMP_VarString *	sOutputNS  = &sOutputNSStorage;
+thread_local XMP_VarString *	sOutputStr = &sOutputStrStorage;
+thread_local XMP_VarString * sExceptionMessage = &sExceptionMessageStorage;
 
-XMP_Mutex sXMPCoreLock;
-int sLockCount = 0;
+XMP_RWLock sRegistryLock;
 
 #if TraceXMPCalls
 	FILE * xmpOut = stderr;
 #endif
 
-void *              voidVoidPtr    = 0;	// Used to backfill null output parameters.
-XMP_StringPtr		voidStringPtr  = 0;
-XMP_StringLen		voidStringLen  = 0;
-XMP_OptionBits		voidOptionBits = 0;
-XMP_Uns8			voidByte       = 0;
-bool				voidBool       = 0;
-XMP_Int32			voidInt32      = 0;
-XMP_Int64			voidInt64      = 0;
-double				voidDouble     = 0.0;
-XMP_DateTime		voidDateTime;
-WXMP_Result 		void_wResult;
-
-// =================================================================================================
-// Mutex Utilities
-// ===============
-
-// ! Note that the mutex need not be "recursive", allowing the same thread to acquire it multiple
-// ! times. There is a single XMP lock which is acquired in the wrapper classes. Internal calls
-// ! never go back out to the wrappers.
-
-#if XMP_WinBuild
-
-	bool XMP_InitMutex ( XMP_Mutex * mutex ) {
-		InitializeCriticalSection ( mutex );
-		return true;
-	}
-	
-	void XMP_TermMutex ( XMP_Mutex & mutex ) {
-		DeleteCriticalSection ( &mutex );
-	}
-
-	void XMP_EnterCriticalRegion ( XMP_Mutex & mutex ) {
-		EnterCriticalSection ( &mutex );
-	}
-	
-	void XMP_ExitCriticalRegion ( XMP_Mutex & mutex ) {
-		LeaveCriticalSection ( &mutex );
-	}
-
-#else
-
-	// Use pthread for both Mac and generic UNIX.
-	// ! Would be nice to specify PTHREAD_MUTEX_ERRORCHECK, but the POSIX documentation is useless.
-	// ! Would be OK but overkill to specify PTHREAD_MUTEX_RECURSIVE.
-
-	bool XMP_InitMutex ( XMP_Mutex * mutex ) {
-		int err = pthread_mutex_init ( mutex, 0 );
-		return (err == 0 );
-	}
-	
-	void XMP_TermMutex ( XMP_Mutex & mutex ) {
-		(void) pthread_mutex_destroy ( &mutex );
-	}
-
-	void XMP_EnterCriticalRegion ( XMP_Mutex & mutex ) {
-		int err = pthread_mutex_lock ( &mutex );
-		if ( err != 0 ) XMP_Throw ( "XMP_EnterCriticalRegion - pthread_mutex_lock failure", kXMPErr_ExternalFailure );
-	}
-	
-	void XMP_ExitCriticalRegion ( XMP_Mutex & mutex ) {
-		int err = pthread_mutex_unlock ( &mutex );
-		if ( err != 0 ) XMP_Throw ( "XMP_ExitCriticalRegion - pthread_mutex_unlock failure", kXMPErr_ExternalFailure );
-	}
-
-#endif
+thread_local void *              voidVoidPtr    = 0;	// Used to backfill null output parameters, per thread.
+thread_local XMP_StringPtr		voidStringPtr  = 0;
+thread_local XMP_StringLen		voidStringLen  = 0;
+thread_local XMP_OptionBits		voidOptionBits = 0;
+thread_local XMP_Uns8			voidByte       = 0;
+thread_local bool				voidBool       = 0;
+thread_local XMP_Int32			voidInt32      = 0;
+thread_local XMP_Int64			voidInt64      = 0;
+thread_local double				voidDouble     = 0.0;
+thread_local XMP_DateTime		voidDateTime;
+thread_local WXMP_Result 		void_wResult;
 
 // =================================================================================================
 // Local Utilities
@@ -168,6 +116,7 @@ VerifyXPathRoot	( XMP_StringPtr			schemaURI,
 		}
 	}
 
+	XMP_AutoReadLock registryLock ( sRegistryLock );
 	XMP_StringMapPos uriPos = sNamespaceURIToPrefixMap->find ( XMP_VarString ( schemaURI ) );
 	if ( uriPos == sNamespaceURIToPrefixMap->end() ) {
 		XMP_Throw ( "Unregistered schema namespace URI", kXMPErr_BadSchema );
@@ -228,6 +177,7 @@ VerifyQualName ( XMP_StringPtr qualName, XMP_StringPtr nameEnd )
 
 	size_t prefixLen = colonPos - qualName + 1;	// ! Include the colon.
 	XMP_VarString prefix ( qualName, prefixLen );
+	XMP_AutoReadLock registryLock ( sRegistryLock );
 	XMP_StringMapPos prefixPos = sNamespacePrefixToURIMap->find ( prefix );
 	if ( prefixPos == sNamespacePrefixToURIMap->end() ) {
 		XMP_Throw ( "Unknown namespace prefix for qualified name", kXMPErr_BadXPath );
@@ -688,8 +638,11 @@ ExpandXPath	( XMP_StringPtr			schemaNS,
 	VerifyXPathRoot ( schemaNS, currStep.c_str(), expandedXPath );
 
 	XMP_OptionBits stepFlags = kXMP_StructFieldStep;	
-	if ( sRegisteredAliasMap->find ( (*expandedXPath)[kRootPropStep].step ) != sRegisteredAliasMap->end() ) {
-		stepFlags |= kXMP_StepIsAlias;
+	{
+		XMP_AutoReadLock registryLock ( sRegistryLock );
+		if ( sRegisteredAliasMap->find ( (*expandedXPath)[kRootPropStep].step ) != sRegisteredAliasMap->end() ) {
+			stepFlags |= kXMP_StepIsAlias;
+		}
 	}
 	(*expandedXPath)[kRootPropStep].options |= stepFlags;
 		
@@ -1093,10 +1046,15 @@ FindNode ( XMP_Node *		xmpTree,
 
 		stepNum = 2;	// ! Continue processing the original path at the second level step.
 
-		XMP_AliasMapPos aliasPos = sRegisteredAliasMap->find ( expandedXPath[kRootPropStep].step );
-		XMP_Assert ( aliasPos != sRegisteredAliasMap->end() );
+		XMP_ExpandedXPath actualPath;	// ! Copied, FindSchemaNode looks at the registry too.
+		{
+			XMP_AutoReadLock registryLock ( sRegistryLock );
+			XMP_AliasMapPos aliasPos = sRegisteredAliasMap->find ( expandedXPath[kRootPropStep].step );
+			XMP_Assert ( aliasPos != sRegisteredAliasMap->end() );
+			actualPath = aliasPos->second;
+		}
 		
-		currNode = FindSchemaNode ( xmpTree, aliasPos->second[kSchemaStep].step.c_str(), createNodes, &currPos );
+		currNode = FindSchemaNode ( xmpTree, actualPath[kSchemaStep].step.c_str(), createNodes, &currPos );
 		if ( currNode == 0 ) goto EXIT;
 		if ( currNode->options & kXMP_NewImplicitNode ) {
 			currNode->options ^= kXMP_NewImplicitNode;	// Clear the implicit node bit.
@@ -1104,7 +1062,7 @@ FindNode ( XMP_Node *		xmpTree,
 			leafIsNew = true;	// If any parent is new, the leaf will be new also.
 		}
 
-		currNode = FollowXPathStep ( currNode, aliasPos->second, 1, createNodes, &currPos );
+		currNode = FollowXPathStep ( currNode, actualPath, 1, createNodes, &currPos );
 		if ( currNode == 0 ) goto EXIT;
 		if ( currNode->options & kXMP_NewImplicitNode ) {
 			currNode->options ^= kXMP_NewImplicitNode;	// Clear the implicit node bit.
@@ -1113,12 +1071,12 @@ FindNode ( XMP_Node *		xmpTree,
 			leafIsNew = true;	// If any parent is new, the leaf will be new also.
 		}
 		
-		XMP_OptionBits arrayForm = aliasPos->second[kRootPropStep].options & kXMP_PropArrayFormMask;
+		XMP_OptionBits arrayForm = actualPath[kRootPropStep].options & kXMP_PropArrayFormMask;
 		XMP_Assert ( (arrayForm == 0) || (arrayForm & kXMP_PropValueIsArray) );
-		XMP_Assert ( (arrayForm == 0) ? (aliasPos->second.size() == 2) : (aliasPos->second.size() == 3) );
+		XMP_Assert ( (arrayForm == 0) ? (actualPath.size() == 2) : (actualPath.size() == 3) );
 		
 		if ( arrayForm != 0 ) { 
-			currNode = FollowXPathStep ( currNode, aliasPos->second, 2, createNodes, &currPos, true );
+			currNode = FollowXPathStep ( currNode, actualPath, 2, createNodes, &currPos, true );
 			if ( currNode == 0 ) goto EXIT;
 			if ( currNode->options & kXMP_NewImplicitNode ) {
 				currNode->options ^= kXMP_NewImplicitNode;	// Clear the implicit node bit.
@@ -18,15 +18,14 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <mutex>
+#include <shared_mutex>
 
 #include <cassert>
 #include <cstring>
 
 #if XMP_WinBuild
 	#include <windows.h>
-#else
-	// Use pthread for both Mac and generic UNIX.
-	#include <pthread.h>
 #endif
 
 #if XMP_WinBuild
@@ -76,20 +75,20 @@ extern XMP_AliasMap *	sRegisteredAliasMap;
 extern XMP_StringMap *	sNamespaceURIToPrefixMap;
 extern XMP_StringMap *	sNamespacePrefixToURIMap;
 
-extern XMP_VarString *	sOutputNS;
-extern XMP_VarString *	sOutputStr;
-
-extern void *			voidVoidPtr;	// Used to backfill null output parameters.
-extern XMP_StringPtr	voidStringPtr;
-extern XMP_StringLen	voidStringLen;
-extern XMP_OptionBits	voidOptionBits;
-extern XMP_Bool			voidByte;
-extern bool				voidBool;
-extern XMP_Int32		voidInt32;
-extern XMP_Int64		voidInt64;
-extern double			voidDouble;
-extern XMP_DateTime		voidDateTime;
-extern WXMP_Result		void_wResult;
+extern thread_local XMP_VarString *	sOutputNS;
+extern thread_local XMP_VarString *	sOutputStr;
+
+extern thread_local void *			voidVoidPtr;	// Used to backfill null output parameters.
+extern thread_local XMP_StringPtr	voidStringPtr;
+extern thread_local XMP_StringLen	voidStringLen;
+extern thread_local XMP_OptionBits	voidOptionBits;
+extern thread_local XMP_Bool			voidByte;
+extern thread_local bool				voidBool;
+extern thread_local XMP_Int32		voidInt32;
+extern thread_local XMP_Int64		voidInt64;
+extern thread_local double			voidDouble;
+extern thread_local XMP_DateTime		voidDateTime;
+extern thread_local WXMP_Result		void_wResult;
 
 #define kHexDigits "0123456789ABCDEF"
 
@@ -165,10 +164,6 @@ extern WXMP_Result		void_wResult;
 	#define AnnounceNoLock(proc)	/* Do nothing. */
 	#define AnnounceExit()			/* Do nothing. */
 
-	#define ReportLock()			++sLockCount
-	#define ReportUnlock()			--sLockCount
-	#define ReportKeepLock()		/* Do nothing. */
-
 #else
 
 	extern FILE * xmpCoreOut;
@@ -187,62 +182,37 @@ extern WXMP_Result		void_wResult;
 	#define AnnounceExit()	\
 		fprintf ( xmpCoreOut, "Exiting %s\n", procName ); fflush ( xmpOut )
 
-	#define ReportLock()	\
-		++sLockCount; fprintf ( xmpCoreOut, "  Auto lock, count = %d\n", sLockCount ); fflush ( xmpOut )
-	#define ReportUnlock()	\
-		--sLockCount; fprintf ( xmpCoreOut, "  Auto unlock, count = %d\n", sLockCount ); fflush ( xmpOut )
-	#define ReportKeepLock()	\
-		fprintf ( xmpCoreOut, "  Keeping lock, count = %d\n", sLockCount ); fflush ( xmpOut )
-
 #endif
 
 #define XMP_Throw(msg,id)	{ AnnounceThrow ( msg ); throw XMP_Error ( id, msg ); }
 
 // -------------------------------------------------------------------------------------------------
 
-#if XMP_WinBuild
-	typedef CRITICAL_SECTION XMP_Mutex;
-#else
-	// Use pthread for both Mac and generic UNIX.
-	typedef pthread_mutex_t XMP_Mutex;
-#endif
-
-extern XMP_Mutex sXMPCoreLock;
-extern int	sLockCount;	// Keep signed to catch unlock errors.
-extern XMP_VarString * sExceptionMessage;
+// ! There is no toolkit lock. The namespace and alias maps are the only state shared by XMP
+// ! objects, they are guarded by sRegistryLock: shared for lookups, exclusive for changes. Don't
+// ! call out of the toolkit or take the lock again while holding it. Strings returned by the
+// ! wrappers are kept per object or in per-thread buffers. An XMP object must not be used by
+// ! several threads at the same time.
 
-extern bool XMP_InitMutex ( XMP_Mutex * mutex );
-extern void XMP_TermMutex ( XMP_Mutex & mutex );
+typedef std::shared_mutex XMP_RWLock;
+typedef std::shared_lock < XMP_RWLock > XMP_AutoReadLock;
+typedef std::unique_lock < XMP_RWLock > XMP_AutoWriteLock;
 
-extern void XMP_EnterCriticalRegion ( XMP_Mutex & mutex );
-extern void XMP_ExitCriticalRegion ( XMP_Mutex & mutex );
-
-class XMP_AutoMutex {
-public:
-	XMP_AutoMutex() : mutex(&sXMPCoreLock) { XMP_EnterCriticalRegion ( *mutex ); ReportLock(); };
-	~XMP_AutoMutex() { if ( mutex != 0 ) { ReportUnlock(); XMP_ExitCriticalRegion ( *mutex ); mutex = 0; } };
-	void KeepLock() { ReportKeepLock(); mutex = 0; };
-private:
-	XMP_Mutex * mutex;
-};
-
-// *** Switch to XMPEnterObjectWrapper & XMPEnterStaticWrapper, to allow for per-object locks.
+extern XMP_RWLock sRegistryLock;
+extern thread_local XMP_VarString * sExceptionMessage;
 
 // ! Don't do the initialization check (sXMP_InitCount > 0) for the no-lock case. That macro is used
 // ! by WXMPMeta_Initialize_1.
 
 #define XMP_ENTER_WRAPPER_NO_LOCK(proc)						\
 	AnnounceNoLock ( proc );								\
-	XMP_Assert ( (0 <= sLockCount) && (sLockCount <= 1) );	\
 	try {													\
 		wResult->errMessage = 0;
 
 #define XMP_ENTER_WRAPPER(proc)								\
 	AnnounceEntry ( proc );									\
 	XMP_Assert ( sXMP_InitCount > 0 );	                    \
-	XMP_Assert ( (0 <= sLockCount) && (sLockCount <= 1) );	\
 	try {													\
-		XMP_AutoMutex mutex;								\
 		wResult->errMessage = 0;
 
 #define XMP_EXIT_WRAPPER	\
@@ -250,9 +220,7 @@ private:
 	AnnounceExit();
 
 #define XMP_EXIT_WRAPPER_KEEP_LOCK(keep)	\
-		if ( keep ) mutex.KeepLock();		\
-	XMP_CATCH_EXCEPTIONS					\
-	AnnounceExit();
+	XMP_EXIT_WRAPPER	/* ! Nothing to keep, see sRegistryLock. */
 
 #define XMP_EXIT_WRAPPER_NO_THROW				\
 	} catch ( ... )	{							\
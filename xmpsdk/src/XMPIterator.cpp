@@ -86,18 +86,26 @@ AddSchemaAliases ( IterInfo & info, IterNode & iterSchema, XMP_StringPtr schemaU
 	bool found = XMPMeta::GetNamespacePrefix ( schemaURI, &nsPrefix, &nsLen );
 	if ( ! found ) XMP_Throw ( "Unknown iteration namespace", kXMPErr_BadSchema );
 	
-	XMP_AliasMapPos currAlias = sRegisteredAliasMap->begin();
-	XMP_AliasMapPos endAlias  = sRegisteredAliasMap->end();
+	XMP_AliasMap nsAliases;	// ! Copied, FindConstNode looks at the registry too.
+	{
+		XMP_AutoReadLock registryLock ( sRegistryLock );
+		XMP_cAliasMapPos currAlias = sRegisteredAliasMap->begin();
+		XMP_cAliasMapPos endAlias  = sRegisteredAliasMap->end();
+		for ( ; currAlias != endAlias; ++currAlias ) {
+			if ( XMP_LitNMatch ( currAlias->first.c_str(), nsPrefix, nsLen ) ) nsAliases.insert ( *currAlias );
+		}
+	}
+	
+	XMP_AliasMapPos currAlias = nsAliases.begin();
+	XMP_AliasMapPos endAlias  = nsAliases.end();
 	
 	for ( ; currAlias != endAlias; ++currAlias ) {
-		if ( XMP_LitNMatch ( currAlias->first.c_str(), nsPrefix, nsLen ) ) {
-			const XMP_Node * actualProp = FindConstNode ( &info.xmpObj->tree, currAlias->second );
-			if ( actualProp != 0 ) {
-				iterSchema.children.push_back ( IterNode ( (actualProp->options | kXMP_PropIsAlias), currAlias->first, 0 ) );
-				#if TraceIterators
-					printf ( "        %s  =>  %s\n", currAlias->first.c_str(), actualProp->name.c_str() );
-				#endif
-			}
+		const XMP_Node * actualProp = FindConstNode ( &info.xmpObj->tree, currAlias->second );
+		if ( actualProp != 0 ) {
+			iterSchema.children.push_back ( IterNode ( (actualProp->options | kXMP_PropIsAlias), currAlias->first, 0 ) );
+			#if TraceIterators
+				printf ( "        %s  =>  %s\n", currAlias->first.c_str(), actualProp->name.c_str() );
+			#endif
 		}
 	}
 
@@ -529,10 +537,15 @@ XMPIterator::XMPIterator ( const XMPMeta & xmpObj,
 			// ! here to determine if the namespace has any aliases to existing properties. We then
 			// ! strip the children if necessary.
 
-			XMP_cStringMapPos currNS = sNamespaceURIToPrefixMap->begin();
-			XMP_cStringMapPos endNS  = sNamespaceURIToPrefixMap->end();
-			for ( ; currNS != endNS; ++currNS ) {
-				XMP_StringPtr schemaName = currNS->first.c_str();
+			std::vector < XMP_VarString > nsURIs;	// ! Copied, AddSchemaAliases looks at the registry too.
+			{
+				XMP_AutoReadLock registryLock ( sRegistryLock );
+				XMP_cStringMapPos currNS = sNamespaceURIToPrefixMap->begin();
+				XMP_cStringMapPos endNS  = sNamespaceURIToPrefixMap->end();
+				for ( ; currNS != endNS; ++currNS ) nsURIs.push_back ( currNS->first );
+			}
+			for ( size_t nsNum = 0, nsLim = nsURIs.size(); nsNum < nsLim; ++nsNum ) {
+				XMP_StringPtr schemaName = nsURIs[nsNum].c_str();
 				if ( FindConstSchema ( &xmpObj.tree, schemaName ) != 0 ) continue;
 				info.tree.children.push_back ( IterNode ( kXMP_SchemaNode, schemaName, 0 ) );
 				IterNode & iterSchema = info.tree.children.back();
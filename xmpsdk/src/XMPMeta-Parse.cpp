@@ -401,9 +401,13 @@ MoveExplicitAliases ( XMP_Node * tree, XMP_OptionBits parseOptions )
 
 			// Find the base path, look for the base schema and root node.
 
-			XMP_AliasMapPos aliasPos = sRegisteredAliasMap->find ( currProp->name );
-			XMP_Assert ( aliasPos != sRegisteredAliasMap->end() );
-			XMP_ExpandedXPath & basePath = aliasPos->second;
+			XMP_ExpandedXPath basePath;	// ! Copied, FindSchemaNode looks at the registry too.
+			{
+				XMP_AutoReadLock registryLock ( sRegistryLock );
+				XMP_AliasMapPos aliasPos = sRegisteredAliasMap->find ( currProp->name );
+				XMP_Assert ( aliasPos != sRegisteredAliasMap->end() );
+				basePath = aliasPos->second;
+			}
 			XMP_OptionBits arrayOptions = (basePath[kRootPropStep].options & kXMP_PropArrayFormMask);
 
 			XMP_Node * baseSchema = FindSchemaNode ( tree, basePath[kSchemaStep].step.c_str(), kXMP_CreateNodes );
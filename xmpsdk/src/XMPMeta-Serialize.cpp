@@ -167,6 +167,7 @@ DeclareElemNamespace ( const XMP_VarString & elemName,
 
 	if ( colonPos != XMP_VarString::npos ) {
 		XMP_VarString nsPrefix ( elemName.substr ( 0, colonPos+1 ) );
+		XMP_AutoReadLock registryLock ( sRegistryLock );
 		XMP_StringMapPos prefixPos = sNamespacePrefixToURIMap->find ( nsPrefix );
 		XMP_Enforce ( prefixPos != sNamespacePrefixToURIMap->end() );
 		DeclareOneNamespace ( nsPrefix, prefixPos->second, usedNS, outputStr, newline, indentStr, indent );
@@ -608,9 +609,12 @@ SerializePrettyRDFSchema ( const XMP_VarString & treeName,
 	outputStr += '"';
 
 	size_t totalLen = 8;	// Start at 8 for "xml:rdf:".
-	XMP_cStringMapPos currPos = sNamespacePrefixToURIMap->begin();
-	XMP_cStringMapPos endPos  = sNamespacePrefixToURIMap->end();
-	for ( ; currPos != endPos; ++currPos ) totalLen += currPos->first.size();
+	{
+		XMP_AutoReadLock registryLock ( sRegistryLock );
+		XMP_cStringMapPos currPos = sNamespacePrefixToURIMap->begin();
+		XMP_cStringMapPos endPos  = sNamespacePrefixToURIMap->end();
+		for ( ; currPos != endPos; ++currPos ) totalLen += currPos->first.size();
+	}
 
 	XMP_VarString usedNS;
 	usedNS.reserve ( totalLen );
@@ -984,9 +988,12 @@ SerializeCompactRDFSchemas ( const XMP_Node & xmpTree,
 	// Write all necessary xmlns attributes.
 	
 	size_t totalLen = 8;	// Start at 8 for "xml:rdf:".
-	XMP_cStringMapPos currPos = sNamespacePrefixToURIMap->begin();
-	XMP_cStringMapPos endPos  = sNamespacePrefixToURIMap->end();
-	for ( ; currPos != endPos; ++currPos ) totalLen += currPos->first.size();
+	{
+		XMP_AutoReadLock registryLock ( sRegistryLock );
+		XMP_cStringMapPos currPos = sNamespacePrefixToURIMap->begin();
+		XMP_cStringMapPos endPos  = sNamespacePrefixToURIMap->end();
+		for ( ; currPos != endPos; ++currPos ) totalLen += currPos->first.size();
+	}
 
 	XMP_VarString usedNS;
 	usedNS.reserve ( totalLen );
@@ -55,6 +55,11 @@ using namespace std;
 
 XMP_VarString * xdefaultName = 0;
 
+// ! GetNamespacePrefix and GetNamespaceURI return copies, the registry can change once the lock is
+// ! released. Separate buffers, a prefix is looked up for the URI returned by GetNamespaceURI.
+static thread_local XMP_VarString sOutputPrefix;
+static thread_local XMP_VarString sOutputURI;
+
 // These are embedded version strings.
 
 const char * kXMPCore_EmbeddedVersion   = kXMPCore_VersionMessage;
@@ -652,11 +657,6 @@ XMPMeta::Initialize()
 		fprintf ( xmpOut, "XMP initializing\n" ); fflush ( xmpOut );
 	#endif
 	
-	sExceptionMessage = new XMP_VarString();
-	XMP_InitMutex ( &sXMPCoreLock );
-    sOutputNS  = new XMP_VarString;
-    sOutputStr = new XMP_VarString;
-
 	xdefaultName = new XMP_VarString ( "x-default" );
 	
 	sNamespaceURIToPrefixMap	= new XMP_StringMap;
@@ -826,11 +826,6 @@ XMPMeta::Terminate() RELEASE_NO_THROW
 	EliminateGlobal ( sRegisteredAliasMap );
     
     EliminateGlobal ( xdefaultName );
-    EliminateGlobal ( sOutputNS );
-    EliminateGlobal ( sOutputStr );
-	EliminateGlobal ( sExceptionMessage );
-
-	XMP_TermMutex ( sXMPCoreLock );
 	
 }	// Terminate
 
@@ -844,12 +839,7 @@ XMPMeta::Unlock ( XMP_OptionBits options )
 {
 	UNUSED(options);
 
-    #if TraceXMPLocking
-    	fprintf ( xmpOut, "  Unlocking XMP toolkit, count = %d\n", sLockCount ); fflush ( xmpOut );
-	#endif
-    --sLockCount;
-    XMP_Assert ( sLockCount == 0 );
-	XMP_ExitCriticalRegion ( sXMPCoreLock );
+	// ! Nothing to do, the wrappers don't keep a lock. See sRegistryLock.
 
 }	// Unlock
 
@@ -883,6 +873,8 @@ XMPMeta::DumpNamespaces ( XMP_TextOutputProc outProc,
 	XMP_Assert ( outProc != 0 );	// ! Enforced by wrapper.
 	XMP_Status status = 0;
 	
+	XMP_AutoReadLock registryLock ( sRegistryLock );	// ! The output procedure must not call the toolkit.
+
 	XMP_StringMapPos p2uEnd = sNamespacePrefixToURIMap->end();	// ! Move up to avoid gcc complaints.
 	XMP_StringMapPos u2pEnd = sNamespaceURIToPrefixMap->end();
 	
@@ -959,6 +951,8 @@ XMPMeta::DumpAliases ( XMP_TextOutputProc outProc,
 
 	XMP_Assert ( sRegisteredAliasMap != 0 );
 
+	XMP_AutoReadLock registryLock ( sRegistryLock );	// ! The output procedure must not call the toolkit.
+
 	XMP_cAliasMapPos aliasPos;
 	XMP_cAliasMapPos aliasEnd = sRegisteredAliasMap->end();
 	
@@ -1048,7 +1042,17 @@ XMPMeta::RegisterNamespace ( XMP_StringPtr	 namespaceURI,
 	if ( prfix[prfix.size()-1] != ':' ) prfix += ':';
 	VerifySimpleXMLName ( prefix, prefix+prfix.size()-1 );	// Exclude the colon.
 	
+	{
+		// Parsing registers the namespaces of every packet, mostly they are known already.
+		XMP_AutoReadLock registryLock ( sRegistryLock );
+		XMP_cStringMapPos uriPos = sNamespaceURIToPrefixMap->find ( nsURI );
+		XMP_cStringMapPos prefixPos = sNamespacePrefixToURIMap->find ( prfix );
+		if ( (uriPos != sNamespaceURIToPrefixMap->end()) && (uriPos->second == prfix) &&
+			 (prefixPos != sNamespacePrefixToURIMap->end()) && (prefixPos->second == nsURI) ) return;
+	}
+
         // Set the new namespace in both maps.
+        XMP_AutoWriteLock registryLock ( sRegistryLock );
         (*sNamespaceURIToPrefixMap)[nsURI] = prfix;
         (*sNamespacePrefixToURIMap)[prfix] = nsURI;
 	
@@ -1070,11 +1074,13 @@ XMPMeta::GetNamespacePrefix	( XMP_StringPtr   namespaceURI,
 	XMP_Assert ( (namespacePrefix != 0) && (prefixSize != 0) );	// ! Enforced by wrapper.
 
 	XMP_VarString    nsURI ( namespaceURI );
+	XMP_AutoReadLock registryLock ( sRegistryLock );
 	XMP_StringMapPos uriPos	= sNamespaceURIToPrefixMap->find ( nsURI );
 	
 	if ( uriPos != sNamespaceURIToPrefixMap->end() ) {
-		*namespacePrefix = uriPos->second.c_str();
-		*prefixSize = uriPos->second.size();
+		sOutputPrefix = uriPos->second;
+		*namespacePrefix = sOutputPrefix.c_str();
+		*prefixSize = sOutputPrefix.size();
 		found = true;
 	}
 	
@@ -1100,11 +1106,13 @@ XMPMeta::GetNamespaceURI ( XMP_StringPtr   namespacePrefix,
 	XMP_VarString nsPrefix ( namespacePrefix );
 	if ( nsPrefix[nsPrefix.size()-1] != ':' ) nsPrefix += ':';
 	
+	XMP_AutoReadLock registryLock ( sRegistryLock );
 	XMP_StringMapPos prefixPos = sNamespacePrefixToURIMap->find ( nsPrefix );
 	
 	if ( prefixPos != sNamespacePrefixToURIMap->end() ) {
-		*namespaceURI = prefixPos->second.c_str();
-		*uriSize = prefixPos->second.size();
+		sOutputURI = prefixPos->second;
+		*namespaceURI = sOutputURI.c_str();
+		*uriSize = sOutputURI.size();
 		found = true;
 	}
 	
@@ -1124,6 +1132,7 @@ XMPMeta::GetNamespaceURI ( XMP_StringPtr   namespacePrefix,
 /* class-static */ void
 XMPMeta::DeleteNamespace ( XMP_StringPtr namespaceURI )
 {
+	XMP_AutoWriteLock registryLock ( sRegistryLock );
 	XMP_StringMapPos uriPos = sNamespaceURIToPrefixMap->find ( namespaceURI );
 	if ( uriPos == sNamespaceURIToPrefixMap->end() ) return;
 
@@ -1190,6 +1199,7 @@ XMPMeta::RegisterAlias ( XMP_StringPtr 	aliasNS,
 	// alias is already aliased it is only OK to reregister an identical alias. If the actual is
 	// already aliased to something else and the new chain is legal, just swap in the old base.
 
+	XMP_AutoWriteLock registryLock ( sRegistryLock );
 	mapPos = sRegisteredAliasMap->find ( expAlias[kRootPropStep].step );
 	if ( mapPos != sRegisteredAliasMap->end() ) {
 
@@ -1289,13 +1299,16 @@ XMPMeta::ResolveAlias ( XMP_StringPtr	 aliasNS,
 
 	minPath.push_back ( fullPath[kSchemaStep] );
 	minPath.push_back ( fullPath[kRootPropStep] );
-	XMP_AliasMapPos mapPos = sRegisteredAliasMap->find ( minPath[kRootPropStep].step );
-	if ( mapPos == sRegisteredAliasMap->end() ) return false;
+	XMP_ExpandedXPath actualPath;
+	{
+		XMP_AutoReadLock registryLock ( sRegistryLock );
+		XMP_AliasMapPos mapPos = sRegisteredAliasMap->find ( minPath[kRootPropStep].step );
+		if ( mapPos == sRegisteredAliasMap->end() ) return false;
+		actualPath = mapPos->second;
+	}
 	
 	// Replace the alias portion of the full expanded path. Compose the output path string.
 	
-	const XMP_ExpandedXPath & actualPath = mapPos->second;
-	
 	fullPath[kSchemaStep] = actualPath[kSchemaStep];
 	fullPath[kRootPropStep] = actualPath[kRootPropStep];
 	if ( actualPath.size() > 2 ) {	// This is an alias to an array item.
@@ -1094,22 +1094,30 @@ XMPUtils::RemoveProperties ( XMPMeta *		xmpObj,
 			XMP_StringLen nsLen;
 			(void) XMPMeta::GetNamespacePrefix ( schemaNS, &nsPrefix, &nsLen );
 			
-			XMP_AliasMapPos currAlias = sRegisteredAliasMap->begin();
-			XMP_AliasMapPos endAlias  = sRegisteredAliasMap->end();
+			XMP_AliasMap nsAliases;	// ! Copied, FindNode looks at the registry too.
+			{
+				XMP_AutoReadLock registryLock ( sRegistryLock );
+				XMP_cAliasMapPos currAlias = sRegisteredAliasMap->begin();
+				XMP_cAliasMapPos endAlias  = sRegisteredAliasMap->end();
+				for ( ; currAlias != endAlias; ++currAlias ) {
+					if ( strncmp ( currAlias->first.c_str(), nsPrefix, nsLen ) == 0 ) nsAliases.insert ( *currAlias );
+				}
+			}
+			
+			XMP_AliasMapPos currAlias = nsAliases.begin();
+			XMP_AliasMapPos endAlias  = nsAliases.end();
 			
 			for ( ; currAlias != endAlias; ++currAlias ) {
-				if ( strncmp ( currAlias->first.c_str(), nsPrefix, nsLen ) == 0 ) {
-					XMP_NodePtrPos actualPos;
-					XMP_Node * actualProp = FindNode ( &xmpObj->tree, currAlias->second, kXMP_ExistingOnly, kXMP_NoOptions, &actualPos );
-					if ( actualProp != 0 ) {
-						XMP_Node * rootProp = actualProp;
-						while ( ! XMP_NodeIsSchema ( rootProp->parent->options ) ) rootProp = rootProp->parent;
-						if ( doAll || IsExternalProperty ( rootProp->parent->name, rootProp->name ) ) {
-							XMP_Node * parent = actualProp->parent;
-							delete actualProp;	// ! Both delete the node and erase the pointer from the parent.
-							parent->children.erase ( actualPos );
-							DeleteEmptySchema ( parent );
-						}
+				XMP_NodePtrPos actualPos;
+				XMP_Node * actualProp = FindNode ( &xmpObj->tree, currAlias->second, kXMP_ExistingOnly, kXMP_NoOptions, &actualPos );
+				if ( actualProp != 0 ) {
+					XMP_Node * rootProp = actualProp;
+					while ( ! XMP_NodeIsSchema ( rootProp->parent->options ) ) rootProp = rootProp->parent;
+					if ( doAll || IsExternalProperty ( rootProp->parent->name, rootProp->name ) ) {
+						XMP_Node * parent = actualProp->parent;
+						delete actualProp;	// ! Both delete the node and erase the pointer from the parent.
+						parent->children.erase ( actualPos );
+						DeleteEmptySchema ( parent );
 					}
 				}
 			}
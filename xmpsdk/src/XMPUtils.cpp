@@ -41,13 +41,17 @@ static const char * sBase64Chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqr
 // Static Variables
 // ================
 
-XMP_VarString * sComposedPath = 0;		// *** Only really need 1 string. Shrink periodically?
-XMP_VarString * sConvertedValue = 0;
-XMP_VarString * sBase64Str = 0;
-XMP_VarString * sCatenatedItems = 0;
-XMP_VarString * sStandardXMP = 0;
-XMP_VarString * sExtendedXMP = 0;
-XMP_VarString * sExtendedDigest = 0;
+// ! The output strings are per thread, see sOutputStr.
+static thread_local XMP_VarString sComposedPathStorage, sConvertedValueStorage, sBase64StrStorage,
+	sCatenatedItemsStorage, sStandardXMPStorage, sExtendedXMPStorage, sExtendedDigestStorage;
+
+thread_local XMP_VarString * sComposedPath = &sComposedPathStorage;		// *** Only really need 1 string. Shrink periodically?
+thread_local XMP_VarString * sConvertedValue = &sConvertedValueStorage;
+thread_local XMP_VarString * sBase64Str = &sBase64StrStorage;
+thread_local XMP_VarString * sCatenatedItems = &sCatenatedItemsStorage;
+thread_local XMP_VarString * sStandardXMP = &sStandardXMPStorage;
+thread_local XMP_VarString * sExtendedXMP = &sExtendedXMPStorage;
+thread_local XMP_VarString * sExtendedDigest = &sExtendedDigestStorage;
 
 // =================================================================================================
 // Local Utilities
@@ -638,14 +642,6 @@ static size_t MoveLargestProperty ( XMPMeta & stdXMP, XMPMeta * extXMP, PropSize
 /* class static */ bool
 XMPUtils::Initialize()
 {
-	sComposedPath	= new XMP_VarString();
-	sConvertedValue = new XMP_VarString();
-	sBase64Str		= new XMP_VarString();
-	sCatenatedItems = new XMP_VarString();
-	sStandardXMP    = new XMP_VarString();
-	sExtendedXMP    = new XMP_VarString();
-	sExtendedDigest = new XMP_VarString();
-
 	#if XMP_MacBuild && __MWERKS__
 		LookupTimeProcs();
 	#endif
@@ -659,19 +655,9 @@ XMPUtils::Initialize()
 // Terminate
 // ---------
 
-#define EliminateGlobal(g) delete ( g ); g = 0
-
 /* class static */ void
 XMPUtils::Terminate() RELEASE_NO_THROW
 {
-	EliminateGlobal ( sComposedPath );
-	EliminateGlobal ( sConvertedValue );
-	EliminateGlobal ( sBase64Str );
-	EliminateGlobal ( sCatenatedItems );
-	EliminateGlobal ( sStandardXMP );
-	EliminateGlobal ( sExtendedXMP );
-	EliminateGlobal ( sExtendedDigest );
-
 	return;
 
 }	// Terminate